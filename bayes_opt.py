@@ -0,0 +1,289 @@
+#!/usr/bin/env python3
+"""
+bayes_opt.py – Gaussian-process Bayesian optimisation of the panel geometry.
+
+A grid over nx, ny, pitch, gap and shell radii explodes combinatorially;
+this driver instead proposes the next GeometryConfigs to simulate:
+
+  1. a space-filling start design (Latin hypercube) is simulated,
+  2. a GP surrogate (Matérn-5/2, ARD) is fitted to the objective with the
+     *known* Monte-Carlo variance of every point as heteroscedastic noise,
+  3. a batch of q proposals is chosen by noisy expected improvement with
+     the "kriging believer" heuristic (each pick is added as a pseudo
+     observation at its posterior mean before the next pick),
+  4. the batch is simulated in parallel, and 2–4 repeat.
+
+Objectives (maximised unless --minimize):
+  ratio – log(pI / pC)             variance (1−pI)/(n·pI) + (1−pC)/(n·pC) + 2/n,
+                                   p = (k + ½)/(n + 1) so k = 0 stays finite
+  ion   – ionisation fraction      variance p(1−p)/n
+  cap   – capture fraction         (use with --minimize)
+
+  python bayes_opt.py --exe ./build/main -n 20000 --init 10 --iters 8 -q 4 --jobs 4
+
+Every evaluation lives in <out>/<hash>/ (hash of the geometry), and main
+is called with --reuse-cache, so repeated proposals cost nothing.  The
+history is written to <out>/history.csv after every batch.
+
+Dependencies: Python 3.8+, numpy, pandas
+"""
+
+import argparse, hashlib, json, math, subprocess
+from concurrent.futures import ThreadPoolExecutor
+from pathlib import Path
+
+import numpy as np
+import pandas as pd
+
+from sweep_queue import latest_run_json, load_run
+
+
+# ───────────────────────────────── search space ─────────────────────────────
+#  (name, low, high, integer?)  – shells are parametrised by increments so
+#  that r_base < r_middle < r_outer holds for every point of the box.
+SPACE = [
+    ("nx",            1,   6,   True),
+    ("ny",            1,   6,   True),
+    ("pitch_nm",     80, 300,   False),
+    ("gap_nm",       20, 100,   False),
+    ("dr_middle_nm", 10, 100,   False),   # r_middle = r_base + dr_middle
+    ("dr_outer_nm",   5,  50,   False),   # r_outer  = r_middle + dr_outer
+]
+R_BASE_NM = 10.0
+
+
+def decode(u: np.ndarray) -> dict:
+    """Unit-cube point → parameter dict (integers rounded)."""
+    p = {}
+    for (name, lo, hi, is_int), x in zip(SPACE, u):
+        v = lo + x * (hi - lo)
+        p[name] = int(round(v)) if is_int else round(float(v), 3)
+    return p
+
+
+def encode(p: dict) -> np.ndarray:
+    return np.array([(p[n] - lo) / (hi - lo) for n, lo, hi, _ in SPACE])
+
+
+def geometry(p: dict) -> dict:
+    """Single-panel GeometryConfig dict (offset as the {x,y,z}_nm object from_json reads)."""
+    r_mid = R_BASE_NM + p["dr_middle_nm"]
+    return {
+        "cone":   {"r_tip_nm": 0.5, "r_base_nm": R_BASE_NM, "h_cone_nm": 1000},
+        "gap_nm": p["gap_nm"],
+        "r_middle_nm": r_mid,
+        "r_outer_nm":  r_mid + p["dr_outer_nm"],
+        "panels": [{
+            "nx": p["nx"], "ny": p["ny"],
+            "pitch_nm": p["pitch_nm"],
+            "x0_nm": 0.0,
+            "offset_nm": {"x_nm": 0.0, "y_nm": 0.0, "z_nm": 0.0},
+        }],
+    }
+
+
+# ───────────────────────────────── objective ────────────────────────────────
+def objective(rec: dict, metric: str):
+    """(value, MC variance) of one run.json record."""
+    n, ion, cap = rec["n_events"], rec["n_ion"], rec["n_capture"]
+    if metric == "ratio":
+        # k + ½, n + 1 on both counts: a zero tally (cap = 0 is the most
+        # promising region when maximising) stays a finite GP observation
+        pi, pc = (ion + 0.5) / (n + 1.0), (cap + 0.5) / (n + 1.0)
+        return math.log(pi / pc), (1 - pi) / (n * pi) + (1 - pc) / (n * pc) + 2 / n
+    k = ion if metric == "ion" else cap
+    p = (k + 0.5) / (n + 1.0)                 # keeps the variance > 0 at k = 0
+    return k / n, p * (1 - p) / n
+
+
+# ───────────────────────────────── GP surrogate ─────────────────────────────
+def matern52(a, b, ls):
+    d = np.sqrt(np.maximum(((a[:, None, :] - b[None, :, :]) / ls) ** 2, 0).sum(-1))
+    s = math.sqrt(5.0) * d
+    return (1.0 + s + s * s / 3.0) * np.exp(-s)
+
+
+class GP:
+    """Zero-mean GP on standardised targets with per-point noise variance."""
+
+    def __init__(self, X, y, noise, rng, n_hyper=256):
+        self.X = X
+        self.mu, self.sd = y.mean(), (y.std() or 1.0)
+        self.y = (y - self.mu) / self.sd
+        self.noise = noise / self.sd ** 2
+        self._fit_hyper(rng, n_hyper)
+
+    def _nll(self, ls, amp, jitter):
+        K = amp * matern52(self.X, self.X, ls) + np.diag(self.noise + jitter)
+        try:
+            L = np.linalg.cholesky(K)
+        except np.linalg.LinAlgError:
+            return math.inf, None
+        a = np.linalg.solve(L.T, np.linalg.solve(L, self.y))
+        return 0.5 * self.y @ a + np.log(np.diag(L)).sum(), (L, a)
+
+    def _fit_hyper(self, rng, n):
+        """Type-II ML by random search over log-uniform hyper-parameters."""
+        best = (math.inf, None, None)
+        d = self.X.shape[1]
+        for i in range(n):
+            if i == 0:
+                ls, amp, jit = np.full(d, 0.3), 1.0, 1e-4
+            else:
+                ls  = np.exp(rng.uniform(np.log(0.05), np.log(3.0), d))
+                amp = float(np.exp(rng.uniform(np.log(0.1), np.log(10.0))))
+                jit = float(np.exp(rng.uniform(np.log(1e-6), np.log(0.3))))
+            nll, fac = self._nll(ls, amp, jit)
+            if nll < best[0]:
+                best = (nll, (ls, amp, jit), fac)
+        (self.ls, self.amp, self.jitter), (self.L, self.alpha) = best[1], best[2]
+
+    def predict(self, Xs):
+        Ks = self.amp * matern52(Xs, self.X, self.ls)
+        m = Ks @ self.alpha
+        v = np.linalg.solve(self.L, Ks.T)
+        var = np.maximum(self.amp - (v * v).sum(0), 1e-12)
+        return self.mu + self.sd * m, self.sd * np.sqrt(var)
+
+    def condition(self, x, y):
+        """Kriging believer: add (x, y) as a noise-free pseudo observation."""
+        self.X = np.vstack([self.X, x])
+        self.y = np.append(self.y, (y - self.mu) / self.sd)
+        self.noise = np.append(self.noise, 0.0)
+        _, (self.L, self.alpha) = self._nll(self.ls, self.amp, self.jitter)
+
+
+def expected_improvement(m, s, best):
+    z = (m - best) / s
+    cdf = 0.5 * (1.0 + np.vectorize(math.erf)(z / math.sqrt(2.0)))
+    pdf = np.exp(-0.5 * z * z) / math.sqrt(2.0 * math.pi)
+    return s * (z * cdf + pdf)
+
+
+def propose(gp, sign, q, rng, n_cand, seen):
+    """q distinct proposals maximising noisy EI (kriging believer)."""
+    out = []
+    for _ in range(q):
+        cand = [decode(u) for u in rng.random((n_cand, len(SPACE)))]
+        cand = [c for c in cand if key(c) not in seen]
+        if not cand:
+            break
+        U = np.array([encode(c) for c in cand])
+        m, s = gp.predict(U)
+        best = (sign * gp.predict(gp.X)[0]).max()        # noisy incumbent
+        ei = expected_improvement(sign * m, s, best)
+        i = int(np.argmax(ei))
+        out.append(cand[i])
+        seen.add(key(cand[i]))
+        gp.condition(U[i], m[i])
+    return out
+
+
+# ───────────────────────────────── simulation ───────────────────────────────
+def key(p: dict) -> str:
+    return hashlib.sha1(json.dumps(p, sort_keys=True).encode()).hexdigest()[:12]
+
+
+def simulate(p: dict, exe: Path, root: Path, nev: int, extra):
+    wdir = root / key(p)
+    wdir.mkdir(parents=True, exist_ok=True)
+    cfg = wdir / "geometry.json"
+    cfg.write_text(json.dumps(geometry(p), indent=2))
+    (wdir / "params.json").write_text(json.dumps(p, indent=2))
+
+    cmd = [str(exe), f"--cfg={cfg}", f"--nevents={nev}", "--reuse-cache", *extra]
+    with open(wdir / "main.log", "ab") as log:
+        rc = subprocess.run(cmd, cwd=wdir, stdout=log, stderr=subprocess.STDOUT).returncode
+    run = latest_run_json(wdir)
+    if rc != 0 or run is None:
+        print(f"  {key(p)} failed (exit code {rc})")
+        return None
+    return load_run(run)
+
+
+def latin_hypercube(n, d, rng):
+    u = (rng.permuted(np.tile(np.arange(n), (d, 1)), axis=1).T + rng.random((n, d))) / n
+    return u
+
+
+# ───────────────────────────────── driver ───────────────────────────────────
+def main():
+    ap = argparse.ArgumentParser()
+    ap.add_argument("--exe", default="./build/main")
+    ap.add_argument("--out", default="bayes_opt")
+    ap.add_argument("-n", "--nevents", type=int, default=20000, help="events per point")
+    ap.add_argument("--init", type=int, default=10, help="start-design size")
+    ap.add_argument("--iters", type=int, default=8, help="BO batches")
+    ap.add_argument("-q", "--batch", type=int, default=4, help="proposals per batch")
+    ap.add_argument("--jobs", type=int, default=4, help="concurrent simulations")
+    ap.add_argument("--metric", choices=("ratio", "ion", "cap"), default="ratio")
+    ap.add_argument("--minimize", action="store_true")
+    ap.add_argument("--candidates", type=int, default=4000)
+    ap.add_argument("--seed", type=int, default=1)
+    ap.add_argument("--main-args", nargs=argparse.REMAINDER, default=[],
+                    help="passed through to main (e.g. --seed=42)")
+    args = ap.parse_args()
+
+    exe, root = Path(args.exe).resolve(), Path(args.out).resolve()
+    root.mkdir(parents=True, exist_ok=True)
+    rng  = np.random.default_rng(args.seed)
+    sign = -1.0 if args.minimize else 1.0
+
+    history, seen = [], set()
+
+    def evaluate(batch, it):
+        with ThreadPoolExecutor(max_workers=args.jobs) as pool:
+            recs = list(pool.map(lambda p: simulate(p, exe, root, args.nevents,
+                                                    args.main_args), batch))
+        for p, rec in zip(batch, recs):
+            seen.add(key(p))
+            val = objective(rec, args.metric) if rec else None
+            history.append({"iter": it, "key": key(p), **p,
+                            "n_events": rec and rec["n_events"],
+                            "n_ion": rec and rec["n_ion"],
+                            "n_capture": rec and rec["n_capture"],
+                            "objective": val and val[0],
+                            "variance": val and val[1]})
+        pd.DataFrame(history).to_csv(root / "history.csv", index=False)
+
+    # 1) start design
+    start = [decode(u) for u in latin_hypercube(args.init, len(SPACE), rng)]
+    start = list({key(p): p for p in start}.values())
+    print(f"── start design: {len(start)} point(s)")
+    evaluate(start, 0)
+
+    # 2) BO batches
+    for it in range(1, args.iters + 1):
+        ok = [h for h in history if h["objective"] is not None]
+        if len(ok) < 2:
+            print("  too few finite objectives for a surrogate – sampling randomly")
+            batch = [decode(u) for u in rng.random((args.batch, len(SPACE)))]
+        else:
+            X = np.array([encode(h) for h in ok])
+            y = np.array([h["objective"] for h in ok])
+            v = np.array([h["variance"] for h in ok])
+            gp = GP(X, y, v, rng)
+            batch = propose(gp, sign, args.batch, rng, args.candidates, set(seen))
+        print(f"── batch {it}: {len(batch)} proposal(s)")
+        evaluate(batch, it)
+
+    # 3) report: best by posterior mean (robust to lucky MC draws)
+    ok = [h for h in history if h["objective"] is not None]
+    if not ok:
+        print("No finite objective values – nothing to report.")
+        return
+    X = np.array([encode(h) for h in ok])
+    gp = GP(X, np.array([h["objective"] for h in ok]),
+            np.array([h["variance"] for h in ok]), rng)
+    m, s = gp.predict(X)
+    i = int(np.argmax(sign * m))
+    best = ok[i]
+    print(f"\nBest of {len(history)} simulation(s) ({args.metric}, posterior mean "
+          f"{m[i]:.4g} ± {s[i]:.2g}):")
+    print(json.dumps({n: best[n] for n, *_ in SPACE}, indent=2))
+    print("Geometry:", root / best["key"] / "geometry.json")
+    print("★ Wrote", root / "history.csv")
+
+
+if __name__ == "__main__":
+    main()
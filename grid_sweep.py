@@ -5,6 +5,14 @@ grid_sweep.py – brute-force every 1 ≤ nx,ny ≤ 5 (25 jobs total).
   python grid_sweep.py -n 25000 \
       --exe ./build/muAlphaSim \
       --pitch 150          # nm
+
+  # rerun after unrelated changes: keep earlier results and let main reuse
+  # (or top up) every point whose geometry/beam/rate table/seed is unchanged
+  python grid_sweep.py -n 50000 --reuse-cache
+
+  # distributed: points go through a shared-directory queue (sweep_queue.py);
+  # start extra `sweep_queue.py worker --queue …` processes on other nodes.
+  python grid_sweep.py -n 25000 --queue grid_sweep/.queue
 """
 
 import argparse, json, subprocess, shutil, os, time
@@ -14,7 +22,7 @@ import pandas as pd
 
 # ───────────────────────────────── helpers ──────────────────────────────────
 def geom_cfg(nx:int, ny:int, pitch_nm:float) -> dict:
-    """Return a single-panel GeometryConfig dict."""
+    """Return a single-panel GeometryConfig dict (offset as the {x,y,z}_nm object from_json reads)."""
     return {
         "cone":   {"r_tip_nm":0.5, "r_base_nm":10, "h_cone_nm":1000},
         "gap_nm": 50,
@@ -24,55 +32,85 @@ def geom_cfg(nx:int, ny:int, pitch_nm:float) -> dict:
             "nx": nx, "ny": ny,
             "pitch_nm": pitch_nm,
             "x0_nm": 0.0,
-            "offset_nm": [0,0,0]
+            "offset_nm": {"x_nm": 0.0, "y_nm": 0.0, "z_nm": 0.0}
         }]
     }
 
 
-def run_one(nx:int, ny:int, nev:int, exe:Path, out_root:Path) -> Path:
+def run_one(nx:int, ny:int, nev:int, exe:Path, out_root:Path, pitch:float,
+            extra_args=()):
     wdir = out_root / f"nx{nx}_ny{ny}"
     wdir.mkdir(parents=True, exist_ok=True)
 
     cfg_path = wdir / "geometry.json"
-    cfg = geom_cfg(nx, ny, args.pitch)
+    cfg = geom_cfg(nx, ny, pitch)
     cfg_path.write_text(json.dumps(cfg, indent=2))
 
-    cmd = [str(exe), f"--cfg={cfg_path}", f"--nevents={nev}"]
+    cmd = [str(exe), f"--cfg={cfg_path}", f"--nevents={nev}", *extra_args]
     print(" ".join(cmd))
-    subprocess.run(cmd, cwd=wdir, check=True)
-
-    res_dir = wdir / "results"
-    return max(res_dir.glob("run_*.json"), key=os.path.getmtime)
-
-
-# ───────────────────────────────── CLI ───────────────────────────────────────
-ap = argparse.ArgumentParser()
-ap.add_argument("-n", "--nevents", type=int, default=25000)
-ap.add_argument("--exe", default="./build/main")
-ap.add_argument("--out", default="grid_sweep")
-ap.add_argument("--pitch", type=float, default=150.0,
-                help="lattice pitch [nm]")
-args = ap.parse_args()
-
-exe  = Path(args.exe).resolve()
-root = Path(args.out).resolve()
-shutil.rmtree(root, ignore_errors=True); root.mkdir()
-
-json_runs = []
-for nx in range(1,6):
-    for ny in range(1,6):
-        json_runs.append(run_one(nx, ny, args.nevents, exe, root))
-
-rows = []
-for p in json_runs:
-	with p.open() as fp: rec = json.load(fp)
-    # tokens   = p.parents[0].name.split("_")  # nx{nx}_ny{ny}
-    # rec["nx"] = int(tokens[0][2:]); rec["ny"] = int(tokens[1][2:])
-	folder = p.parent.parent               # …/nx<nx>_ny<ny>
-	nx_str, ny_str = folder.name.split("_")  # "nx2", "ny5"
-	rec["nx"] = int(nx_str[2:])
-	rec["ny"] = int(ny_str[2:])
-	rows.append(rec)
-
-pd.DataFrame(rows).to_csv(root / "summary.csv", index=False)
-print("★ Wrote", root / "summary.csv")
\ No newline at end of file
+    try:
+        subprocess.run(cmd, cwd=wdir, check=True)
+    except subprocess.CalledProcessError as e:
+        print(f"  nx{nx}_ny{ny} failed ({e}) – continuing with the next point")
+        return None
+
+    from sweep_queue import latest_run_json
+    return latest_run_json(wdir)
+
+
+def main():
+    # ───────────────────────────────── CLI ───────────────────────────────────
+    ap = argparse.ArgumentParser()
+    ap.add_argument("-n", "--nevents", type=int, default=25000)
+    ap.add_argument("--exe", default="./build/main")
+    ap.add_argument("--out", default="grid_sweep")
+    ap.add_argument("--pitch", type=float, default=150.0,
+                    help="lattice pitch [nm]")
+    ap.add_argument("--queue", default=None,
+                    help="shared queue directory (enables distributed mode)")
+    ap.add_argument("--reuse-cache", action="store_true",
+                    help="keep old results and pass --reuse-cache to main")
+    args = ap.parse_args()
+    extra = ["--reuse-cache"] if args.reuse_cache else []
+
+    exe  = Path(args.exe).resolve()
+    root = Path(args.out).resolve()
+
+    if args.queue:
+        from sweep_queue import SweepQueue, enqueue_grid, worker, collect
+        q = SweepQueue(args.queue)
+        root.mkdir(parents=True, exist_ok=True)
+        print(f"Enqueued {enqueue_grid(q, root, args.nevents, exe, args.pitch, extra)} point(s)")
+        worker(q)                      # this process is just one more worker
+        df = collect(q)
+        df.to_csv(root / "summary.csv", index=False)
+        print("★ Wrote", root / "summary.csv")
+        return
+
+    if not args.reuse_cache:
+        shutil.rmtree(root, ignore_errors=True)
+    root.mkdir(parents=True, exist_ok=True)
+
+    from sweep_queue import load_run
+    json_runs = []
+    for nx in range(1,6):
+        for ny in range(1,6):
+            p = run_one(nx, ny, args.nevents, exe, root, args.pitch, extra)
+            if p is not None:
+                json_runs.append(p)
+
+    rows = []
+    for p in json_runs:
+        rec = load_run(p)
+        folder = p.parent.parent.parent       # …/nx<nx>_ny<ny>/results/<stamp>/run.json
+        nx_str, ny_str = folder.name.split("_")  # "nx2", "ny5"
+        rec["nx"] = int(nx_str[2:])
+        rec["ny"] = int(ny_str[2:])
+        rows.append(rec)
+
+    pd.DataFrame(rows).to_csv(root / "summary.csv", index=False)
+    print("★ Wrote", root / "summary.csv")
+
+
+if __name__ == "__main__":
+    main()
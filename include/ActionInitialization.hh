@@ -15,6 +15,7 @@
 
 /*──────────────────────────── std / proj ─────────────────────────────*/
 #include "GeometryConfig.hh"
+#include "RunConfig.hh"
 
 namespace util { class DataLogger; }
 class DetectorConstruction;
@@ -24,16 +25,21 @@ class ActionInitialization : public G4VUserActionInitialization
 {
   public:
     ActionInitialization(DetectorConstruction*       det,
-                         const geom::GeometryConfig& cfg);
+                         const geom::GeometryConfig& cfg,
+                         const sim::RunConfig&       runCfg = {});
     ~ActionInitialization() override;
 
     /* master vs. worker hooks */
     void BuildForMaster() const override;
     void Build()          const override;
 
+    /** @return the master-side logger (e.g. to find the run.json written). */
+    util::DataLogger* Logger() const { return logger_; }
+
   private:
     const DetectorConstruction* fDet_;   ///< geometry handle
     const geom::GeometryConfig cfg_;     ///< deep copy for threads
+    const sim::RunConfig       runCfg_;  ///< seed + event range (all threads)
     util::DataLogger*          logger_;  ///< ONE instance, owned here
 };
 
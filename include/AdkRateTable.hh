@@ -0,0 +1,156 @@
+/**
+ * @file    AdkRateTable.hh
+ * @author  Mohammadreza Zakeri
+ * @date    2026-10-18
+ *
+ * @brief   Static-field tunnelling (ADK) rate of a hydrogenic bound state,
+ *          and the (ρ, z) rate table built from a field map (no Geant4).
+ *
+ * ────────────────────────────────────────────────────────────────────────────
+ *  Rate
+ *  ────────────────────────────────────────────────────────────────────────────
+ *  Ammosov–Delone–Krainov for a DC field F, in atomic units scaled to the
+ *  reduced mass μ of the bound particle (lengths a₀/μ, energies μE_h,
+ *  fields μ²E_au, times t_au/μ, with μ in m_e):
+ *
+ *    w = C²_{n*l*} f(l, m) I_p (2F₀/F)^{2n*−|m|−1} exp(−2F₀/3F)
+ *    n* = Z/√(2I_p),  l* = n* − 1,  F₀ = (2I_p)^{3/2}
+ *    C² = 2^{2n*} / (n* Γ(n*+l*+1) Γ(n*−l*))
+ *    f  = (2l+1)(l+|m|)! / (2^{|m|} |m|! (l−|m|)!)
+ *
+ *  Z is the charge left behind and I_p the binding energy of each state.
+ *  The states' rates are summed with their weights (e.g. populations).
+ *  For hydrogen 1s this is Landau's w = 4/F · exp(−2/3F).  ADK overshoots
+ *  above the barrier-suppression field F_BSI = I_p²/4Z; the report counts
+ *  the table nodes beyond it.
+ *
+ * ────────────────────────────────────────────────────────────────────────────
+ *  Table
+ *  ────────────────────────────────────────────────────────────────────────────
+ *  Regular grid in the cone-local frame of RateTable2D (ρ from the axis,
+ *  z from the base centre, metres).  |E| comes from any AxisymmetricField
+ *  (Gmsh mesh, resampled or solved map), the rows are split over threads.
+ *  Written as the TSV that RateTable2D reads ("# rho z w", 17 digits, so
+ *  the text round-trips exactly), or in its binary form (RateGridHeader).
+ *
+ *  Offline: tools/buildRateTable.cc.  Without a table: FieldRate
+ *  (RateProvider.hh, `main --rates=spec.json`) evaluates AdkRate at each
+ *  sample point instead.
+ */
+
+#ifndef ADK_RATE_TABLE_HH
+#define ADK_RATE_TABLE_HH
+
+/*────────────────────────────── stdlib ───────────────────────────────────*/
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/*──────────────────────────── project ────────────────────────────────────*/
+#include "AxisymmetricField.hh"
+#include "GeometryConfig.hh"
+#include "RateTable2D.hh"
+
+/**
+ * @class AdkRate
+ * @brief w(|E|) summed over the bound states of a Spec.
+ */
+class AdkRate
+{
+  public:
+    /// One bound state.
+    struct State {
+        double ip_eV  {0.0};   ///< Binding energy [eV]
+        int    l      {0};     ///< Orbital angular momentum
+        int    m      {0};     ///< Magnetic quantum number along F
+        double weight {1.0};   ///< Multiplies the state's rate
+    };
+
+    /// Bound system, table request and memo of FieldRate (JSON file, see Load()).
+    struct Spec {
+        double             Z          {1.0};   ///< Charge left behind [e]
+        double             mass_me    {1.0};   ///< Reduced mass [m_e]
+        std::vector<State> states;
+        double             cell_nm    {1.0};   ///< Table spacing
+        double             rho_max_nm {0.0};   ///< Table extent; 0 → the map's
+        double             z_min_nm   {0.0};   ///< Table extent; both 0 → the map's
+        double             z_max_nm   {0.0};
+        double             map_z0_nm  {0.0};   ///< Cone-local z of the map's z = 0
+        double             memo_rel   {1e-5};  ///< |E| quantum of FieldRate; 0 → exact
+
+        /**
+         * @brief Read a spec from JSON, e.g.
+         *   { "Z": 2, "mass_me": 201.07, "states": [ { "ip_eV": 10939 } ],
+         *     "cell_nm": 1, "rho_max_nm": 75, "z_min_nm": -60, "z_max_nm": 1100 }
+         * @throw std::runtime_error if unreadable, std::invalid_argument if bad.
+         */
+        static Spec Load(const std::string& path);
+
+        /** @return FNV-1a of what the rates depend on (system and memo_rel). */
+        std::uint64_t Hash() const;
+    };
+
+    /** @throw std::invalid_argument on a bad spec. */
+    explicit AdkRate(const Spec& spec);
+
+    /** @return Σ weight · w [s⁻¹] at field magnitude F [V/m]. */
+    double operator()(double F_V_per_m) const noexcept;
+
+    /**
+     * @brief w[i] = (*this)(F[i]) for i < n.  States in the outer loop and
+     *        branch-free points in the inner one, so the compiler can
+     *        vectorise it where vector exp/log are available.
+     */
+    void Evaluate(const double* F_V_per_m, double* w, std::size_t n) const noexcept;
+
+    /** @return lowest barrier-suppression field of the states [V/m]. */
+    double BsiField() const noexcept { return bsi_; }
+
+  private:
+    /// log w_au = logA − p·log F_au − B/F_au
+    struct Term { double logA, p, B; };
+    std::vector<Term> terms_;
+    double fieldAu_;                           ///< V/m per scaled field unit
+    double rateAu_;                            ///< s⁻¹ per scaled rate unit
+    double bsi_ {0.0};
+};
+
+/**
+ * @class AdkRateTable
+ * @brief AdkRate evaluated on a regular (ρ, z) grid of a field map.
+ */
+class AdkRateTable
+{
+  public:
+    /**
+     * @param map      Single-cone map in `field`'s units.
+     * @param field    Geometry `field` block (pos_unit_m, e_unit_V_per_m).
+     * @param threads  0 → all hardware threads.
+     * @throw std::invalid_argument on a bad spec or an empty grid.
+     */
+    AdkRateTable(const AxisymmetricField& map, const geom::FieldSpec& field,
+                 const AdkRate::Spec& spec, unsigned threads = 0);
+
+    /** @brief Write "# rho z w" rows (ρ-major), as RateTable2D reads them. */
+    void WriteTsv(const std::string& path) const;
+    /** @brief Write the binary form (RateGridHeader + rates). */
+    void WriteBinary(const std::string& path) const;
+
+    /** @brief Print the grid, the peak field and rate and the BSI count. */
+    void Report(std::ostream& os) const;
+
+    const RateGridHeader&      Grid()  const noexcept { return grid_; }
+    const std::vector<double>& Rates() const noexcept { return w_; }
+
+  private:
+    RateGridHeader      grid_ {};
+    std::vector<double> w_;                   ///< [s⁻¹], index i·nZ + j
+    double              peakField_ {0.0};     ///< [V/m]
+    double              peakRate_  {0.0};     ///< [s⁻¹]
+    double              bsi_       {0.0};     ///< [V/m]
+    std::size_t         aboveBsi_  {0};
+};
+
+#endif /* ADK_RATE_TABLE_HH */
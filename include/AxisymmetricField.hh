@@ -0,0 +1,54 @@
+/**
+ * @file    AxisymmetricField.hh
+ * @author  Mohammadreza Zakeri
+ * @date    2026-10-18
+ *
+ * @brief   Common interface of the axisymmetric (r, z) field maps.
+ *
+ *  A map only answers “(Er, Ez) at (r, z)”; the revolution into (x, y, z)
+ *  is shared.  Implementations:
+ *    • RevolvedFieldFromPOS – the Gmsh triangle mesh itself,
+ *    • ResampledField       – the mesh resampled onto regular grids.
+ *
+ *  Implementations are immutable after construction, so one instance can
+ *  be shared read-only by all worker threads.  No Geant4: the offline
+ *  tools (resampleField, solveField, buildRateTable) build without it.
+ */
+
+#ifndef AXISYMMETRIC_FIELD_HH
+#define AXISYMMETRIC_FIELD_HH
+
+#include <cmath>
+
+class AxisymmetricField
+{
+  public:
+    virtual ~AxisymmetricField() = default;
+
+    /**
+     * @brief (Er, Ez) at cylindrical (r, z), in the map's own units.
+     */
+    virtual void FieldRZ(double r, double z, double& Er, double& Ez) const = 0;
+
+    /** @brief (r, z) extent covered by the map's own data. */
+    virtual void Bounds(double& r0, double& r1, double& z0, double& z1) const = 0;
+
+    /**
+     * @brief Field at a 3D position (map units), revolved about the z axis.
+     * @param[out] E  (Ex, Ey, Ez) at (x, y, z).
+     */
+    void Field(double x, double y, double z, double E[3]) const
+    {
+        const double r = std::sqrt(x * x + y * y);
+        double Er, Ez;
+        FieldRZ(r, z, Er, Ez);
+
+        // Project radial field into x-y plane
+        const double c = r < 1e-9 ? 0.0 : Er / r;
+        E[0] = c * x;
+        E[1] = c * y;
+        E[2] = Ez;
+    }
+};
+
+#endif /* AXISYMMETRIC_FIELD_HH */
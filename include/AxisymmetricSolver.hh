@@ -0,0 +1,147 @@
+/**
+ * @file    AxisymmetricSolver.hh
+ * @author  Mohammadreza Zakeri
+ * @date    2026-10-18
+ *
+ * @brief   Built-in electrostatic solve of one cone of the comb on an (r, z)
+ *          grid, giving the field map without Gmsh (no Geant4).
+ *
+ * ────────────────────────────────────────────────────────────────────────────
+ *  Problem (lengths in nm, z = 0 at the cone base)
+ *  ────────────────────────────────────────────────────────────────────────────
+ *    ∇²φ = (1/r) ∂r(r ∂rφ) + ∂z²φ = 0   on 0 ≤ r ≤ R, 0 ≤ z ≤ h + gap
+ *    φ = v_cone   on the base plane z = 0 and inside the cone
+ *                 r ≤ r_base + (r_tip − r_base)·z/h, z ≤ h
+ *    φ = v_anode  on the anode plane z = h + gap
+ *    ∂rφ = 0      at r = R (mirror wall of the cone's lattice cell)
+ *  The cone is a G4Cons with a flat top of radius r_tip, as built by
+ *  ConeCombBuilder; it is staircased onto the grid nodes.
+ *
+ * ────────────────────────────────────────────────────────────────────────────
+ *  Discretisation and solver
+ *  ────────────────────────────────────────────────────────────────────────────
+ *  Vertex-centred five-point stencil.  The flux form gives the radial
+ *  neighbours weights (1 ± 1/2i)/hr²; on the axis the limit 2∂r²φ applies
+ *  and at r = R the ghost column mirrors column nr − 2.  The finest grid
+ *  has m·2^L cells per axis with spacing ≤ `cell_nm`.  Each coarser level
+ *  halves it and has its own conductor mask and stencil.  One V-cycle
+ *  does two red–black Gauss–Seidel sweeps, a full-weighting restriction
+ *  of the residual, the coarse correction, bilinear prolongation and two
+ *  more sweeps in the opposite colour order.  The coarsest level is
+ *  relaxed to convergence.
+ *
+ *  Grids coarser than the cone radius do not see the cone, so plain
+ *  V-cycles stall or diverge on a tall, thin cone.  The V-cycle therefore
+ *  preconditions BiCGSTAB (two V-cycles per iteration), which converges
+ *  in about 16 V-cycles whatever the grid size.  Iterations stop once the
+ *  max residual has dropped by `tolerance`, or after `max_cycles`
+ *  V-cycles.  A colour only reads the other colour, so sweeps, residuals
+ *  and dot products are split by rows over threads on the large levels.
+ *
+ *  E = −∇φ by central differences (one-sided on the electrode planes,
+ *  zero on the axis, at the mirror wall and inside the cone).  The field
+ *  is returned as a single-level ResampledField in the map units of
+ *  `field`, so it is cached, interpolated and superposed (ConeLatticeField)
+ *  exactly like a resampled Gmsh map.
+ *
+ *  Offline: tools/solveField.cc.  On load: DetectorConstruction when the
+ *  geometry has a `field.solve` block.  A sweep over cone dimensions only
+ *  needs another LoadOrSolve() with the modified GeometryConfig.
+ */
+
+#ifndef AXISYMMETRIC_SOLVER_HH
+#define AXISYMMETRIC_SOLVER_HH
+
+/*────────────────────────────── stdlib ───────────────────────────────────*/
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/*──────────────────────────── project ────────────────────────────────────*/
+#include "GeometryConfig.hh"
+#include "ResampledField.hh"
+
+class AxisymmetricSolver
+{
+  public:
+    /// Outcome of Solve().
+    struct Convergence {
+        int      levels   {0};    ///< Grids in the hierarchy
+        int      cycles   {0};    ///< V-cycles run
+        double   residual {0.0};  ///< Final / initial max residual
+        double   seconds  {0.0};  ///< Wall time
+        unsigned threads  {1};
+        bool     converged{false};///< Reached `tolerance` (or round-off)
+    };
+
+    /**
+     * @brief Set up the grids for `cfg` (cone, gap, r_outer and field.solve).
+     * @throw std::invalid_argument on a bad solve block or a grid too large.
+     */
+    explicit AxisymmetricSolver(const geom::GeometryConfig& cfg);
+
+    /** @brief Solve for φ; `threads` = 0 → all hardware threads. */
+    Convergence Solve(unsigned threads = 0);
+
+    /** @return φ [V] at (r, z) [nm], bilinear on the finest grid. */
+    double Potential(double r_nm, double z_nm) const;
+
+    /** @return E = −∇φ on the finest grid as a map in `field` units. */
+    std::shared_ptr<ResampledField> FieldMap() const;
+
+    /** @brief Print the grid and the convergence of the last Solve(). */
+    void Report(std::ostream& os) const;
+
+    /** @return util::SolveHash(cfg) (SolveHash.hh). */
+    static std::uint64_t Hash(const geom::GeometryConfig& cfg);
+
+    /** @return cache file name for `cfg` (inside field.solve.cache_dir). */
+    static std::string CachePath(const geom::GeometryConfig& cfg);
+
+    /**
+     * @brief Solved map for `cfg`, from the cache or solved and cached.
+     *
+     * A cache that cannot be written is reported on `log`; the map solved
+     * in memory is returned instead.  `threads` as for Solve().
+     * @throw std::invalid_argument on a bad solve block.
+     */
+    static std::shared_ptr<const ResampledField>
+    LoadOrSolve(const geom::GeometryConfig& cfg, std::ostream& log, bool rebuild = false,
+                unsigned threads = 0);
+
+  private:
+    /// One grid of the hierarchy.
+    struct Level {
+        std::uint32_t nr, nz;
+        double        hr, hz;                 ///< [nm]
+        double        cz;                     ///< 1/hz²
+        std::vector<double>       cE, cW, dg; ///< Radial weights, diagonal, per column
+        std::vector<double>       phi, f, res;
+        std::vector<std::uint8_t> fixed;      ///< Dirichlet node
+    };
+
+    void   Smooth  (Level& L, int sweeps, bool reverse) const;
+    /** @brief out = f − A·v on the free nodes (f = nullptr → −A·v); @return max |out|. */
+    double Residual(const Level& L, const double* v, const double* f, double* out) const;
+    void   Restrict(const Level& fine, Level& coarse) const;
+    void   Prolong (const Level& coarse, Level& fine) const;
+    void   Cycle   (std::size_t l);
+    /** @brief z ≈ A⁻¹ r by one V-cycle from zero. */
+    void   Precondition(const std::vector<double>& r, std::vector<double>& z);
+    double Dot(const std::vector<double>& a, const std::vector<double>& b) const;
+
+    /** @brief fn(j0, j1) over interior row blocks, threaded if `L` is large. */
+    template <class F> void Rows(const Level& L, F&& fn) const;
+
+    std::vector<Level>  levels_;              ///< Finest first; V-cycle workspace
+    std::vector<double> phi_;                 ///< Potential on the finest grid [V]
+    geom::GeometryConfig cfg_;
+    double   scale_;                          ///< nm → map length units
+    bool     bicubic_;
+    unsigned threads_ {1};
+    Convergence conv_;
+};
+
+#endif /* AXISYMMETRIC_SOLVER_HH */
@@ -0,0 +1,180 @@
+/**
+ * @file    BallisticEngine.hh
+ * @author  Mohammadreza Zakeri
+ * @date    2026-10-18
+ *
+ * @brief   Straight-line transport of the mu-α primaries without Geant4,
+ *          for the field-free vacuum world (`main --engine=ballistic|check`).
+ *
+ * ────────────────────────────────────────────────────────────────────────────
+ *  Why
+ *  ────────────────────────────────────────────────────────────────────────────
+ *  World, shells and cones are all G4_Galactic and no field is attached,
+ *  so a mu-α flies in a straight line until it is captured or ionised.
+ *  Geant4 still steps it through every shell in 1–5 nm steps.  This engine
+ *  follows the same line analytically and writes the same `run.json`.
+ *
+ * ────────────────────────────────────────────────────────────────────────────
+ *  One event
+ *  ────────────────────────────────────────────────────────────────────────────
+ *  1. Draw the primary as PrimaryGenerator does, from the event's
+ *     counter-based streams (EventRandom.hh).
+ *  2. List the shell columns the ray crosses, ordered by entry (ColumnGrid
+ *     with zero margin, i.e. the exact outer-shell cylinders).
+ *  3. Per crossing: if the ray enters the cone inside the column, the event
+ *     is a capture; as in SteppingAction, a cone hit ends the shell segment
+ *     without an ionisation trial.  Otherwise the chord through the column
+ *     is one shell segment: CrossingProbability() gives Pint, then comes
+ *     the Bernoulli trial on the ionisation stream, or the w·Pint score
+ *     with `--force-ion`.
+ *
+ * ────────────────────────────────────────────────────────────────────────────
+ *  Agreement with the Geant4 path
+ *  ────────────────────────────────────────────────────────────────────────────
+ *  With `--crn` or `--rng=philox` both paths take event i's primary and its
+ *  k-th ionisation trial from the same uniforms, so their outcomes can be
+ *  paired event by event (`--engine=check`).  They are close, not identical.
+ *  Geant4 opens a segment at the end of the first step inside a shell and
+ *  closes it at the end of the first step outside.  It also merges the
+ *  crossings of touching columns into one segment.  The engine integrates
+ *  over the exact chord of each column.  Without `--crn` / `--rng=philox`
+ *  the engine keys its streams as `--crn` does.  It is then statistically
+ *  equivalent to the Geant4 path, but not event by event.
+ *
+ *  Geant4-free.  The integer tallies and outcome flags depend on neither
+ *  the thread count nor the scheduling.
+ */
+
+#ifndef BALLISTIC_ENGINE_HH
+#define BALLISTIC_ENGINE_HH
+
+/*────────────────────────────── stdlib ───────────────────────────────────*/
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+/*──────────────────────────── project ────────────────────────────────────*/
+#include "ColumnGrid.hh"
+#include "GeometryConfig.hh"
+#include "RateProvider.hh"
+#include "RunConfig.hh"
+#include "RunStats.hh"   // WeightedSums
+
+namespace sim {
+
+/** mu-α rest mass [MeV]; keep in step with MuAlpha5p::Definition(). */
+constexpr double kMuAlphaMass_MeV = 3727.379;
+
+/*======================================================================*/
+/*  1.  Tallies (same content as the merged RunAction accumulables)     */
+/*======================================================================*/
+
+/**
+ * @struct BallisticTally
+ * @brief  Everything DataLogger::DumpRunSummary() needs, plus the wall time.
+ */
+struct BallisticTally
+{
+    /** Outcome bits, as in EventOutcomes.hh (`outcomes.u8`). */
+    enum Flag : std::uint8_t { kIon = 1u << 0, kCap = 1u << 1 };
+
+    std::vector<unsigned>     coneIon, coneCap, panelIon, panelCap;
+    unsigned long             nEvents {0}, nIon {0}, nCap {0}, nTransmitted {0};
+    util::WeightedSums        weights;    ///< `--force-ion` only
+    std::vector<std::uint8_t> outcomes;   ///< One byte per event (`--crn` only)
+    double                    seconds {0};///< Wall time of BallisticEngine::Run()
+
+    /** @brief Fold in another part (counts and weights; not the outcomes). */
+    void Add(const BallisticTally& o);
+};
+
+/*======================================================================*/
+/*  2.  Engine                                                          */
+/*======================================================================*/
+
+/**
+ * @class BallisticEngine
+ * @brief Immutable after construction; Run() may use any number of threads.
+ */
+class BallisticEngine
+{
+  public:
+    /**
+     * @throw  std::invalid_argument for settings the engine does not model:
+     *         `--bias`, `--sampler=sobol`, `--strata`, `--target-rel-error`,
+     *         geometry importances and an electric field.
+     */
+    BallisticEngine(const geom::GeometryConfig& cfg, const RunConfig& run,
+                    const RateProvider& rates);
+
+    /** @brief Propagate the events [firstEvent, firstEvent + nEvents). */
+    BallisticTally Run(unsigned threads) const;
+
+    /**
+     * @brief  Propagate global event `global` and tally it into `t`.
+     * @param  scratch  Reused crossing list (one per thread).
+     * @return the event's outcome bits (BallisticTally::Flag).
+     */
+    std::uint8_t Event(long global, BallisticTally& t,
+                       std::vector<geom::ColumnGrid::Crossing>& scratch) const;
+
+  private:
+    /** @return empty tallies sized for this geometry. */
+    BallisticTally Empty() const;
+
+    /**
+     * @brief  First parameter t in [t0, t1] at which the ray is inside the
+     *         cone of column `c` (solid truncated cone, base at z_lo + gap).
+     */
+    bool ConeEntry(const geom::ShellColumn& c, const double o[3], const double d[3],
+                   double t0, double t1, double& tHit) const noexcept;
+
+    geom::GeometryConfig cfg_;
+    RunConfig            run_;
+    const RateProvider&  rates_;
+    geom::ColumnGrid     grid_;
+    double               speed_nm_per_ns_;   ///< βc of the beam energy
+};
+
+/*======================================================================*/
+/*  3.  Cross-check against the Geant4 path (`--engine=check`)          */
+/*======================================================================*/
+
+/**
+ * @struct OutcomeComparison
+ * @brief  Paired comparison of two per-event outcome arrays.
+ *
+ * With common random numbers the two paths see the same primaries, so the
+ * paired (McNemar) statistic  z = (b − c)/√(b + c)  on the discordant
+ * events is far more sensitive than comparing two fractions.  Here b counts
+ * the events flagged only by Geant4 and c those flagged only by the engine.
+ */
+struct OutcomeComparison
+{
+    unsigned long n {0}, agree {0};            ///< Events, identical flag bytes
+    unsigned long ionG4 {0}, ionBal {0};       ///< Ionised events per path
+    unsigned long capG4 {0}, capBal {0};       ///< Captured events per path
+    unsigned long ionOnlyG4 {0}, ionOnlyBal {0};
+    unsigned long capOnlyG4 {0}, capOnlyBal {0};
+
+    /** @return McNemar z of the ionisation / capture flags (0 if no discord). */
+    double ZIon() const noexcept { return Z(ionOnlyG4, ionOnlyBal); }
+    double ZCap() const noexcept { return Z(capOnlyG4, capOnlyBal); }
+
+  private:
+    static double Z(unsigned long b, unsigned long c) noexcept
+    {
+        return b + c ? (static_cast<double>(b) - static_cast<double>(c))
+                       / std::sqrt(static_cast<double>(b + c)) : 0.0;
+    }
+};
+
+/**
+ * @brief  Compare two outcome arrays of the same event range.
+ * @throw  std::invalid_argument if the sizes differ.
+ */
+OutcomeComparison CompareOutcomes(const std::vector<std::uint8_t>& geant4,
+                                  const std::vector<std::uint8_t>& ballistic);
+
+} // namespace sim
+#endif /* BALLISTIC_ENGINE_HH */
@@ -0,0 +1,91 @@
+/**
+ * @file    BeamBias.hh
+ * @author  Mohammadreza Zakeri
+ * @date    2026-10-18
+ *
+ * @brief   Importance-sampled primary beam focused on the shell columns
+ *          (`main --bias=<f>`, no Geant4).
+ *
+ * ────────────────────────────────────────────────────────────────────────────
+ *  Densities
+ *  ────────────────────────────────────────────────────────────────────────────
+ *  The nominal source p(y, z) is the Gaussian spot of BeamSpec; directions
+ *  are drawn identically in both modes and cancel from the weight.  Let U
+ *  be the set of start points whose straight line *can* reach a shell
+ *  column (ConeLattice.hh): each column projected onto the start plane,
+ *  widened by the largest transverse drift  (x_col + r − x0)·tan θ_max.
+ *  The biased source is the defensive mixture
+ *
+ *      q = (1 − f)·p  +  f·p·1_U / P(U),
+ *
+ *  so every event carries the exact likelihood ratio
+ *
+ *      w = p / q = 1 / ( 1 − f + f·1_U / P(U) ),
+ *
+ *  bounded by 1/(1 − f).  U is a union of axis-aligned rectangles, which
+ *  is cut into disjoint cells; P(U) is a sum of products of normal CDF
+ *  differences (exact) and p·1_U is sampled cell by cell with the inverse
+ *  CDF (no rejection loop).
+ */
+
+#ifndef BEAM_BIAS_HH
+#define BEAM_BIAS_HH
+
+/*────────────────────────────── stdlib ───────────────────────────────────*/
+#include <vector>
+
+/*──────────────────────────── project ────────────────────────────────────*/
+#include "ConeLattice.hh"
+#include "GeometryConfig.hh"
+#include "RunConfig.hh"
+
+namespace sim {
+
+/**
+ * @class FocusedBeam
+ * @brief Sampler and weight of the shell-focused beam mixture.
+ *
+ * Immutable after construction, so one instance per worker is plenty.
+ */
+class FocusedBeam
+{
+  public:
+    /**
+     * @param  fraction  f ∈ [0, 1): share of events from the focused part.
+     * @throw  std::invalid_argument for f outside [0, 1).
+     */
+    FocusedBeam(const geom::GeometryConfig& cfg, const BeamSpec& beam,
+                double fraction);
+
+    /** @return P(U) under the nominal beam. */
+    double PFocus() const noexcept { return pU_; }
+
+    /** @return `true` if the start point (y, z) [nm] lies in U. */
+    bool Inside(double y_nm, double z_nm) const noexcept;
+
+    /** @return likelihood ratio p/q of a start point (y, z) [nm]. */
+    double Weight(double y_nm, double z_nm) const noexcept;
+
+    /**
+     * @brief  Draw (y, z) [nm] from p restricted to U.
+     * @param  uCell, uy, uz  independent uniforms in (0, 1).
+     */
+    void SampleFocused(double uCell, double uy, double uz,
+                       double& y_nm, double& z_nm) const noexcept;
+
+    /** @return `true` if the mixture picks the focused part for uniform `u`. */
+    bool PickFocused(double u) const noexcept { return u < f_; }
+
+  private:
+    struct Rect { double y0, y1, z0, z1; };   ///< start-plane window [nm]
+    struct Cell { double y0, y1, z0, z1, cum; };
+
+    double            f_;
+    double            muY_, muZ_, sigma_;
+    double            pU_ {0.0};
+    std::vector<Rect> rects_;
+    std::vector<Cell> cells_;    ///< disjoint, `cum` = cumulative mass
+};
+
+} // namespace sim
+#endif /* BEAM_BIAS_HH */
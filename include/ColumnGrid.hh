@@ -0,0 +1,87 @@
+/**
+ * @file    ColumnGrid.hh
+ * @author  Mohammadreza Zakeri
+ * @date    2026-10-18
+ *
+ * @brief   Uniform (x, y) cell list over the shell columns for exact
+ *          straight-line reachability tests (no Geant4).
+ *
+ * ────────────────────────────────────────────────────────────────────────────
+ *  Why
+ *  ────────────────────────────────────────────────────────────────────────────
+ *  In a field-free vacuum world a mu-α moves on a straight line, and it can
+ *  only be captured or ionised inside a shell column (ConeLattice.hh).  A
+ *  primary whose ray misses every column can therefore be dropped at birth
+ *  without changing any tally (StackingAction).
+ *
+ * ────────────────────────────────────────────────────────────────────────────
+ *  How
+ *  ────────────────────────────────────────────────────────────────────────────
+ *  The columns are z-aligned cylinders, so only their (x, y) footprints
+ *  are binned: each disk (radius r + margin) goes into every square cell
+ *  of side ≈ 2(r + margin) that its bounding box touches.  A ray is clipped
+ *  to the grid and walked cell by cell (Amanatides–Woo); the columns of
+ *  each visited cell get the exact ray / finite-cylinder test, and the walk
+ *  stops at the first hit (Hits) or runs to the end (Crossings, used by the
+ *  ballistic engine with a zero margin).  `margin_nm` widens every column so that
+ *  round-off can only ever keep a track, never drop one.
+ */
+
+#ifndef COLUMN_GRID_HH
+#define COLUMN_GRID_HH
+
+/*────────────────────────────── stdlib ───────────────────────────────────*/
+#include <vector>
+
+/*──────────────────────────── project ────────────────────────────────────*/
+#include "ConeLattice.hh"
+#include "GeometryConfig.hh"
+
+namespace geom {
+
+/**
+ * @class ColumnGrid
+ * @brief Cell list of ShellColumns; immutable after construction.
+ */
+class ColumnGrid
+{
+  public:
+    /** @param margin_nm  Extra radius / axial length added to every column. */
+    explicit ColumnGrid(const GeometryConfig& cfg, double margin_nm = 1.0);
+
+    /**
+     * @return `true` if the ray  o + t·d,  t ≥ 0  [nm] meets any column.
+     *         `d` need not be normalised.
+     */
+    bool Hits(const double o[3], const double d[3]) const noexcept;
+
+    /** @brief One column met by a ray, between parameters `tIn` ≤ `tOut`. */
+    struct Crossing { int column; double tIn, tOut; };
+
+    /**
+     * @brief  Every column the ray  o + t·d,  t ≥ 0  meets, ordered by entry.
+     * @param[out] out  Cleared first; reuse it across rays to avoid allocations.
+     */
+    void Crossings(const double o[3], const double d[3], std::vector<Crossing>& out) const;
+
+    std::size_t Columns() const noexcept { return cols_.size(); }
+
+    /** @return column `k` in ShellColumns() order, widened by the margin. */
+    const ShellColumn& Column(std::size_t k) const noexcept { return cols_[k]; }
+
+  private:
+    bool Chord(const ShellColumn& c, const double o[3], const double d[3],
+               double& tIn, double& tOut) const noexcept;
+    template <class Visit>
+    bool Walk(const double o[3], const double d[3], Visit&& visit) const;
+    const std::vector<int>& Cell(int ix, int iy) const noexcept { return cells_[iy * nx_ + ix]; }
+
+    std::vector<ShellColumn>      cols_;
+    double                        margin_;
+    double                        x0_ {0}, y0_ {0}, h_ {1};   ///< grid origin, cell side
+    int                           nx_ {0}, ny_ {0};
+    std::vector<std::vector<int>> cells_;                     ///< column indices per cell
+};
+
+} // namespace geom
+#endif /* COLUMN_GRID_HH */
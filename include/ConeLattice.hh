@@ -0,0 +1,65 @@
+/**
+ * @file    ConeLattice.hh
+ * @author  Mohammadreza Zakeri
+ * @date    2026-10-18
+ *
+ * @brief   Where ConeCombBuilder puts the cones and their shells, as plain
+ *          numbers (no Geant4).
+ *
+ * Each cone of panel p, lattice site (ix, iy) has its axis along +z at
+ *
+ *      x = x0 + (ix − (nx−1)/2)·pitch
+ *      y = offset.y + (iy − (ny−1)/2)·pitch
+ *
+ * with its base at z = offset.z.  The three shells are coaxial cylinders
+ * of outer radius `r_outer_nm` spanning [base − gap, base + h_cone + gap].
+ * Keep this in step with ConeCombBuilder::placePanel().
+ */
+
+#ifndef CONE_LATTICE_HH
+#define CONE_LATTICE_HH
+
+/*────────────────────────────── stdlib ───────────────────────────────────*/
+#include <vector>
+
+/*──────────────────────────── project ────────────────────────────────────*/
+#include "GeometryConfig.hh"
+
+namespace geom {
+
+/**
+ * @struct ShellColumn
+ * @brief  Outer envelope of one cone's shells: a z-aligned cylinder [nm].
+ */
+struct ShellColumn
+{
+    double x_nm, y_nm;        ///< Axis position
+    double z_lo_nm, z_hi_nm;  ///< Axial extent (gap included)
+    double r_nm;              ///< Outer shell radius
+    int    panel;             ///< Panel index (0-based)
+};
+
+/** @return the shell envelope of every cone, in builder placement order. */
+inline std::vector<ShellColumn> ShellColumns(const GeometryConfig& cfg)
+{
+    std::vector<ShellColumn> out;
+    out.reserve(cfg.nCones());
+
+    for (std::size_t p = 0; p < cfg.panels.size(); ++p)
+    {
+        const PanelSpec& ps = cfg.panels[p];
+        const double     zb = ps.offset_nm.z_nm;
+        for (int ix = 0; ix < ps.nx; ++ix)
+            for (int iy = 0; iy < ps.ny; ++iy)
+                out.push_back({ps.x0_nm + (ix - 0.5 * (ps.nx - 1)) * ps.pitch_nm,
+                               ps.offset_nm.y_nm + (iy - 0.5 * (ps.ny - 1)) * ps.pitch_nm,
+                               zb - cfg.gap_nm,
+                               zb + cfg.cone.h_cone_nm + cfg.gap_nm,
+                               cfg.r_outer_nm,
+                               static_cast<int>(p)});
+    }
+    return out;
+}
+
+} // namespace geom
+#endif /* CONE_LATTICE_HH */
@@ -0,0 +1,117 @@
+/**
+ * @file    ConeLatticeField.hh
+ * @author  Mohammadreza Zakeri
+ * @date    2026-10-18
+ *
+ * @brief   The axisymmetric field map copied onto every cone of the
+ *          lattice and superposed over the nearest cones.
+ *
+ * ────────────────────────────────────────────────────────────────────────────
+ *  Model
+ *  ────────────────────────────────────────────────────────────────────────────
+ *  The map solves one cone in an applied field E_bg ẑ.  Cone k perturbs
+ *  that field by  δE_k(p) = E_map(p − b_k − o) − E_bg ẑ,  where b_k is the
+ *  cone's base centre and o = `origin_nm`.  The lattice field is
+ *    E(p) = E_bg ẑ + Σ_k δE_k(p),
+ *  summed over at most K = `k_nearest` cones, nearest axis first, whose
+ *  axes lie within the cutoff ρ_c of p and whose map covers p.  A single
+ *  cone with K = 1 gives the plain revolved map back inside its extent.
+ *
+ * ────────────────────────────────────────────────────────────────────────────
+ *  Cutoff and accuracy
+ *  ────────────────────────────────────────────────────────────────────────────
+ *  The decay envelope  D(ρ) = max |δE| over r ≥ ρ  is sampled from the map
+ *  itself on a 256 × 256 (r, z) raster.  `cutoff_nm` = 0 picks the smallest
+ *  sampled ρ_c with D(ρ_c) ≤ `tolerance` · D(0).  Every cone left out by the
+ *  cutoff is then off by at most D(ρ_c).  Together they are off by at
+ *  most Σ D(ρ_k) over ρ_k > ρ_c; this sum is evaluated on the axis of the
+ *  cone nearest the lattice centre.  A map narrower than that ρ_c
+ *  caps the cutoff at its edge, and the report says so.  K must cover
+ *  the cones within ρ_c of an axis, otherwise near cones are dropped;
+ *  Report() prints that count.
+ *
+ * ────────────────────────────────────────────────────────────────────────────
+ *  Neighbour search
+ *  ────────────────────────────────────────────────────────────────────────────
+ *  Uniform (x, y) cell list of the cone axes with cell side ≥ ρ_c.  A query
+ *  scans the 3 × 3 cells around it, keeps the candidates within ρ_c and
+ *  their local z inside the map, and sorts the K nearest by insertion.
+ *
+ *  Lengths in nm, fields in the map's own units.  Immutable after
+ *  construction, so one instance serves all worker threads.  No Geant4.
+ */
+
+#ifndef CONE_LATTICE_FIELD_HH
+#define CONE_LATTICE_FIELD_HH
+
+/*────────────────────────────── stdlib ───────────────────────────────────*/
+#include <memory>
+#include <ostream>
+#include <vector>
+
+/*──────────────────────────── project ────────────────────────────────────*/
+#include "AxisymmetricField.hh"
+#include "GeometryConfig.hh"
+
+class ConeLatticeField
+{
+  public:
+    static constexpr int kMaxNearest = 64;   ///< Upper bound of `k_nearest`
+
+    /// Base centre of one cone [nm] (ConeInfo::baseCentre).
+    struct Cone { double x, y, z; };
+
+    /// What the cutoff leaves out, per cone [map field units].
+    struct Accuracy {
+        double cutoff_nm {0.0};  ///< ρ_c actually used
+        double tail      {0.0};  ///< D(ρ_c): bound on one neglected cone
+        double peak      {0.0};  ///< D(0):   largest perturbation of a cone
+        double sum       {0.0};  ///< Σ D(ρ) over the neglected cones, central axis
+        double edge_nm   {0.0};  ///< Radial extent of the map
+        bool   capped    {false};///< ρ_c limited by the map's extent
+        int    crowd     {0};    ///< Most cones within ρ_c of one cone axis
+    };
+
+    /**
+     * @param map    Single-cone map (mesh or resampled grid), shared.
+     * @param cones  Base centres of every cone [nm].
+     * @param f      `field` block; f.lattice must be Active().
+     * @throw std::invalid_argument on a bad lattice block or an empty map.
+     */
+    ConeLatticeField(std::shared_ptr<const AxisymmetricField> map,
+                     std::vector<Cone> cones, const geom::FieldSpec& f);
+
+    /**
+     * @brief  Superposed field at (x, y, z) [nm].
+     * @param[out] E  (Ex, Ey, Ez) [map field units]
+     */
+    void Field(double x, double y, double z, double E[3]) const;
+
+    /** @brief Print the cutoff, its error bound and the neighbour count. */
+    void Report(std::ostream& os) const;
+
+    const Accuracy& GetAccuracy() const noexcept { return acc_; }
+    std::size_t     Cones()       const noexcept { return cones_.size(); }
+
+  private:
+    void Envelope(double tolerance, double cutoff_nm);
+    void BuildCells();
+    int  Crowd() const;
+    int  CellX(double x) const noexcept;
+    int  CellY(double y) const noexcept;
+
+    std::shared_ptr<const AxisymmetricField> map_;
+    std::vector<Cone> cones_;                 ///< Map origins: base centre + origin_nm
+    int    k_;
+    double bg_;                               ///< E_bg [map field units]
+    double scale_;                            ///< nm → map length units
+    double r1_ {0}, z0_ {0}, z1_ {0};         ///< Map extent [map units]
+    double cut2_ {0};                         ///< ρ_c² [nm²]
+    Accuracy acc_;
+
+    double x0_ {0}, y0_ {0}, h_ {1};          ///< Grid origin, cell side [nm]
+    int    nx_ {1}, ny_ {1};
+    std::vector<std::vector<int>> cells_;     ///< Cone indices per cell
+};
+
+#endif /* CONE_LATTICE_FIELD_HH */
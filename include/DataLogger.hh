@@ -18,9 +18,10 @@
  *
  * ### Files produced (per run) 
  * ```
- * results/YYYYMMDDTHHMMSS/
+ * results/YYYYMMDDTHHMMSS[_shard<i>of<N>]/
  * ├── events.tsv        (optional per-event rows → header written here, footer closed in DumpRunSummary)
- * └── run.json          (flat one-object summary for jq / pandas)
+ * ├── run.json          (flat one-object summary for jq / pandas)
+ * └── outcomes.u8       (CRN mode only: one flag byte per event)
  * ```
  */
 
@@ -31,6 +32,7 @@
 #include <fstream>
 #include <chrono>
 #include <filesystem>
+#include <cstdint>
 #include <vector>
 #include <mutex>      // still needed if we later add a TSV row from workers
 /*───────────────────────────────── Geant4 ──────────────────────────────────*/
@@ -38,9 +40,48 @@
 
 /*──────────────────────────── project headers ──────────────────────────────*/
 #include "GeometryConfig.hh"
+#include "RunConfig.hh"
+#include "RunStats.hh"
+#include "Strata.hh"
 
 namespace util {
 
+/**
+ * @struct StopStatus
+ * @brief  Sequential-stopping state echoed into `run.json` (see RunAction).
+ */
+struct StopStatus
+{
+    double      relHalfWidth;  ///< Current relative confidence half-width
+    int         batches;       ///< Batches (beamOn calls) so far
+    const char* reason;        ///< "running", "target" or "budget"
+};
+
+/**
+ * @struct RunSummary
+ * @brief  Merged tallies handed to `DataLogger::DumpRunSummary()`.
+ *
+ * Filled by name at the call site; the optional blocks stay `nullptr`
+ * unless the run produced them.
+ */
+struct RunSummary
+{
+    unsigned long         nEvents      {0};  ///< Events processed in the run
+    unsigned long         nIon         {0};  ///< Total ionisation events (merged)
+    unsigned long         nCap         {0};  ///< Total capture events    (merged)
+    unsigned long         nTransmitted {0};  ///< Primaries killed at birth by the ray test (StackingAction)
+    std::vector<unsigned> coneIon;           ///< Per-cone ionisation tallies   (size = #cones)
+    std::vector<unsigned> coneCap;           ///< Per-cone capture tallies      (size = #cones)
+    std::vector<unsigned> panelIon;          ///< Per-panel ionisation tallies  (size = #panels)
+    std::vector<unsigned> panelCap;          ///< Per-panel capture tallies     (size = #panels)
+
+    const StopStatus*    stop     {nullptr};  ///< Sequential-stopping state
+    bool                 final    {true};     ///< `false` for intermediate batches: `run.json` is (re)written, the TSV stays open
+    const ReplicaCounts* qmc      {nullptr};  ///< Per-replica counts (`--sampler=sobol`)
+    const WeightedSums*  weighted {nullptr};  ///< Weighted scores (`--bias`, `--force-ion`, importance)
+    const sim::StratifiedEstimator* strata {nullptr};  ///< Batch-combined stratified estimate (`--strata`)
+};
+
 /**
  * @class DataLogger
  * @brief Collect-all-results-and-write-once helper (master thread only).
@@ -56,8 +97,11 @@ class DataLogger
     /**
      * @param[outDir] Directory where the per-run sub-directories will live
      *                (default = `"results"`).
+     * @param[runCfg] Seed / event-range settings, echoed into `run.json`
+     *                so that shards can be merged later.
      */
-    explicit DataLogger(const std::string& outDir = "results");
+    explicit DataLogger(const std::string&    outDir = "results",
+                        const sim::RunConfig& runCfg = {});
     ~DataLogger();
 
     DataLogger(const DataLogger&)            = delete;
@@ -77,34 +121,34 @@ class DataLogger
     /**
      * @brief Finish the TSV footer and emit a flat JSON run summary.
      *
-     * @param[in] cfg            GeometryConfig (pretty-printed into JSON)
-     * @param[in] nEvents        Number of events processed in the run
-     * @param[in] nIon           Total ionisation events (merged)
-     * @param[in] nCap           Total capture events    (merged)
-     * @param[in] coneIon        Per-cone ionisation tallies   (size = #cones)
-     * @param[in] coneCap        Per-cone capture tallies      (size = #cones)
-     * @param[in] panelIon       Per-panel ionisation tallies  (size = #panels)
-     * @param[in] panelCap       Per-panel capture tallies     (size = #panels)
+     * @param[in] cfg   GeometryConfig (pretty-printed into JSON)
+     * @param[in] run   Merged tallies and optional estimator blocks
      */
-    void DumpRunSummary(const geom::GeometryConfig& cfg,
-                        unsigned long               nEvents,
-                        unsigned long               nIon,
-                        unsigned long               nCap,
-                        const std::vector<unsigned>& coneIon,
-                        const std::vector<unsigned>& coneCap,
-                        const std::vector<unsigned>& panelIon,
-                        const std::vector<unsigned>& panelCap);
+    void DumpRunSummary(const geom::GeometryConfig& cfg, const RunSummary& run);
+
+    /**
+     * @brief Write per-event outcome flags to `…/outcomes.u8` (CRN mode).
+     *
+     * Raw bytes, one per event starting at `first_event` (bit 0 = ionised,
+     * bit 1 = captured) – `numpy.fromfile(path, dtype=np.uint8)`.
+     */
+    void DumpEventOutcomes(const std::vector<std::uint8_t>& flags);
 
     /// @return `true` once `InitOutputFiles()` has completed.
     [[nodiscard]] bool IsInitialized() const noexcept { return isInitialized_; }
+
+    /// @return `…/run.json` of the current run (empty before InitOutputFiles()).
+    [[nodiscard]] const std::string& JsonPath() const noexcept { return jsonPath_; }
     /// @}
 
   private:
     //───────────────────────────────────────────────────────────── Data members
     bool        isInitialized_ {false};   ///< Set by `InitOutputFiles()`.
 
+    sim::RunConfig runCfg_;   ///< Seed, event range and shard of this process
+
     std::string outDir_;      ///< Top-level directory (`results` by default).
-    std::string subDir_;      ///< `results/YYYYMMDDTHHMMSS`
+    std::string subDir_;      ///< `results/YYYYMMDDTHHMMSS[_shard<i>of<N>]`
     std::string tsvPath_;     ///< `…/events.tsv`
     std::string jsonPath_;    ///< `…/run.json`
 
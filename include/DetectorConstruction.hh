@@ -109,7 +109,11 @@
 
 /// Forward declarations to avoid heavy Geant4 headers in the header file
 class G4LogicalVolume;
+class G4Region;
 class G4VPhysicalVolume;
+class AxisymmetricField;
+class ConeLatticeField;
+class TiledFieldMap;
 
 /**
  * @class DetectorConstruction
@@ -131,9 +135,11 @@ class DetectorConstruction : public G4VUserDetectorConstruction
   public:
     /**
      * @brief Constructor.
-     * @param cfg  Pure-data description of the nano-comb geometry.
+     * @param cfg         Pure-data description of the nano-comb geometry.
+     * @param freeFlight  Attach FreeFlightModel to the panel envelope.
      */
-    explicit DetectorConstruction(const geom::GeometryConfig& cfg);
+    explicit DetectorConstruction(const geom::GeometryConfig& cfg,
+                                  bool freeFlight = true);
 
     // -------------------------------------------------------------------------
     /// Trivial virtual destructor – nothing to clean up manually
@@ -146,11 +152,21 @@ class DetectorConstruction : public G4VUserDetectorConstruction
      *
      * Internally this method:
      *   1. Creates the world logical & physical volumes.
-     *   2. Instantiates ::ConeCombBuilder with `cfg_`.
-     *   3. Delegates placement of every cone panel to the builder.
+     *   2. Places the panel envelope (vacuum box around every shell
+     *      column, root of its own G4Region) in the world.
+     *   3. Delegates placement of every cone panel, inside the
+     *      envelope, to ::ConeCombBuilder.
      */
     G4VPhysicalVolume* Construct() override;
 
+    /**
+     * @brief Per-thread hook – builds the electric field (FieldSetup.hh)
+     *        when the geometry has a `field` block, and attaches
+     *        FreeFlightModel to the envelope region unless free flight
+     *        is off.
+     */
+    void ConstructSDandField() override;
+
     // -------------------------------------------------------------------------
     /**
      * @brief Pointer to the master cone logical volume.
@@ -223,6 +239,16 @@ class DetectorConstruction : public G4VUserDetectorConstruction
       return cfg_;
     }
 
+    /**
+     * @brief Single-cone field map (mesh, resampled or solved), built by
+     *        Construct(); null without a revolved map.  Read by the
+     *        field-driven tunnelling rates (RateProvider.hh).
+     */
+    std::shared_ptr<const AxisymmetricField> GetFieldMap() const
+    {
+      return fFieldMap_;
+    }
+
   private:
     // -------------------------------------------------------------------------
     /// Pure-data copy of the geometry description
@@ -236,6 +262,19 @@ class DetectorConstruction : public G4VUserDetectorConstruction
     /// Cached pointer to the world logical volume
     G4LogicalVolume* fWorldLogical_{nullptr};
 
+    /// Panel envelope: every cone and shell is placed in it
+    G4LogicalVolume* fEnvelopeLogical_{nullptr};
+    G4Region*        fEnvelopeRegion_{nullptr};
+    bool             fFreeFlight_{true};   ///< `--no-free-flight` → false
+
+    /// Field map (mesh or resampled grid), loaded once in Construct() and
+    /// shared by all threads
+    std::shared_ptr<const AxisymmetricField> fFieldMap_;
+    /// The map superposed over every cone (`field.lattice`), or null
+    std::shared_ptr<const ConeLatticeField>  fLatticeField_;
+    /// 3-D grid (`field.grid3d`) used instead of the revolved map, or null
+    std::shared_ptr<const TiledFieldMap>     fFieldGrid3D_;
+
     // -------------------------------------------------------------------------
     /// Cached pointer to the shared cone logical volume
     G4LogicalVolume* fConeLogical_{nullptr};
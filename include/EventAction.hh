@@ -22,6 +22,8 @@
 #include "G4UserEventAction.hh"
 #include "globals.hh"
 
+class RunAction;
+
 // ======================================================================
 //  EventAction class declaration
 // ======================================================================
@@ -41,8 +43,10 @@ public:
 
     /**
      * @brief Constructor
+     * @param run  thread-local RunAction; in CRN mode the event outcome is
+     *             stored in its per-event EventOutcomes accumulable
      */
-    EventAction();
+    explicit EventAction(RunAction* run = nullptr);
 
     /**
      * @brief Destructor
@@ -60,6 +64,8 @@ public:
 
 	virtual void BeginOfEventAction(const G4Event*) override ;
 
+private:
+    RunAction* fRunAction {nullptr};
 };  // class EventAction
 
 #endif  // EVENTACTION_HH
\ No newline at end of file
@@ -0,0 +1,55 @@
+/**
+ * @file    EventOutcomes.hh
+ * @author  Mohammadreza Zakeri
+ * @date    2026-10-18
+ *
+ * @brief   Per-event outcome flags as a mergeable accumulable (CRN mode).
+ *
+ * One byte per event of this process' range (bit 0 = ionised, bit 1 =
+ * captured), indexed by `global event − RunConfig::firstEvent`.  Every
+ * event is processed by exactly one worker, so merging is a bytewise OR.
+ * The master writes the merged array to `outcomes.u8` next to `run.json`,
+ * which is what sweep_offset.py pairs across configurations.
+ *
+ * Memory: one byte per event *per thread* (10⁷ events × 8 threads = 80 MB).
+ */
+
+#pragma once
+
+/*─────────────────────────── Geant4 core ───────────────────────────────*/
+#include "G4VAccumulable.hh"
+
+/*──────────────────────────── stdlib ───────────────────────────────────*/
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+class EventOutcomes : public G4VAccumulable
+{
+  public:
+    enum Flag : std::uint8_t { kIon = 1u << 0, kCap = 1u << 1 };
+
+    explicit EventOutcomes(std::size_t nEvents = 0)
+    : G4VAccumulable("EventOutcomes"), flags_(nEvents, 0) {}
+
+    /** @brief Record the outcome of local event `idx` (ignored if out of range). */
+    void Set(std::size_t idx, bool ion, bool cap)
+    {
+        if (idx < flags_.size())
+            flags_[idx] = static_cast<std::uint8_t>((ion ? kIon : 0) | (cap ? kCap : 0));
+    }
+
+    /** @brief OR another thread's flags into this one. */
+    void Merge(const G4VAccumulable& other) override
+    {
+        const auto& o = static_cast<const EventOutcomes&>(other).flags_;
+        for (std::size_t i = 0; i < flags_.size() && i < o.size(); ++i) flags_[i] |= o[i];
+    }
+
+    void Reset() override { std::fill(flags_.begin(), flags_.end(), 0); }
+
+    const std::vector<std::uint8_t>& Flags() const noexcept { return flags_; }
+
+  private:
+    std::vector<std::uint8_t> flags_;
+};
@@ -0,0 +1,117 @@
+/**
+ * @file    FieldSetup.hh
+ * @author  Mohammadreza Zakeri
+ * @date    2026-10-18
+ *
+ * @brief   Equation of motion, stepper and field managers for the DC
+ *          electric field of the geometry JSON (`field` block).
+ *
+ * ────────────────────────────────────────────────────────────────────────────
+ *  Layout
+ *  ────────────────────────────────────────────────────────────────────────────
+ *    RevolvedG4Field ─┬─ G4EqMagElectricField (8 variables, time included)
+ *    (or TiledG4Field)│
+ *                     │
+ *     shell manager ──┤  own stepper + driver + chord finder,
+ *                     │  attached to the three shell LVs and the cone LV
+ *     open  manager ──┘  the global field manager (envelope and world),
+ *                        configured only with `open_space`
+ *
+ *  Each manager gets its own FieldTuning (delta chord, delta one step,
+ *  delta intersection, ε_min / ε_max), so the vacuum between panels can use
+ *  coarse chords while the shells stay accurate.
+ *
+ * ────────────────────────────────────────────────────────────────────────────
+ *  Steppers (FieldSpec::stepper)
+ *  ────────────────────────────────────────────────────────────────────────────
+ *    ClassicalRK4, CashKarpRKF45, BogackiShampine23, BogackiShampine45,
+ *    DormandPrince745 (default), DormandPrinceRK56, TsitourasRK45.
+ *  A "Cached" prefix (e.g. CachedDormandPrince745) routes the lookups
+ *  through a last-point cache: a query within `cache_distance_nm` of the
+ *  previous evaluation returns the previous value.  This is the electric
+ *  analogue of G4CachedMagneticField.  It trades accuracy for speed when
+ *  the map lookup dominates.
+ *
+ *  Thread-local: build one per worker in
+ *  DetectorConstruction::ConstructSDandField().
+ */
+
+#ifndef FIELD_SETUP_HH
+#define FIELD_SETUP_HH
+
+/*─────────────────────────── Geant4 core ───────────────────────────────*/
+#include "globals.hh"
+
+/*──────────────────────────── std / proj ───────────────────────────────*/
+#include <memory>
+#include <vector>
+#include "GeometryConfig.hh"
+
+class G4ChordFinder;
+class G4ElectroMagneticField;
+class G4EqMagElectricField;
+class G4FieldManager;
+class G4MagIntegratorStepper;
+class AxisymmetricField;
+class ConeLatticeField;
+class TiledFieldMap;
+
+/**
+ * @class FieldSetup
+ * @brief Owns the field, its equation, the shell field manager and the
+ *        steppers / chord finders (with their drivers) of one thread.
+ */
+class FieldSetup
+{
+  public:
+    /**
+     * @param spec  `field` block of the geometry JSON (must be Active()).
+     * @param map   Loaded map (mesh or resampled grid), shared read-only
+     *              by all threads.
+     * @param lattice  Superposition of `map` over the cones (`field.lattice`);
+     *                 replaces the single revolved map when given.
+     */
+    FieldSetup(const geom::FieldSpec& spec,
+               std::shared_ptr<const AxisymmetricField> map,
+               std::shared_ptr<const ConeLatticeField> lattice = nullptr);
+
+    /**
+     * @param spec  `field` block of the geometry JSON (with `grid3d`).
+     * @param grid  Mapped 3-D grid, shared read-only by all threads.
+     */
+    FieldSetup(const geom::FieldSpec& spec,
+               std::shared_ptr<const TiledFieldMap> grid);
+    ~FieldSetup();
+
+    /** @return manager for the shell and cone LVs. */
+    G4FieldManager* ShellManager() const { return shellMgr_; }
+
+    /** @brief Put the field on the global manager (open space). */
+    void ConfigureGlobal();
+
+    /**
+     * @return a new stepper for `eq`.
+     * @note   Unknown names are a FatalException.
+     */
+    static G4MagIntegratorStepper* MakeStepper(const G4String& name,
+                                               G4EqMagElectricField* eq);
+
+  private:
+    /** @brief Validate the tuning, wrap `mapField_`, build the shell manager. */
+    void Init();
+    /** @brief Chord finder + accuracy parameters of `mgr`. */
+    void Configure(G4FieldManager* mgr, const geom::FieldTuning& t);
+
+    geom::FieldSpec          spec_;
+    G4ElectroMagneticField*  field_    {nullptr};  ///< map field, maybe behind the cache
+    G4ElectroMagneticField*  mapField_ {nullptr};  ///< RevolvedG4Field or TiledG4Field
+    G4EqMagElectricField*    equation_ {nullptr};
+    G4FieldManager*          shellMgr_ {nullptr};
+
+    /// One per Configure().  G4FieldManager::SetChordFinder() takes no
+    /// ownership; a chord finder deletes its driver, a driver not its stepper
+    std::vector<std::unique_ptr<G4MagIntegratorStepper>> steppers_;
+    std::vector<std::unique_ptr<G4ChordFinder>>          chords_;
+};
+
+#endif /* FIELD_SETUP_HH */
@@ -0,0 +1,77 @@
+/**
+ * @file    FreeFlightModel.hh
+ * @author  Mohammadreza Zakeri
+ * @date    2026-10-18
+ *
+ * @brief   Fast-simulation model that carries a mu-α across the vacuum
+ *          between shell columns in a single step.
+ *
+ * ────────────────────────────────────────────────────────────────────────────
+ *  Why
+ *  ────────────────────────────────────────────────────────────────────────────
+ *  Outside every shell column a mu-α only flies through vacuum, yet each
+ *  step there still goes through the navigator and the voxels of a world
+ *  that holds four volumes per cone.  DetectorConstruction places all
+ *  panels in one envelope box with its own G4Region; this model is attached
+ *  to that region.
+ *
+ * ────────────────────────────────────────────────────────────────────────────
+ *  How
+ *  ────────────────────────────────────────────────────────────────────────────
+ *  ModelTrigger() fires only while the track is in the envelope volume
+ *  itself, i.e. not inside a shell or a cone.  It finds the first column
+ *  the straight line enters (ColumnGrid with zero margin, i.e. the exact
+ *  outer-shell cylinders) and the distance to the envelope's own surface,
+ *  and keeps the nearer one.  DoIt() moves the track there.  The position,
+ *  global time and proper time follow exactly from the constant velocity.
+ *  The kinetic energy and direction are unchanged, and nothing is deposited.
+ *  Inside the shells Geant4 tracks as before, so SteppingAction sees the
+ *  same segment end points as without the model.
+ *
+ *  The model steps aside, and lets Geant4 take the step, when:
+ *    - the track sits on a column or envelope surface (jump < tolerance);
+ *    - a field acts in the envelope, i.e. its own field manager, or else
+ *      the global one, carries a field.  This is checked once per thread,
+ *      at the first trigger.  Fields confined to the shells leave the
+ *      model on.
+ *  `--no-free-flight` does not attach the model at all.
+ */
+
+#ifndef FREE_FLIGHT_MODEL_HH
+#define FREE_FLIGHT_MODEL_HH
+
+/*─────────────────────────── Geant4 core ───────────────────────────────*/
+#include "G4VFastSimulationModel.hh"
+
+/*──────────────────────────── std / proj ───────────────────────────────*/
+#include <vector>
+#include "ColumnGrid.hh"
+#include "GeometryConfig.hh"
+
+/**
+ * @class FreeFlightModel
+ * @brief Straight-line transport of mu-α through the panel envelope.
+ *
+ * Thread-local: create it in DetectorConstruction::ConstructSDandField().
+ */
+class FreeFlightModel : public G4VFastSimulationModel
+{
+  public:
+    FreeFlightModel(const G4String& name, G4Region* envelope,
+                    const geom::GeometryConfig& cfg);
+
+    G4bool IsApplicable(const G4ParticleDefinition& particle) override;
+    G4bool ModelTrigger(const G4FastTrack& fastTrack) override;
+    void   DoIt(const G4FastTrack& fastTrack, G4FastStep& fastStep) override;
+
+  private:
+    /** @return `true` if a field acts in the envelope volume. */
+    static bool FieldInEnvelope(const G4FastTrack& fastTrack);
+
+    geom::ColumnGrid                        grid_;
+    std::vector<geom::ColumnGrid::Crossing> xs_;           ///< scratch
+    G4double                                flight_ {0};   ///< set by ModelTrigger
+    int                                     enabled_ {-1}; ///< -1: not yet checked
+};
+
+#endif /* FREE_FLIGHT_MODEL_HH */
@@ -39,6 +39,7 @@
 /*────────────────────────────── stdlib ───────────────────────────────────*/
 #include <cstddef>          // std::size_t
 #include <ostream>
+#include <string>
 #include <vector>
 
 /*──────────────────────────── third-party ───────────────────────────────*/
@@ -95,6 +96,181 @@ struct PanelSpec {
     constexpr std::size_t nCones() const noexcept { return nx * ny; }
 };
 
+/**
+ * @struct ImportanceSpec
+ * @brief Geometric importances of the volumes a mu-α crosses.
+ *
+ * As in Geant4's geometric biasing, a track crossing from importance I to
+ * I' is split into I'/I copies of weight w·I/I' (I' > I) or plays Russian
+ * roulette, surviving with probability I'/I at weight w·I/I' (I' < I).
+ * Importances growing inwards thus split tracks that approach a cone and
+ * thin out those that leave it.  All 1 (the default) switches this off.
+ */
+struct ImportanceSpec {
+    double world  {1.0};         ///< Everything outside the shells
+    double outer  {1.0};         ///< Outer  shell
+    double middle {1.0};         ///< Middle shell
+    double inner  {1.0};         ///< Inner  shell (and the cone itself)
+
+    /** @return `true` if any importance differs from 1. */
+    constexpr bool Active() const noexcept
+    {
+        return world != 1.0 || outer != 1.0 || middle != 1.0 || inner != 1.0;
+    }
+};
+
+/**
+ * @struct FieldTuning
+ * @brief Accuracy parameters of one G4FieldManager (FieldSetup.hh).
+ */
+struct FieldTuning {
+    double delta_chord_nm        {0.1};   ///< Max. sagitta of a chord segment [nm]
+    double delta_one_step_nm     {0.01};  ///< Position accuracy of one step [nm]
+    double delta_intersection_nm {0.001}; ///< Boundary-intersection accuracy [nm]
+    double eps_min               {1e-5};  ///< Lower bound of the relative accuracy
+    double eps_max               {1e-4};  ///< Upper bound of the relative accuracy
+};
+
+/**
+ * @struct FieldResample
+ * @brief Optional resampling of the field map onto regular (r, z) grids
+ *        (ResampledField.hh).
+ *
+ * A coarse grid covers the whole mesh; a finer one covers the tip box
+ * 0 ≤ r ≤ tip_r_max_nm, tip_z_min_nm ≤ z ≤ tip_z_max_nm.  Lengths are in
+ * nm in the map's own (r, z) frame, i.e. relative to `origin_nm`.  The
+ * grids are cached in `cache_dir` under the hash of the .pos file.
+ */
+struct FieldResample {
+    double      cell_nm      {0.0};          ///< Coarse spacing; 0 → no resampling
+    double      tip_cell_nm  {0.0};          ///< Tip spacing; 0 → no tip grid
+    double      tip_r_max_nm {0.0};          ///< Tip box, radial extent
+    double      tip_z_min_nm {0.0};          ///< Tip box, lower z
+    double      tip_z_max_nm {0.0};          ///< Tip box, upper z
+    std::string interpolation {"bilinear"};  ///< "bilinear" or "bicubic"
+    std::string cache_dir {"field_cache"};   ///< Where the .fgrid files live
+
+    /** @return `true` if the map is to be resampled. */
+    bool Active() const noexcept { return cell_nm > 0.0; }
+    /** @return `true` if a refined tip grid is requested. */
+    bool Tip() const noexcept
+    {
+        return tip_cell_nm > 0.0 && tip_r_max_nm > 0.0 && tip_z_max_nm > tip_z_min_nm;
+    }
+};
+
+/**
+ * @struct FieldLattice
+ * @brief Optional superposition of one copy of the map per cone
+ *        (ConeLatticeField.hh).
+ *
+ * With this block, `origin_nm` is the map's (r, z) = 0 relative to each
+ * cone's base centre rather than a global position.  A point then feels
+ *   E = E_bg ẑ + Σ_k [E_map(local_k) − E_bg ẑ]
+ * over at most `k_nearest` cones whose axes lie within the cutoff.
+ * `background_ez` is the uniform applied field E_bg in the map's field
+ * units, which the map already contains once.  `cutoff_nm` = 0 derives
+ * the cutoff from the map: it is the smallest axis distance beyond which
+ * one cone's perturbation stays below `tolerance` × its peak.
+ */
+struct FieldLattice {
+    int    k_nearest     {0};     ///< Cones summed per point; 0 → single map
+    double cutoff_nm     {0.0};   ///< Axis distance cutoff; 0 → from `tolerance`
+    double tolerance     {1e-3};  ///< Neglected perturbation / peak, per cone
+    double background_ez {0.0};   ///< Applied uniform Ez [map field units]
+
+    /** @return `true` if the cones' fields are to be superposed. */
+    bool Active() const noexcept { return k_nearest > 0; }
+};
+
+/**
+ * @struct FieldGrid3D
+ * @brief Optional 3-D (x, y, z) field map (TiledFieldMap.hh) used instead
+ *        of the revolved one, e.g. when staggered panels break the
+ *        axisymmetry.
+ *
+ * `file` is a tiled grid written by makeFieldGrid3D.  Its coordinates are
+ * in `pos_unit_m` relative to `origin_nm`, its values in `e_unit_V_per_m`.
+ * Tiles are paged in on demand; at most about `resident_mb` of them stay
+ * mapped per process (0 → no bound).
+ */
+struct FieldGrid3D {
+    std::string file;                 ///< .f3d grid; empty → no 3-D map
+    double      resident_mb {512.0};  ///< Resident-tile budget [MiB]
+
+    /** @return `true` if the 3-D map replaces the revolved one. */
+    bool Active() const noexcept { return !file.empty(); }
+};
+
+/**
+ * @struct FieldSolve
+ * @brief Optional built-in electrostatic solve (AxisymmetricSolver.hh) that
+ *        replaces the Gmsh map.
+ *
+ * One cone stands on a base plane at z = 0, both at `v_cone_V`.  An anode
+ * plane at z = h_cone + gap is at `v_anode_V`.  ∂φ/∂r = 0 holds at
+ * r = `r_max_nm` (default `r_outer_nm`), i.e. the cone sits in a periodic
+ * cell.  Laplace's equation is solved by multigrid on a uniform (r, z)
+ * grid of spacing ≤ `cell_nm`.  The map's (r, z) = 0 is the cone's base
+ * centre.  Results are cached in `cache_dir` under the hash of the cone,
+ * the gap and this block.
+ */
+struct FieldSolve {
+    double      cell_nm    {0.0};          ///< Grid spacing; 0 → no solve
+    double      v_cone_V   {0.0};          ///< Cone and base plane [V]
+    double      v_anode_V  {100.0};        ///< Anode plane [V]
+    double      r_max_nm   {0.0};          ///< Outer radius; 0 → r_outer_nm
+    double      tolerance  {1e-8};         ///< Residual reduction to reach
+    int         max_cycles {100};          ///< V-cycle limit
+    std::string interpolation {"bilinear"};///< "bilinear" or "bicubic"
+    std::string cache_dir {"field_cache"}; ///< Where the .fgrid files live
+
+    /** @return `true` if the field is to be solved for. */
+    bool Active() const noexcept { return cell_nm > 0.0; }
+};
+
+/**
+ * @struct FieldSpec
+ * @brief Optional DC electric field: an axisymmetric Gmsh map
+ *        (RevolvedFieldFromPOS) revolved about a z-parallel axis.
+ *
+ * The shells and cones get one field manager (`shell`), the panel
+ * envelope and the world another (`open`), so the vacuum between the
+ * panels can use coarser chords or, with `open_space = false`, no field
+ * at all.  No `pos_file`, `solve` or `grid3d` (the default) means no
+ * field.  `grid3d` takes precedence over `solve`, and `solve` over
+ * `pos_file` and its `resample` block.
+ */
+struct FieldSpec {
+    std::string pos_file;                     ///< Gmsh .pos with VT entries (or .msh view)
+    double      pos_unit_m     {1.0};         ///< Length unit of the map [m]
+    double      e_unit_V_per_m {1.0};         ///< Unit of the map's field values [V/m]
+    Vec3        origin_nm;                    ///< Global position of the map's (r, z) = 0
+    std::string stepper {"DormandPrince745"}; ///< Integrator; "Cached" prefix → field cache
+    double      cache_distance_nm {0.1};      ///< Re-use radius of the "Cached…" steppers
+    double      min_step_nm  {0.01};          ///< Smallest step of the integration driver
+    bool        open_space   {true};          ///< Field outside the shells as well
+    FieldTuning shell;                        ///< Shells and cones
+    FieldTuning open {1.0, 0.1, 0.01, 1e-5, 1e-3}; ///< Envelope and world
+    FieldResample resample;                   ///< Regular-grid copy of the map
+    FieldLattice  lattice;                    ///< One map per cone, superposed
+    FieldGrid3D   grid3d;                     ///< 3-D map instead of the revolved one
+    FieldSolve    solve;                      ///< Solved map instead of `pos_file`
+
+    /** @return `true` if a field map is configured. */
+    bool Active() const noexcept
+    {
+        return !pos_file.empty() || grid3d.Active() || solve.Active();
+    }
+    /** @return `true` if the revolved map is solved for, not read. */
+    bool Solved() const noexcept { return solve.Active() && !grid3d.Active(); }
+    /** @return file holding the map in use. */
+    const std::string& MapFile() const noexcept
+    {
+        return grid3d.Active() ? grid3d.file : pos_file;
+    }
+};
+
 /*======================================================================*/
 /* 3.  Top-level geometry container                                     */
 /*======================================================================*/
@@ -114,6 +290,12 @@ struct GeometryConfig
     /*──── Panels (ordered) ─────────────────────────────────────────*/
     std::vector<PanelSpec> panels; ///< Panels 0…N-1 in *insertion* order
 
+    /*──── Variance reduction ───────────────────────────────────────*/
+    ImportanceSpec importance;     ///< Optional JSON block `importance`
+
+    /*──── Electric field ───────────────────────────────────────────*/
+    FieldSpec      field;          ///< Optional JSON block `field`
+
     /*------------------------------------------------------------------*/
     /** @name  Tiny convenience helpers (constexpr / header-only)        */
     /** @{ */
@@ -189,6 +371,27 @@ void from_json(const nlohmann::json& j, ConeSpec& c);
 void to_json(nlohmann::json& j, const PanelSpec& p);
 void from_json(const nlohmann::json& j, PanelSpec& p);
 
+void to_json(nlohmann::json& j, const ImportanceSpec& s);
+void from_json(const nlohmann::json& j, ImportanceSpec& s);
+
+void to_json(nlohmann::json& j, const FieldTuning& t);
+void from_json(const nlohmann::json& j, FieldTuning& t);
+
+void to_json(nlohmann::json& j, const FieldResample& r);
+void from_json(const nlohmann::json& j, FieldResample& r);
+
+void to_json(nlohmann::json& j, const FieldLattice& l);
+void from_json(const nlohmann::json& j, FieldLattice& l);
+
+void to_json(nlohmann::json& j, const FieldGrid3D& g);
+void from_json(const nlohmann::json& j, FieldGrid3D& g);
+
+void to_json(nlohmann::json& j, const FieldSolve& s);
+void from_json(const nlohmann::json& j, FieldSolve& s);
+
+void to_json(nlohmann::json& j, const FieldSpec& f);
+void from_json(const nlohmann::json& j, FieldSpec& f);
+
 void to_json(nlohmann::json& j, const GeometryConfig& g);
 void from_json(const nlohmann::json& j, GeometryConfig& g);
 
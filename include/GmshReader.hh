@@ -0,0 +1,67 @@
+/**
+ * @file    GmshReader.hh
+ * @author  Mohammadreza Zakeri
+ * @date    2026-10-18
+ *
+ * @brief   Readers for the Gmsh exports of the axisymmetric field map
+ *          (no Geant4).
+ *
+ * ────────────────────────────────────────────────────────────────────────────
+ *  .pos  (list-based view, text)
+ *  ────────────────────────────────────────────────────────────────────────────
+ *    VT(x1,y1,z1, x2,y2,z2, x3,y3,z3){Ex1,Ey1,Ez1, Ex2,Ey2,Ez2, Ex3,Ey3,Ez3};
+ *  The file is memory-mapped and cut into one chunk per thread at line
+ *  starts.  Each thread scans its chunk for "VT(" and parses the 18 numbers
+ *  with std::from_chars, with no copies or streams.  An entry belongs to
+ *  the chunk where it starts, so entries spread over several lines are
+ *  still read once.  The chunks are concatenated in file order.
+ *
+ * ────────────────────────────────────────────────────────────────────────────
+ *  .msh  (mesh-based view, MSH 2.2 or 4.1, binary or ASCII)
+ *  ────────────────────────────────────────────────────────────────────────────
+ *  Reads $Nodes and $Elements plus the first 3-component $ElementNodeData
+ *  or $NodeData block (the exported view).  Only triangles are used (type 2,
+ *  and the corner nodes of higher-order triangles).  Other sections are
+ *  skipped.
+ *  Binary files must have the host's byte order, and node and element
+ *  tags are assumed dense (Gmsh's default numbering).
+ *
+ *  Both readers return the triangles in (r, z) = (√(x² + y²), z) with
+ *  (Er, Ez) = (Ex, Ez).  This is the convention of RevolvedFieldFromPOS.
+ */
+
+#ifndef GMSH_READER_HH
+#define GMSH_READER_HH
+
+/*────────────────────────────── stdlib ───────────────────────────────────*/
+#include <string>
+#include <vector>
+
+namespace util {
+
+/// One field-carrying triangle of a Gmsh view, in the (r, z) half-plane.
+struct GmshTriangle {
+    double r[3], z[3];       ///< Vertices
+    double Er[3], Ez[3];     ///< Field at the vertices
+};
+
+/**
+ * @brief  All VT entries of a text .pos file, in file order.
+ * @param  threads  Parser threads; 0 → std::thread::hardware_concurrency().
+ * @throw  std::runtime_error if the file cannot be read or a VT entry is
+ *         malformed (the message gives its byte offset).
+ */
+std::vector<GmshTriangle> ReadPosTriangles(const std::string& path, unsigned threads = 0);
+
+/**
+ * @brief  Triangles of the first vector view of a .msh file.
+ * @throw  std::runtime_error if the file cannot be read, is not MSH 2.x/4.x,
+ *         or holds no 3-component view on triangles.
+ */
+std::vector<GmshTriangle> ReadMshTriangles(const std::string& path);
+
+/** @return `true` if `path` names a .msh file (by its extension). */
+bool IsMshFile(const std::string& path);
+
+} // namespace util
+#endif /* GMSH_READER_HH */
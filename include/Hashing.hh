@@ -0,0 +1,79 @@
+/**
+ * @file    Hashing.hh
+ * @author  Mohammadreza Zakeri
+ * @date    2026-10-18
+ *
+ * @brief   Tiny header-only FNV-1a hashing helpers (no Geant4).
+ *
+ * Used to fingerprint inputs (rate table, canonical run configuration) so
+ * that identical simulations can be recognised across processes and days.
+ * FNV-1a is not cryptographic – it only has to tell *our own* inputs apart.
+ */
+
+#ifndef HASHING_HH
+#define HASHING_HH
+
+/*────────────────────────────── stdlib ───────────────────────────────────*/
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace util {
+
+constexpr std::uint64_t kFnvOffset = 14695981039346656037ULL;  ///< FNV-1a 64 basis
+constexpr std::uint64_t kFnvPrime  = 1099511628211ULL;         ///< FNV-1a 64 prime
+
+/** @brief Feed `n` raw bytes into a running FNV-1a hash. */
+inline std::uint64_t Fnv1a(const void* data, std::size_t n,
+                           std::uint64_t h = kFnvOffset) noexcept
+{
+    const auto* p = static_cast<const unsigned char*>(data);
+    for (std::size_t i = 0; i < n; ++i) { h ^= p[i]; h *= kFnvPrime; }
+    return h;
+}
+
+/** @brief FNV-1a of a string. */
+inline std::uint64_t Fnv1a(std::string_view s, std::uint64_t h = kFnvOffset) noexcept
+{
+    return Fnv1a(s.data(), s.size(), h);
+}
+
+/** @brief FNV-1a of the bit pattern of a double (−0.0 folded onto +0.0). */
+inline std::uint64_t Fnv1a(double x, std::uint64_t h) noexcept
+{
+    if (x == 0.0) x = 0.0;
+    std::uint64_t bits;
+    std::memcpy(&bits, &x, sizeof bits);
+    return Fnv1a(&bits, sizeof bits, h);
+}
+
+/** @return `h` as 16 lower-case hex digits (the form stored in run.json). */
+inline std::string HashHex(std::uint64_t h)
+{
+    static constexpr char digits[] = "0123456789abcdef";
+    std::string s(16, '0');
+    for (int i = 15; i >= 0; --i, h >>= 4) s[i] = digits[h & 0xF];
+    return s;
+}
+
+/**
+ * @brief  FNV-1a of a file's bytes (e.g. a field map named in the geometry).
+ * @throw  std::runtime_error if the file cannot be read.
+ */
+inline std::uint64_t Fnv1aFile(const std::string& path)
+{
+    std::ifstream in(path, std::ios::binary);
+    if (!in) throw std::runtime_error("Fnv1aFile: cannot read " + path);
+    std::uint64_t h = kFnvOffset;
+    char buf[1 << 16];
+    while (in.read(buf, sizeof buf) || in.gcount() > 0)
+        h = Fnv1a(buf, static_cast<std::size_t>(in.gcount()), h);
+    return h;
+}
+
+} // namespace util
+#endif /* HASHING_HH */
@@ -0,0 +1,109 @@
+/**
+ * @file    MappedFile.hh
+ * @author  Mohammadreza Zakeri
+ * @date    2026-10-18
+ *
+ * @brief   Tiny header-only read-only mmap(2) of a whole file (no Geant4).
+ *
+ * Used for inputs too large to copy (Gmsh field maps), for caches that
+ * every process on a host should share (resampled field grids) and for
+ * 3-D maps paged in tile by tile (TiledFieldMap).
+ */
+
+#ifndef MAPPED_FILE_HH
+#define MAPPED_FILE_HH
+
+/*────────────────────────────── stdlib ───────────────────────────────────*/
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+/*────────────────────────────── POSIX ────────────────────────────────────*/
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace util {
+
+class MappedFile
+{
+  public:
+    MappedFile() = default;
+
+    /**
+     * @param path        File to map read-only.
+     * @param sequential  Hint the kernel to read ahead (one pass over it).
+     * @throw std::runtime_error if the file cannot be opened or mapped.
+     */
+    explicit MappedFile(const std::string& path, bool sequential = false)
+    {
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) throw std::runtime_error("cannot open " + path);
+        struct stat st {};
+        if (::fstat(fd, &st) != 0) {
+            ::close(fd);
+            throw std::runtime_error("cannot stat " + path);
+        }
+        size_ = static_cast<std::size_t>(st.st_size);
+        if (size_ > 0) {
+            void* p = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+            if (p == MAP_FAILED) {
+                ::close(fd);
+                throw std::runtime_error("cannot map " + path);
+            }
+            data_ = static_cast<const char*>(p);
+            if (sequential) ::madvise(p, size_, MADV_SEQUENTIAL);
+        }
+        ::close(fd);
+    }
+
+    ~MappedFile() { Unmap(); }
+
+    MappedFile(const MappedFile&)            = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& o) noexcept
+    : data_(std::exchange(o.data_, nullptr)), size_(std::exchange(o.size_, 0)) {}
+    MappedFile& operator=(MappedFile&& o) noexcept
+    {
+        if (this != &o) {
+            Unmap();
+            data_ = std::exchange(o.data_, nullptr);
+            size_ = std::exchange(o.size_, 0);
+        }
+        return *this;
+    }
+
+    const char* Data() const noexcept { return data_; }
+    std::size_t Size() const noexcept { return size_; }
+
+    /**
+     * @brief madvise(2) the bytes [offset, offset + length), widened to
+     *        whole pages.  The mapping is read-only and file-backed, so
+     *        MADV_DONTNEED only drops pages that fault back in on use.
+     */
+    void Advise(std::size_t offset, std::size_t length, int advice) const noexcept
+    {
+        if (!data_ || offset >= size_) return;
+        static const std::size_t page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+        const std::size_t b = offset / page * page;
+        const std::size_t e = std::min(offset + length, size_);
+        ::madvise(const_cast<char*>(data_) + b, e - b, advice);
+    }
+
+  private:
+    void Unmap() noexcept
+    {
+        if (data_) ::munmap(const_cast<char*>(data_), size_);
+        data_ = nullptr;
+        size_ = 0;
+    }
+
+    const char* data_ {nullptr};
+    std::size_t size_ {0};
+};
+
+} // namespace util
+#endif /* MAPPED_FILE_HH */
@@ -0,0 +1,150 @@
+/**
+ * @file    Philox.hh
+ * @author  Mohammadreza Zakeri
+ * @date    2026-10-18
+ *
+ * @brief   Header-only Philox4x32-10 counter-based generator (no Geant4).
+ *
+ * ────────────────────────────────────────────────────────────────────────────
+ *  What it is
+ *  ────────────────────────────────────────────────────────────────────────────
+ *  Philox (Salmon et al., SC'11 – "Random123") is a keyed bijection of a
+ *  128-bit counter: output = Philox(counter, key).  There is no sequential
+ *  state, so draw k of any stream is computed directly (O(1) skip-ahead),
+ *  any event can be regenerated alone, and the numbers cannot depend on
+ *  which thread produced them.  Output matches the Random123 known-answer
+ *  vectors.
+ *
+ *  Layout used by muAlphaSim (see EventRandom.hh):
+ *
+ *      key     = run seed (64 bit)
+ *      counter = { block, global event lo, global event hi, stream id }
+ *
+ *  Each block yields four 32-bit words = two 53-bit doubles, so uniform k
+ *  lives in block k/2.  PhiloxStream generates `kBlocks` blocks at a time
+ *  into a small per-stream buffer (the streams themselves are thread-local).
+ */
+
+#ifndef PHILOX_HH
+#define PHILOX_HH
+
+/*────────────────────────────── stdlib ───────────────────────────────────*/
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace rng {
+
+/*======================================================================*/
+/*  1.  The bijection                                                   */
+/*======================================================================*/
+using Ctr4x32 = std::array<std::uint32_t, 4>;
+using Key2x32 = std::array<std::uint32_t, 2>;
+
+/** @brief Philox4x32 with 10 rounds (the Random123 default). */
+constexpr Ctr4x32 Philox4x32_10(Ctr4x32 c, Key2x32 k) noexcept
+{
+    constexpr std::uint32_t M0 = 0xD2511F53u, M1 = 0xCD9E8D57u;
+    constexpr std::uint32_t W0 = 0x9E3779B9u, W1 = 0xBB67AE85u;
+
+    for (int r = 0; r < 10; ++r)
+    {
+        const std::uint64_t p0 = static_cast<std::uint64_t>(M0) * c[0];
+        const std::uint64_t p1 = static_cast<std::uint64_t>(M1) * c[2];
+        c = { static_cast<std::uint32_t>(p1 >> 32) ^ c[1] ^ k[0],
+              static_cast<std::uint32_t>(p1),
+              static_cast<std::uint32_t>(p0 >> 32) ^ c[3] ^ k[1],
+              static_cast<std::uint32_t>(p0) };
+        k[0] += W0;
+        k[1] += W1;
+    }
+    return c;
+}
+
+/** @brief Two 32-bit words → uniform double strictly inside (0, 1). */
+constexpr double ToUniform(std::uint32_t hi, std::uint32_t lo) noexcept
+{
+    const std::uint64_t bits = (static_cast<std::uint64_t>(hi) << 21) ^ (lo >> 11);
+    return (static_cast<double>(bits & ((1ULL << 53) - 1)) + 0.5) * 0x1.0p-53;
+}
+
+/*======================================================================*/
+/*  2.  A buffered stream                                               */
+/*======================================================================*/
+
+/**
+ * @class PhiloxStream
+ * @brief Uniforms of one (seed, event, stream) triple, generated in bulk.
+ */
+class PhiloxStream
+{
+  public:
+    static constexpr std::size_t kBlocks = 8;               ///< blocks per refill
+    static constexpr std::size_t kBuffer = 2 * kBlocks;     ///< doubles per refill
+
+    PhiloxStream() = default;
+    PhiloxStream(std::uint64_t seed, std::uint64_t event, std::uint32_t stream) noexcept
+    : key_{static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32)}
+    , event_{event}
+    , stream_{stream}
+    {}
+
+    /** @return next uniform in (0, 1). */
+    double Uniform() noexcept
+    {
+        if (pos_ == kBuffer) Refill();
+        ++drawn_;
+        return buf_[pos_++];
+    }
+
+    /** @brief O(1) skip-ahead: the next Uniform() returns draw `k`. */
+    void Seek(std::uint64_t k) noexcept
+    {
+        base_  = (k / kBuffer) * kBlocks;
+        Refill();
+        pos_   = static_cast<std::size_t>(k % kBuffer);
+        drawn_ = k;
+    }
+
+    /** @return draw `k` without touching the stream position. */
+    double At(std::uint64_t k) const noexcept
+    {
+        const Ctr4x32 r = Philox4x32_10(Ctr(k / 2), key_);
+        return (k & 1) ? ToUniform(r[2], r[3]) : ToUniform(r[0], r[1]);
+    }
+
+    /** @return number of draws taken so far. */
+    std::uint64_t Counter() const noexcept { return drawn_; }
+
+  private:
+    Ctr4x32 Ctr(std::uint64_t block) const noexcept
+    {
+        return { static_cast<std::uint32_t>(block),
+                 static_cast<std::uint32_t>(event_),
+                 static_cast<std::uint32_t>(event_ >> 32),
+                 stream_ ^ (static_cast<std::uint32_t>(block >> 32) << 16) };
+    }
+
+    void Refill() noexcept
+    {
+        for (std::size_t b = 0; b < kBlocks; ++b)
+        {
+            const Ctr4x32 r = Philox4x32_10(Ctr(base_ + b), key_);
+            buf_[2 * b]     = ToUniform(r[0], r[1]);
+            buf_[2 * b + 1] = ToUniform(r[2], r[3]);
+        }
+        base_ += kBlocks;
+        pos_   = 0;
+    }
+
+    Key2x32       key_    {0, 0};
+    std::uint64_t event_  {0};
+    std::uint32_t stream_ {0};
+    std::uint64_t base_   {0};        ///< next block to generate
+    std::uint64_t drawn_  {0};
+    std::size_t   pos_    {kBuffer};  ///< empty → refill on first draw
+    std::array<double, kBuffer> buf_ {};
+};
+
+} // namespace rng
+#endif /* PHILOX_HH */
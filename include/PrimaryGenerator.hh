@@ -8,16 +8,36 @@
 #include "G4VUserPrimaryGeneratorAction.hh"
 #include "G4ParticleGun.hh"
 
+#include <memory>
+
+#include "BeamBias.hh"
+#include "GeometryConfig.hh"
+#include "RunConfig.hh"
+#include "Sobol.hh"
+
 /**
  * @class PrimaryGenerator
  * @brief Custom primary generator class to shoot a single muAlpha5p particle per event.
  *
  * Uses G4ParticleGun to initialize the particle's position, direction, and energy.
+ *
+ * Before drawing anything, each event re-seeds the thread-local engine from
+ * (run seed, global event ID) – see RunConfig.hh – so that results do not
+ * depend on thread scheduling or on how the job is sharded.
+ *
+ * With `--sampler=sobol` the four beam coordinates (r, φ, θ, ψ) are instead
+ * taken from a scrambled Sobol point addressed by the global event ID
+ * (Sobol.hh).
+ *
+ * With `--bias=f` a share f of the start points is drawn from the beam spot
+ * restricted to the shell columns (BeamBias.hh); the exact likelihood ratio
+ * is stored as the primary-vertex weight.
  */
 class PrimaryGenerator : public G4VUserPrimaryGeneratorAction {
 public:
     /// Constructor
-    PrimaryGenerator();
+    explicit PrimaryGenerator(const sim::RunConfig&       runCfg = {},
+                              const geom::GeometryConfig& cfg    = {});
 
     /// Destructor
     ~PrimaryGenerator() override;
@@ -30,4 +50,7 @@ public:
 
 private:
     G4ParticleGun* fParticleGun; ///< Particle gun instance used for emission
+    sim::RunConfig fRunCfg;      ///< Seed, first global event ID, beam
+    rng::SobolSampler fSobol;    ///< Beam QMC points (Sobol sampler only)
+    std::unique_ptr<sim::FocusedBeam> fFocus; ///< Biased source (`--bias` only)
 };
\ No newline at end of file
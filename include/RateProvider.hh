@@ -0,0 +1,161 @@
+/**
+ * @file    RateProvider.hh
+ * @author  Mohammadreza Zakeri
+ * @date    2026-10-18
+ *
+ * @brief   Where SteppingAction takes the tunnelling rate w(ρ, z) from: the
+ *          tabulated tunnelling_rate.tsv, or ADK evaluated from the local
+ *          field of the map (no Geant4).
+ *
+ * ────────────────────────────────────────────────────────────────────────────
+ *  Providers
+ *  ────────────────────────────────────────────────────────────────────────────
+ *  Both answer in the cone-local frame of RateTable2D (ρ from the axis,
+ *  z from the base centre, metres) and return w [s⁻¹], 0 outside their
+ *  domain.  Points come in batches (one shell crossing at a time), see
+ *  CrossingProbability().
+ *
+ *    TableRate  RateTable2D as loaded (RateTableSingleton.hh).  Its domain
+ *               is the table's bounding box.
+ *    FieldRate  |E| from the single-cone map, then AdkRate.  Its domain is
+ *               the map's bounds.  Like the table, it sees one cone's map
+ *               about that cone's axis, not the `lattice` superposition.
+ *               The map's z = 0 is the cone base, shifted by `origin_nm.z`
+ *               when `field.lattice` places the map relative to each cone.
+ *
+ * ────────────────────────────────────────────────────────────────────────────
+ *  Memo (FieldRate)
+ *  ────────────────────────────────────────────────────────────────────────────
+ *  Tracks revisit the same field strengths, and ADK costs an exp per
+ *  state.  |E| is therefore binned by its binary exponent and leading
+ *  mantissa bits (a shift, no log).  The bins have a relative width
+ *  ≤ memo_rel, and the rate is evaluated at the bin's centre.  A result
+ *  thus depends only on |E|, not on what the cache held.  Each thread
+ *  keeps the rates of recent bins in a small direct-mapped table.  The
+ *  misses of a batch are evaluated together by AdkRate::Evaluate().
+ *  memo_rel = 0 evaluates every |E| exactly.
+ */
+
+#ifndef RATE_PROVIDER_HH
+#define RATE_PROVIDER_HH
+
+/*────────────────────────────── stdlib ───────────────────────────────────*/
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+/*──────────────────────────── project ────────────────────────────────────*/
+#include "AdkRateTable.hh"
+#include "AxisymmetricField.hh"
+#include "GeometryConfig.hh"
+#include "RateTable2D.hh"
+
+/**
+ * @class RateProvider
+ * @brief w(ρ, z) at batches of cone-local points; thread-safe.
+ */
+class RateProvider
+{
+  public:
+    virtual ~RateProvider() = default;
+
+    /** @brief w[i] [s⁻¹] at (rho[i], z[i]) [m] for i < n; 0 outside the domain. */
+    virtual void Rates(std::size_t n, const double* rho, const double* z,
+                       double* w) const = 0;
+
+    /** @return fingerprint of the rates, part of the run cache key. */
+    virtual std::uint64_t Checksum() const = 0;
+
+    /** @return w [s⁻¹] at one point. */
+    double Rate(double rho, double z) const
+    {
+        double w;
+        Rates(1, &rho, &z, &w);
+        return w;
+    }
+};
+
+/**
+ * @class TableRate
+ * @brief RateProvider over a loaded RateTable2D (not owned).
+ */
+class TableRate final : public RateProvider
+{
+  public:
+    explicit TableRate(const RateTable2D& table) : table_{table} {}
+
+    void Rates(std::size_t n, const double* rho, const double* z,
+               double* w) const override;
+    std::uint64_t Checksum() const override { return table_.Checksum(); }
+
+  private:
+    const RateTable2D& table_;
+};
+
+/**
+ * @class FieldRate
+ * @brief AdkRate of |E| from a single-cone map, memoised per thread.
+ */
+class FieldRate final : public RateProvider
+{
+  public:
+    /**
+     * @param map    Single-cone map in `field`'s units (shared, read-only).
+     * @param field  Geometry `field` block (units, origin_nm, lattice).
+     * @throw std::invalid_argument on a bad spec or no map.
+     */
+    FieldRate(std::shared_ptr<const AxisymmetricField> map,
+              const geom::FieldSpec& field, const AdkRate::Spec& spec);
+
+    void Rates(std::size_t n, const double* rho, const double* z,
+               double* w) const override;
+    std::uint64_t Checksum() const override { return hash_; }
+
+  private:
+    std::shared_ptr<const AxisymmetricField> map_;
+    AdkRate       rate_;
+    double        scale_;                     ///< m → map length units
+    double        eUnit_;                     ///< map field units → V/m
+    double        z0_;                        ///< Cone-local z of the map's z = 0 [m]
+    double        r1_, zLo_, zHi_;            ///< Map bounds [map units]
+    int           bits_ {0};                  ///< Mantissa bits of a memo bin; 0 → no memo
+    std::uint64_t hash_;
+    std::uint64_t id_;                        ///< Tags this provider's memo entries
+};
+
+/**
+ * @brief  Probability of at least one ionisation on a straight segment.
+ *
+ * Midpoint rule with `n` samples of w(rho, z) between the cone-local
+ * endpoints `p0` → `p1` (metres, relative to the cone's base centre,
+ * z along the cone axis); samples outside the provider's domain
+ * contribute zero:
+ *
+ *     P = 1 − exp( −Σ w(midpoint_i) · dt / n ).
+ *
+ * Shared by SteppingAction and the ballistic engine so that both score a
+ * shell crossing identically.  `dt` is the crossing time in the unit the
+ * rates are multiplied by (both callers pass Geant4 time units).
+ */
+double CrossingProbability(const RateProvider& rates,
+                           const double p0[3], const double p1[3],
+                           double dt, int n = 20);
+
+/**
+ * @brief The provider selected by `--rates`: empty `adkSpec` → TableRate
+ *        over RateTable(), else FieldRate with the spec in that file.
+ * @throw std::runtime_error / std::invalid_argument as AdkRate::Spec::Load()
+ *        and FieldRate.
+ */
+std::unique_ptr<const RateProvider>
+MakeRateProvider(const std::string& adkSpec, std::shared_ptr<const AxisymmetricField> map,
+                 const geom::FieldSpec& field);
+
+/**
+ * @return Checksum() of the provider MakeRateProvider() would return,
+ *         without the map (the map enters the cache key on its own).
+ */
+std::uint64_t RateChecksum(const std::string& adkSpec);
+
+#endif /* RATE_PROVIDER_HH */
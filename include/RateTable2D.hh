@@ -8,6 +8,10 @@
  * |  ρ [m]  |  z [m]  |  w(ρ,z) [s⁻¹]  |
  * |--------:|-------:|----------------:|
  *
+ * or the binary form of a regular grid written by AdkRateTable (a
+ * RateGridHeader followed by the rates, ρ-major), recognised by its magic.
+ * Both forms of the same grid load the same points and the same Checksum().
+ *
  * Unlike regular grids, the input is allowed to be sparse or masked (e.g., due to
  * physical constraints or geometry truncations such as cone removal). This class
  * provides nearest-neighbor and bilinear interpolation if surrounding points are
@@ -29,11 +33,25 @@
 #ifndef RATE_TABLE_2D_HH
 #define RATE_TABLE_2D_HH
 
+#include <cstdint>
 #include <vector>
 #include <string>
 #include <tuple>
 #include <stdexcept>
 
+/**
+ * @struct RateGridHeader
+ * @brief  Header of the binary rate table; nRho × nZ doubles w [s⁻¹]
+ *         follow, point (i, j) at index i·nZ + j (the TSV row order).
+ */
+struct RateGridHeader
+{
+    char          magic[8];     //!< "MARATE01"
+    std::uint32_t nRho, nZ;     //!< Nodes per axis
+    double        rho0, z0;     //!< First node [m]
+    double        hRho, hZ;     //!< Spacing    [m]
+};
+
 /**
  * @class  RateTable2D
  * @brief  Stores unstructured (rho, z, w) data and performs interpolation.
@@ -44,8 +62,8 @@ class RateTable2D
     /**
      * @brief Constructor – loads data from file.
      *
-     * @param filename  Path to the data file.
-     * @param delim     Delimiter character (default = tab).
+     * @param filename  Path to the data file (text or binary).
+     * @param delim     Delimiter character of the text form (default = tab).
      *
      * @throw std::runtime_error on file errors or parsing failure.
      */
@@ -70,6 +88,17 @@ class RateTable2D
     /// Number of data points loaded (not a grid, unstructured).
     std::size_t Size() const { return mPoints.size(); }
 
+    /// True if the points fill a rectangular grid (Interp() then bisects).
+    bool IsGrid() const { return !mGrid.empty(); }
+
+    /**
+     * @brief FNV-1a fingerprint of the loaded (rho, z, w) values.
+     *
+     * Computed from the parsed numbers, so reformatting the file does not
+     * change it; any edit of a value does.  Part of the run cache key.
+     */
+    std::uint64_t Checksum() const { return mChecksum; }
+
     // Getter for the bounding box of the data
     /**
      * @brief Gets the bounding box of the data.
@@ -93,6 +122,20 @@ class RateTable2D
     };
 
     std::vector<RatePoint> mPoints;  //!< Full unstructured list of (rho, z, rate) entries
+    std::uint64_t          mChecksum {0};  //!< See Checksum()
+
+    /* Derived once in the ctor; the table never changes afterwards. */
+    double mMinRho {0}, mMaxRho {0}, mMinZ {0}, mMaxZ {0};  //!< Bounding box
+    std::vector<double> mRhoSorted, mZSorted;  //!< All rho / z values, ascending
+
+    /* When every (rho_i, z_j) pair occurs exactly once (e.g. AdkRateTable
+       output) the rates are also kept dense, so Interp() finds the cell by
+       bisection instead of scanning all points. */
+    std::vector<double> mRhoNodes, mZNodes;  //!< Distinct rho / z values, ascending
+    std::vector<double> mGrid;               //!< Rate of node (i, j) at i·nZ + j; empty if no grid
+
+    /// Interp() on a full grid: same cells and weights, O(log n).
+    double GridInterp(double rho, double z) const;
 
     /**
      * @brief Finds the 4 nearest neighbors for bilinear interpolation.
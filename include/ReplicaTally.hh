@@ -0,0 +1,49 @@
+/**
+ * @file    ReplicaTally.hh
+ * @author  Mohammadreza Zakeri
+ * @date    2026-10-18
+ *
+ * @brief   Per-replica event / ionisation / capture counts as a mergeable
+ *          accumulable (`--sampler=sobol`; also per stratum for `--strata`).
+ *
+ * Event g is counted in replica `g mod R` (Sobol.hh), or in its beam
+ * stratum (Strata.hh) under a second instance named "StratumTally".  Merging is an
+ * element-wise sum; the master turns the merged counts into the replica
+ * estimate and error written to the `qmc` block of `run.json`.
+ */
+
+#pragma once
+
+/*─────────────────────────── Geant4 core ───────────────────────────────*/
+#include "G4VAccumulable.hh"
+
+/*──────────────────────────── project ──────────────────────────────────*/
+#include "RunStats.hh"   // util::ReplicaCounts
+
+class ReplicaTally : public G4VAccumulable
+{
+  public:
+    explicit ReplicaTally(std::size_t replicas = 0, const G4String& name = "ReplicaTally")
+    : G4VAccumulable(name), counts_(replicas) {}
+
+    /** @brief Count one event of replica `r` (ignored if out of range). */
+    void Add(std::size_t r, bool ion, bool cap)
+    {
+        if (r >= counts_.Size()) return;
+        ++counts_.n[r];
+        if (ion) ++counts_.ion[r];
+        if (cap) ++counts_.cap[r];
+    }
+
+    void Merge(const G4VAccumulable& other) override
+    {
+        counts_.Add(static_cast<const ReplicaTally&>(other).counts_);
+    }
+
+    void Reset() override { counts_ = util::ReplicaCounts(counts_.Size()); }
+
+    const util::ReplicaCounts& Counts() const noexcept { return counts_; }
+
+  private:
+    util::ReplicaCounts counts_;
+};
@@ -0,0 +1,169 @@
+/**
+ * @file    ResampledField.hh
+ * @author  Mohammadreza Zakeri
+ * @date    2026-10-18
+ *
+ * @brief   The Gmsh field map resampled onto regular (r, z) grids, with a
+ *          memory-mapped binary cache.
+ *
+ * ────────────────────────────────────────────────────────────────────────────
+ *  Grids
+ *  ────────────────────────────────────────────────────────────────────────────
+ *    level 0  coarse grid over the bounding box of the mesh (`cell_nm`)
+ *    level 1  optional fine grid over the tip box (`tip_cell_nm`),
+ *             0 ≤ r ≤ tip_r_max, tip_z_min ≤ z ≤ tip_z_max
+ *
+ *  A lookup uses level 1 inside the tip box and level 0 elsewhere, then
+ *  interpolates bilinearly or bicubically (Catmull–Rom).  Both are O(1),
+ *  against a point location in an unstructured mesh.  On a grid starting
+ *  at r = 0, the bicubic stencil mirrors the column r = −h as (−Er, Ez).
+ *  Queries outside a grid are clamped to its edge.
+ *
+ *  The interpolation error is measured at every triangle centroid of the
+ *  mesh (the mesh's own value there is exact by construction) and kept
+ *  per level: max |ΔE|, rms |ΔE| and the peak mesh |E| for scale.
+ *
+ * ────────────────────────────────────────────────────────────────────────────
+ *  Cache (`cache_dir`/<pos hash>_<grid hash>.fgrid)
+ *  ────────────────────────────────────────────────────────────────────────────
+ *    FileHeader | level 0 nodes | level 1 nodes
+ *  Nodes are (Er, Ez) doubles, row-major in z.  The file is written
+ *  through a temporary and renamed, so concurrent runs never see half a
+ *  grid.  It is opened with mmap(2), so every process on a host shares
+ *  the same pages.  The layout is native-endian: the cache belongs to one
+ *  machine.
+ *
+ *  Offline: tools/resampleField.cc.  On load: DetectorConstruction when
+ *  the geometry's `field.resample` block is present.  AxisymmetricSolver
+ *  hands its solved field over as a single level without error samples.
+ *
+ *  No Geant4.
+ */
+
+#ifndef RESAMPLED_FIELD_HH
+#define RESAMPLED_FIELD_HH
+
+/*────────────────────────────── stdlib ───────────────────────────────────*/
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/*──────────────────────────── project ────────────────────────────────────*/
+#include "AxisymmetricField.hh"
+#include "GeometryConfig.hh"
+#include "MappedFile.hh"
+
+class RevolvedFieldFromPOS;
+
+class ResampledField : public AxisymmetricField
+{
+  public:
+    /// Grid request in map units (see geom::FieldResample, which is in nm).
+    struct Spec {
+        double cell     {0.0};
+        double tipCell  {0.0};        ///< 0 → no tip grid
+        double tipRMax  {0.0};
+        double tipZMin  {0.0};
+        double tipZMax  {0.0};
+        bool   bicubic  {false};
+
+        /** @throw std::invalid_argument on a bad interpolation name or size. */
+        static Spec FromConfig(const geom::FieldSpec& f);
+        /** @return FNV-1a of the request (and the file format version). */
+        std::uint64_t Hash() const;
+    };
+
+    /// Interpolation error of one level against the mesh.
+    struct Error {
+        std::uint64_t samples {0};    ///< Triangle centroids served by the level
+        double        maxAbs  {0.0};  ///< max |ΔE|      [map field units]
+        double        rms     {0.0};  ///< rms |ΔE|      [map field units]
+        double        peak    {0.0};  ///< max mesh |E|  [map field units]
+    };
+
+    /// One regular grid.
+    struct Level {
+        double        r0, z0, hr, hz;
+        std::uint32_t nr, nz;
+        std::uint64_t offset;         ///< First node, in doubles from the data start
+    };
+
+    /**
+     * @brief Resample `mesh` in memory (all hardware threads).
+     * @throw std::invalid_argument if the mesh is empty or a grid too large.
+     */
+    ResampledField(const RevolvedFieldFromPOS& mesh, const Spec& spec);
+
+    /**
+     * @brief Adopt one level of (Er, Ez) nodes built elsewhere
+     *        (AxisymmetricSolver); `L.offset` is ignored.
+     * @throw std::invalid_argument if `nodes` does not match `L`.
+     */
+    ResampledField(const Level& L, std::vector<double> nodes, bool bicubic,
+                   std::uint64_t posHash, std::uint64_t specHash);
+
+    /**
+     * @brief Map a cache file written by Write().
+     * @throw std::runtime_error if it cannot be mapped or is malformed.
+     */
+    explicit ResampledField(const std::string& path);
+
+    ~ResampledField() override;
+    ResampledField(const ResampledField&)            = delete;
+    ResampledField& operator=(const ResampledField&) = delete;
+
+    /**
+     * @brief Resampled grid for `f`, from the cache or built and cached.
+     *
+     * A cache that cannot be written is reported on `log`; the grid built
+     * in memory is returned instead.
+     * @throw std::runtime_error if the .pos file is unreadable or empty.
+     */
+    static std::shared_ptr<const ResampledField>
+    LoadOrBuild(const geom::FieldSpec& f, std::ostream& log, bool rebuild = false);
+
+    /** @return cache file name for `f` (inside f.resample.cache_dir). */
+    static std::string CachePath(const geom::FieldSpec& f);
+
+    /** @brief Write the grids (and their errors) to `path`. */
+    void Write(const std::string& path) const;
+
+    /** @brief Print the grid sizes and the error table. */
+    void Report(std::ostream& os) const;
+
+    void FieldRZ(double r, double z, double& Er, double& Ez) const override;
+    void Bounds(double& r0, double& r1, double& z0, double& z1) const override;
+
+    std::uint32_t Levels() const { return nLevels_; }
+    const Level&  GetLevel(int l) const { return level_[l]; }
+    const Error&  GetError(int l) const { return error_[l]; }
+    std::uint64_t PosHash()  const { return posHash_; }
+    std::uint64_t SpecHash() const { return specHash_; }
+
+  private:
+    /** @return level serving (r, z). */
+    int Pick(double r, double z) const
+    {
+        return nLevels_ > 1 && r <= tipRMax_ && z >= tipZMin_ && z <= tipZMax_;
+    }
+    void Bilinear(const Level& L, const double* d, double r, double z,
+                  double& Er, double& Ez) const;
+    void Bicubic (const Level& L, const double* d, double r, double z,
+                  double& Er, double& Ez) const;
+
+    std::uint32_t nLevels_ {0};
+    Level         level_[2] {};
+    Error         error_[2] {};
+    const double* data_[2]  {nullptr, nullptr};
+    double        tipRMax_ {0}, tipZMin_ {0}, tipZMax_ {0};
+    bool          bicubic_ {false};
+    std::uint64_t posHash_ {0}, specHash_ {0};
+
+    std::vector<double> owned_;               ///< Nodes built in memory
+    util::MappedFile    map_;                 ///< Nodes mapped from a file
+};
+
+#endif /* RESAMPLED_FIELD_HH */
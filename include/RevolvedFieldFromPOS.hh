@@ -4,7 +4,8 @@
 
 #pragma once
 
-#include "G4ThreeVector.hh"
+#include "AxisymmetricField.hh"
+#include <cstdint>
 #include <vector>
 #include <string>
 
@@ -14,44 +15,95 @@
  *        and provides field interpolation at arbitrary 3D positions.
  *
  * This class reads a Gmsh-generated .pos file containing vector triangle (VT)
- * electric field data from a 2D axisymmetric simulation (r-z plane). It stores
- * the values and interpolates the nearest electric field at a given 3D point
- * by assuming azimuthal symmetry and revolving the radial component into the
- * (x, y, z) space used by Geant4.
+ * electric field data from a 2D axisymmetric simulation (r-z plane). It keeps
+ * the triangle mesh (vertices shared between triangles are stored once) and
+ * a uniform (r, z) grid listing the triangles that overlap each cell.  A
+ * lookup finds the triangle containing (r, z) and interpolates the values
+ * written for that triangle barycentrically.  The (Er, Ez) result is then
+ * revolved into the (x, y, z) space used by Geant4.
+ *
+ * Gmsh's binary (or ASCII) .msh export of the same view is accepted too
+ * (chosen by the .msh extension); see GmshReader.hh for both readers.
+ *
+ * Consecutive lookups of one track fall into the same triangle most of the
+ * time, so each thread first re-tests the triangle it hit last.  Points
+ * outside the mesh get the field of the nearest vertex, as before.
+ *
+ * Immutable after construction; Field() may be called from any thread.
  *
  * Example usage:
  *   RevolvedFieldFromPOS field("ElectricField.pos");
- *   G4ThreeVector E = field.GetField(G4ThreeVector(x, y, z));
+ *   double E[3];
+ *   field.Field(x, y, z, E);
  */
-class RevolvedFieldFromPOS {
+class RevolvedFieldFromPOS : public AxisymmetricField {
 public:
     /**
      * @brief Constructor: loads a Gmsh .pos file with VT field data.
-     * @param filename Path to the .pos file containing VT entries.
+     * @param filename Path to the .pos file containing VT entries, or to a
+     *                 .msh file holding the exported view.
      */
     RevolvedFieldFromPOS(const std::string& filename);
 
     /**
-     * @brief Interpolates the electric field at a given 3D position.
-     *        Assumes azimuthal symmetry.
-     * @param pos Position in Cartesian space (x, y, z).
-     * @return Electric field vector (Ex, Ey, Ez) at that point.
+     * @brief Interpolates (Er, Ez) at (r, z): barycentric inside the mesh,
+     *        nearest vertex outside.  Field() revolves the result.
      */
-    G4ThreeVector GetField(const G4ThreeVector& pos) const;
+    void FieldRZ(double r, double z, double& Er, double& Ez) const override;
+
+    /// @return number of distinct vertices loaded (0 if the file was unreadable).
+    std::size_t Size() const { return nodes.size(); }
+
+    /// @return number of triangles loaded.
+    std::size_t Triangles() const { return triangles.size(); }
+
+    /// @brief Bounding box of the vertices in (r, z).
+    void Bounds(double& r0, double& r1, double& z0, double& z1) const override;
+
+    /// @brief Centroid of triangle `i` (a point strictly inside the mesh).
+    void Centroid(std::size_t i, double& r, double& z) const;
 
 private:
-    /// Struct to store one field vector at a node in (r, z) space
-    struct FieldVertex {
-        double r;                ///< Radial position
-        double z;                ///< Z position
-        G4ThreeVector E;         ///< Electric field vector (Er, 0, Ez)
+    /// One distinct mesh vertex in (r, z) space
+    struct Node {
+        double r, z;             ///< Position
+        double Er, Ez;           ///< Field of its first occurrence (outside-mesh fallback)
     };
 
-    std::vector<FieldVertex> fieldPoints; ///< List of sampled VT field points
+    /// One VT triangle, prepared for barycentric tests
+    struct Triangle {
+        std::uint32_t v[3];      ///< Node indices
+        double r0, z0;           ///< Vertex 0
+        double inv[4];           ///< Inverse of [v1 − v0, v2 − v0] (row-major)
+        double Er[3], Ez[3];     ///< Field at the vertices, as written for this triangle
+    };
+
+    std::vector<Node>     nodes;     ///< Distinct vertices, in file order
+    std::vector<Triangle> triangles; ///< Non-degenerate triangles, in file order
+
+    /// Uniform (r, z) grid; cell lists in compressed-row form
+    double rMin {0}, zMin {0}, cell {1};
+    int    nr {0}, nz {0};
+    std::vector<std::uint32_t> triStart, triList;   ///< Triangles overlapping each cell
+    std::vector<std::uint32_t> nodeStart, nodeList; ///< Vertices inside each cell
+
+    std::uint64_t id;        ///< Unique per instance; keys Locate()'s per-thread hint
 
     /**
-     * @brief Parses the Gmsh .pos file (VT format) and loads vector data.
-     * @param filename Path to the .pos file.
+     * @brief Reads the Gmsh .pos (VT format) or .msh file and stores the mesh.
+     * @param filename Path to the .pos or .msh file.
      */
     void LoadPOS(const std::string& filename);
+
+    /// @brief Builds the uniform grid over the loaded mesh.
+    void BuildIndex();
+
+    /// @return barycentric coordinates of (r, z) if it lies in `t`.
+    static bool Inside(const Triangle& t, double r, double z, double lambda[3]);
+
+    /// @return index of the triangle containing (r, z), or -1.
+    long Locate(double r, double z, double lambda[3]) const;
+
+    /// @return index of the vertex nearest to (r, z).
+    std::size_t Nearest(double r, double z) const;
 };
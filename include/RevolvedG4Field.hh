@@ -3,13 +3,18 @@
 #include "G4ElectroMagneticField.hh"
 #include "G4ThreeVector.hh"
 #include "RevolvedFieldFromPOS.hh"
+#include "ConeLatticeField.hh"
+
+#include <memory>
 
 /**
  * @class RevolvedG4Field
  * @brief A Geant4-compatible electromagnetic field that wraps a revolved 2D E-field.
  *
  * This class implements G4ElectroMagneticField and delegates field lookups to
- * a precomputed axisymmetric electric field (loaded via RevolvedFieldFromPOS).
+ * a precomputed axisymmetric electric field (RevolvedFieldFromPOS, or its
+ * regular-grid copy ResampledField), or to the superposition of that map
+ * over the cone lattice (ConeLatticeField).
  * Only the electric field is set (magnetic field is zero).
  */
 class RevolvedG4Field : public G4ElectroMagneticField {
@@ -20,6 +25,25 @@ public:
      */
     explicit RevolvedG4Field(const std::string& filename);
 
+    /**
+     * @brief Constructor from an already loaded map (shared between threads).
+     * @param map        Axisymmetric field map (mesh or resampled grid), read-only.
+     * @param origin     Global position of the map's (r, z) = 0 [Geant4 units].
+     * @param lengthUnit Length unit of the map coordinates [Geant4 units].
+     * @param fieldUnit  Unit of the map field values [Geant4 units].
+     */
+    RevolvedG4Field(std::shared_ptr<const AxisymmetricField> map,
+                    const G4ThreeVector& origin,
+                    G4double lengthUnit, G4double fieldUnit);
+
+    /**
+     * @brief Constructor from the per-cone superposition of a map (shared).
+     * @param lattice    Lattice field, lengths in nm, read-only.
+     * @param fieldUnit  Unit of the map field values [Geant4 units].
+     */
+    RevolvedG4Field(std::shared_ptr<const ConeLatticeField> lattice,
+                    G4double fieldUnit);
+
     /**
      * @brief Override Geant4 field query.
      * @param point Cartesian coordinates of query point (x,y,z,t).
@@ -34,5 +58,9 @@ public:
 	G4bool DoesFieldChangeEnergy() const override { return true; }
 
 private:
-    RevolvedFieldFromPOS fieldMap; ///< Internal field map used for E-field lookup
+    std::shared_ptr<const AxisymmetricField> fieldMap; ///< E-field lookup
+    std::shared_ptr<const ConeLatticeField>  lattice;  ///< Or: one map per cone
+    G4ThreeVector origin     {};    ///< Map origin (global)
+    G4double      lengthUnit {1.0}; ///< Map length unit
+    G4double      fieldUnit  {1.0}; ///< Map field unit
 };
\ No newline at end of file
@@ -15,6 +15,10 @@
  *    (zero locking, zero I/O).  
  *  • In `EndOfRunAction` the master merges accumulables, then asks
  *    `DataLogger` to write `run.json` + footer of `events.tsv`.
+ *  • Sequential stopping (`--target-rel-error`): every `/run/beamOn` is one
+ *    batch.  The master adds each batch's merged tallies to running totals,
+ *    rewrites `run.json` with them and decides whether the estimator is
+ *    precise enough; `main` keeps issuing batches until SequentialDone().
  */
 
 #pragma once
@@ -27,7 +31,12 @@
 /*──────────────────────────── std / project ────────────────────────────*/
 #include <vector>
 #include <string>
+#include "EventOutcomes.hh"
 #include "GeometryConfig.hh"
+#include "ReplicaTally.hh"
+#include "Strata.hh"
+#include "WeightTally.hh"
+#include "RunConfig.hh"
 
 namespace util { class DataLogger; }
 
@@ -38,7 +47,8 @@ class RunAction : public G4UserRunAction
 {
   public:
     RunAction(const geom::GeometryConfig& cfg,
-              util::DataLogger*           logger);                 ///< ctor
+              util::DataLogger*           logger,
+              const sim::RunConfig&       runCfg = {});            ///< ctor
     ~RunAction() override = default;                               ///< dtor
 
     /* Geant4 entry points */
@@ -50,23 +60,62 @@ class RunAction : public G4UserRunAction
     inline G4Accumulable<unsigned>& ConeCap  (std::size_t i) { return coneCap_[i]; }
     inline G4Accumulable<unsigned>& PanelIon (std::size_t i){ return panelIon_[i]; }
     inline G4Accumulable<unsigned>& PanelCap (std::size_t i){ return panelCap_[i]; }
+    inline EventOutcomes&           Outcomes ()             { return outcomes_; }
+    inline ReplicaTally&            Replicas ()             { return replicas_; }
+    inline WeightTally&             Weights  ()             { return weights_; }
+    inline ReplicaTally&            StrataTally()           { return strata_; }
+    inline G4Accumulable<unsigned>& Transmitted()           { return transmitted_; }
+    inline G4Accumulable<unsigned long>& Steps()            { return steps_; }
 
-    /** @brief Write a one-page run summary to the console (master only). */
+    /** @return seed / event range / mode flags shared by all threads. */
+    const sim::RunConfig& Config() const noexcept { return runCfg_; }
+
+    /** @return `true` if events carry real-valued scores (bias, forcing, splitting). */
+    bool Weighted() const noexcept { return runCfg_.Weighted() || cfg_.importance.Active(); }
+
+    /**
+     * @brief Write a one-page run summary to the console (master only).
+     * @param weighted  Weighted scores of a Weighted() run, or `nullptr`;
+     *                  when given, they are the result and the raw counts
+     *                  are shown for reference only.
+     */
     static void PrintRunSummary(unsigned long nEvents,
                                 unsigned long nCap,
-                                unsigned long nIon);
+                                unsigned long nIon,
+                                const util::WeightedSums* weighted = nullptr);
+
+    /** @return `true` once a sequential job reached its target or budget (master). */
+    bool SequentialDone() const noexcept { return seqDone_; }
   private:
     /*──── immutable per-run data ────────────────────────────────────*/
     const geom::GeometryConfig cfg_;
     util::DataLogger*          logger_;          ///< belongs to master only
     const std::size_t          nCones_;
     const std::size_t          nPanels_;
+    const sim::RunConfig       runCfg_;
+
+    /*──── master only: running totals over sequential batches ───────*/
+    unsigned long         cumEvents_  {0};
+    unsigned long         cumTransmitted_ {0};
+    int                   cumBatches_ {0};
+    bool                  seqDone_    {false};
+    std::vector<unsigned> cumConeIon_, cumConeCap_, cumPanelIon_, cumPanelCap_;
+    std::vector<std::uint8_t> cumOutcomes_;
+    util::ReplicaCounts       cumReplicas_;
+    util::WeightedSums        cumWeights_;
+    sim::StratifiedEstimator  stratEst_;
 
     /*──── thread-local accumulables (registered in ctor) ────────────*/
     std::vector<G4Accumulable<unsigned>> coneIon_;
     std::vector<G4Accumulable<unsigned>> coneCap_;
     std::vector<G4Accumulable<unsigned>> panelIon_;
     std::vector<G4Accumulable<unsigned>> panelCap_;
+    EventOutcomes                        outcomes_;   ///< CRN mode only (else empty)
+    ReplicaTally                         replicas_;   ///< Sobol sampler only (else empty)
+    WeightTally                          weights_;    ///< Registered for Weighted() runs only
+    ReplicaTally                         strata_;     ///< Per-stratum counts (--strata only)
+    G4Accumulable<unsigned>              transmitted_ {0};  ///< Primaries dropped by StackingAction
+    G4Accumulable<unsigned long>         steps_       {0};  ///< mu-α steps (stepper_bench.py)
 
 
 };
\ No newline at end of file
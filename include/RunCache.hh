@@ -0,0 +1,99 @@
+/**
+ * @file    RunCache.hh
+ * @author  Mohammadreza Zakeri
+ * @date    2026-10-18
+ *
+ * @brief   Content-addressed reuse of earlier `run.json` results (no Geant4).
+ *
+ * ────────────────────────────────────────────────────────────────────────────
+ *  Keys
+ *  ────────────────────────────────────────────────────────────────────────────
+ *  * `config_hash` – FNV-1a of the *canonical* JSON of everything that
+ *    defines the physics of one event: GeometryConfig, BeamSpec, rate-table
+ *    checksum, base seed, the CRN switch, the RNG backend, the beam
+ *    sampler (with its replica count), the beam bias fraction, the beam
+ *    strata and the forced-ionisation switch.  Keys are sorted and doubles are printed round-trip exact, so
+ *    equal inputs always give equal hashes.
+ *  * `input_hash`  – config_hash plus the global event range
+ *    [first_event, first_event + n_events).
+ *
+ *  Both are written into `run.json` by DataLogger.
+ *
+ * ────────────────────────────────────────────────────────────────────────────
+ *  Reuse (`main --reuse-cache`)
+ *  ────────────────────────────────────────────────────────────────────────────
+ *  Per-event seeding (RunConfig.hh) makes event k of a configuration the
+ *  same wherever it was simulated.  Cached runs with the same config_hash
+ *  whose ranges tile a *prefix* of the requested range can therefore be
+ *  merged (RunMerge.hh) with a fresh run of the remaining events, and the
+ *  result is exactly what a full rerun would have produced.
+ */
+
+#ifndef RUN_CACHE_HH
+#define RUN_CACHE_HH
+
+/*────────────────────────────── stdlib ───────────────────────────────────*/
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/*──────────────────────────── project ────────────────────────────────────*/
+#include "GeometryConfig.hh"
+#include "Hashing.hh"
+#include "RunConfig.hh"
+#include "RunMerge.hh"
+
+namespace util {
+
+/**
+ * @brief  Hash of the event physics (geometry, beam, rate table, seed).
+ * @param  rateChecksum  `RateTable2D::Checksum()` of the loaded table.
+ */
+std::string ConfigHash(const geom::GeometryConfig& cfg,
+                       const sim::RunConfig&       runCfg,
+                       std::uint64_t               rateChecksum);
+
+/** @brief Hash of a config_hash plus the event range it was run on. */
+inline std::string InputHash(const std::string& configHash,
+                             long firstEvent, long nEvents)
+{
+    return HashHex(Fnv1a(configHash + ':' + std::to_string(firstEvent)
+                                    + ':' + std::to_string(nEvents)));
+}
+
+/**
+ * @struct CachePlan
+ * @brief  What can be reused for the range [first, first + n).
+ */
+struct CachePlan
+{
+    std::vector<std::string> runs;      ///< Cached run.json files, in range order
+    long                     cachedEnd; ///< Events [first, cachedEnd) are covered
+
+    bool Complete(long first, long n) const noexcept { return cachedEnd == first + n; }
+};
+
+/**
+ * @brief  Find cached runs under `resultsDir/<stamp>/run.json` that tile
+ *         the longest prefix of [first, first + n) for `configHash`.
+ *
+ * Unreadable files and runs without a `config_hash` are ignored.
+ */
+CachePlan PlanFromCache(const std::string& resultsDir,
+                        const std::string& configHash,
+                        long first, long n);
+
+/**
+ * @brief  Load and merge the runs of a plan (plus any extra summaries).
+ * @throw  std::runtime_error if nothing is left to merge.
+ */
+RunJson MergePlan(const CachePlan& plan, const std::vector<RunJson>& extra = {});
+
+/**
+ * @brief  Write `run` to `resultsDir/<stamp>_cache/run.json`.
+ * @return The path written.
+ */
+std::string WriteCachedRun(const std::string& resultsDir, const RunJson& run);
+
+} // namespace util
+#endif /* RUN_CACHE_HH */
@@ -0,0 +1,251 @@
+/**
+ * @file    RunConfig.hh
+ * @author  Mohammadreza Zakeri
+ * @date    2026-10-18
+ *
+ * @brief   Pure-data run-control settings (seed, event range, sharding,
+ *          beam parameters).
+ *
+ * ────────────────────────────────────────────────────────────────────────────
+ *  Event sharding
+ *  ────────────────────────────────────────────────────────────────────────────
+ *  A job of `totalEvents` events may be split over N independent processes
+ *  (`--shard=i/N`).  Shard i covers the *global* event range
+ *
+ *        [ i·T/N , (i+1)·T/N )          (integer division, T = totalEvents)
+ *
+ *  so the N ranges are disjoint and their union is exactly [0, T).
+ *
+ *  Every event re-seeds its thread-local engine from (seed, global event ID)
+ *  in PrimaryGenerator::GeneratePrimaries().  The random sequence of an event
+ *  therefore depends on neither the thread that runs it nor the process
+ *  (shard) it lives in:  merging the shards' `run.json` files reproduces a
+ *  monolithic run of the same range bit-for-bit.
+ *
+ * ────────────────────────────────────────────────────────────────────────────
+ *  Sequential stopping
+ *  ────────────────────────────────────────────────────────────────────────────
+ *  With `--target-rel-error` (or `--strata`, see Strata.hh) the job is run
+ *  as consecutive `/run/beamOn` batches of `StopRule::batchEvents` events.  Batch b (= G4Run ID) covers
+ *  the global events  firstEvent + b·batchEvents + [0, batch size),  so the
+ *  batches tile one contiguous range and stopping early yields exactly the
+ *  prefix of the fixed-size job.  `nEvents` becomes the event *budget*.
+ *
+ *  Like GeometryConfig, this header is Geant4-free.
+ */
+
+#ifndef RUN_CONFIG_HH
+#define RUN_CONFIG_HH
+
+/*────────────────────────────── stdlib ───────────────────────────────────*/
+#include <array>
+#include <cstdint>
+#include <string>
+
+namespace sim {
+
+/**
+ * @struct BeamSpec
+ * @brief  Parameters of the primary mu-α beam (PrimaryGenerator).
+ *
+ * Distances in nanometres like GeometryConfig.  The beam starts on the
+ * plane x = `x0_nm`; (y, z) is a round Gaussian of width `sigma_nm` around
+ * (0, `z0_nm`), and the direction lies in a cone of half-angle
+ * `max_theta_deg` around +x.
+ */
+struct BeamSpec
+{
+    double x0_nm         {-2000.0};  ///< Start plane [nm]
+    double z0_nm         {  975.0};  ///< Beam centre height (cone tip) [nm]
+    double sigma_nm      {  100.0};  ///< Transverse Gaussian σ [nm]
+    double max_theta_deg {    2.0};  ///< Angular spread around +x [deg]
+    double energy_MeV    { 1000.0};  ///< Kinetic energy (G4ParticleGun default) [MeV]
+};
+
+/** Source of the primary / ionisation uniforms (see EventRandom.hh). */
+enum class RngKind { Engine, Philox };
+
+/** @return "engine" / "philox" (CLI + run.json spelling). */
+constexpr const char* RngName(RngKind k) noexcept
+{
+    return k == RngKind::Philox ? "philox" : "engine";
+}
+
+/** How the beam phase space is sampled (see Sobol.hh). */
+enum class Sampler { MC, Sobol };
+
+/** @return "mc" / "sobol" (CLI + run.json spelling). */
+constexpr const char* SamplerName(Sampler s) noexcept
+{
+    return s == Sampler::Sobol ? "sobol" : "mc";
+}
+
+/** What propagates the primaries (see BallisticEngine.hh). */
+enum class Engine { Geant4, Ballistic, Check };
+
+/** @return "geant4" / "ballistic" / "check" (CLI spelling). */
+constexpr const char* EngineName(Engine e) noexcept
+{
+    switch (e) {
+        case Engine::Ballistic: return "ballistic";
+        case Engine::Check:     return "check";
+        default:                return "geant4";
+    }
+}
+
+/** Quantity whose precision decides when a sequential run stops. */
+enum class Estimator { Ion, Cap, Ratio };
+
+/** @return "ion" / "cap" / "ratio" (CLI + run.json spelling). */
+constexpr const char* EstimatorName(Estimator e) noexcept
+{
+    switch (e) {
+        case Estimator::Ion: return "ion";
+        case Estimator::Cap: return "cap";
+        default:             return "ratio";
+    }
+}
+
+/** @return the beam strata cuts as `--strata` spells them ("2x4x1x1"). */
+inline std::string StrataName(const std::array<int, 4>& cuts)
+{
+    std::string s;
+    for (int c : cuts) s += (s.empty() ? "" : "x") + std::to_string(c);
+    return s;
+}
+
+/**
+ * @struct StopRule
+ * @brief  Sequential-stopping settings (`--target-rel-error` and friends).
+ *
+ * Stop once the two-sided `confidence` interval of the chosen estimator
+ * has a half-width below `targetRelError` × estimate, or when the event
+ * budget is spent.
+ */
+struct StopRule
+{
+    double    targetRelError {0.0};               ///< 0 → fixed-size run
+    Estimator estimator      {Estimator::Ratio};  ///< What must be precise
+    double    confidence     {0.95};              ///< Two-sided level
+    long      batchEvents    {10000};             ///< Events per beamOn
+
+    /** @return `true` if the run is steered by this rule. */
+    constexpr bool Sequential() const noexcept { return targetRelError > 0.0; }
+};
+
+/**
+ * @struct RunConfig
+ * @brief  Everything that controls *which* events are simulated, how they
+ *         are seeded and what is fired.  Filled by the CLI parser in `main.cc`.
+ */
+struct RunConfig
+{
+    std::uint64_t seed        {20250604};  ///< Base seed of the whole job
+    long          totalEvents {100};       ///< Events of the (unsharded) job
+    long          firstEvent  {0};         ///< Global ID of this process' first event
+    long          nEvents     {100};       ///< Events simulated by this process
+    int           shardIndex  {0};         ///< i in `--shard=i/N`
+    int           shardCount  {1};         ///< N in `--shard=i/N`
+    BeamSpec      beam        {};          ///< Primary beam parameters
+    StopRule      stop        {};          ///< Sequential stopping (off by default)
+    bool          crn         {false};     ///< Common random numbers (EventRandom.hh)
+    RngKind       rng         {RngKind::Engine}; ///< `--rng=philox` → counter-based streams
+    Sampler       sampler     {Sampler::MC};     ///< `--sampler=sobol` → randomised QMC beam
+    int           qmcReplicas {16};              ///< Independent scrambles (Sobol only)
+    double        biasFraction {0.0};            ///< `--bias=f` → shell-focused beam share
+    std::array<int, 4> strata {1, 1, 1, 1};      ///< `--strata=a×b×c×d` cuts of (r, φ, θ, ψ)
+    bool          forceIon    {false};           ///< `--force-ion` → score Pint, never kill
+    bool          rayCull     {true};            ///< Drop primaries that miss every shell (StackingAction.hh)
+    bool          freeFlight  {true};            ///< One-step flight between shells (FreeFlightModel.hh)
+    Engine        engine      {Engine::Geant4};  ///< `--engine=ballistic` → straight-line transport
+    std::string   rateSpec;                      ///< `--rates=adk.json` → ADK from |E| (RateProvider.hh); empty → the table
+
+    /** @return `true` if this process is one shard of a larger job. */
+    constexpr bool IsSharded() const noexcept { return shardCount > 1; }
+
+    /**
+     * @brief  Split `totalEvents` into `shardCount` disjoint ranges and
+     *         select range `shardIndex` (sets `firstEvent` / `nEvents`).
+     */
+    constexpr void ApplyShard() noexcept
+    {
+        const long lo = static_cast<long>((static_cast<long long>(totalEvents) *  shardIndex     ) / shardCount);
+        const long hi = static_cast<long>((static_cast<long long>(totalEvents) * (shardIndex + 1)) / shardCount);
+        firstEvent = lo;
+        nEvents    = hi - lo;
+    }
+
+    /** @return `true` if the beam is drawn from scrambled Sobol replicas. */
+    constexpr bool Qmc() const noexcept { return sampler == Sampler::Sobol; }
+
+    /** @return `true` if primaries carry importance weights (BeamBias.hh). */
+    constexpr bool Biased() const noexcept { return biasFraction > 0.0; }
+
+    /** @return `true` if events are scored with real-valued weights (WeightTally.hh). */
+    constexpr bool Weighted() const noexcept { return Biased() || forceIon; }
+
+    /** @return number of beam strata (1 → unstratified). */
+    constexpr int NStrata() const noexcept
+    {
+        return strata[0] * strata[1] * strata[2] * strata[3];
+    }
+
+    /** @return `true` if the beam is stratified with Neyman reallocation. */
+    constexpr bool Stratified() const noexcept { return NStrata() > 1; }
+
+    /** @return `true` if the job runs as a sequence of beamOn batches. */
+    constexpr bool Batched() const noexcept { return stop.Sequential() || Stratified(); }
+
+    /** @return `true` if draws come from per-event streams, not the engine. */
+    constexpr bool CounterStreams() const noexcept
+    {
+        return crn || rng == RngKind::Philox;
+    }
+
+    /**
+     * @brief  Global ID of event `eventID` of G4Run `runID`.
+     *
+     * Fixed-size jobs consist of one run; batched jobs offset batch
+     * `runID` by `runID · batchEvents` (all but the last batch are full).
+     */
+    constexpr long GlobalEvent(int runID, int eventID) const noexcept
+    {
+        return firstEvent + eventID
+             + (Batched() ? stop.batchEvents * runID : 0L);
+    }
+};
+
+/*======================================================================*/
+/*  Per-event seeding                                                   */
+/*======================================================================*/
+
+/** @brief SplitMix64 finaliser – a cheap, well-mixed 64-bit bijection. */
+constexpr std::uint64_t SplitMix64(std::uint64_t x) noexcept
+{
+    x += 0x9E3779B97F4A7C15ULL;
+    x  = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x  = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+/**
+ * @brief  Derive the two engine seeds of one event.
+ *
+ * Seeds are strictly positive 31-bit integers so that every CLHEP engine
+ * accepts them.  Distinct (seed, event) pairs give statistically
+ * independent streams.
+ *
+ * @param seed         Job base seed (`RunConfig::seed`).
+ * @param globalEvent  Global event ID (RunConfig::GlobalEvent()).
+ * @param[out] out     Two seeds, followed by a terminating 0.
+ */
+inline void EventSeeds(std::uint64_t seed, std::uint64_t globalEvent, long out[3]) noexcept
+{
+    const std::uint64_t h = SplitMix64(seed ^ SplitMix64(globalEvent));
+    out[0] = static_cast<long>((h         & 0x7FFFFFFFULL) | 1ULL);
+    out[1] = static_cast<long>(((h >> 32) & 0x7FFFFFFFULL) | 1ULL);
+    out[2] = 0;
+}
+
+} // namespace sim
+#endif /* RUN_CONFIG_HH */
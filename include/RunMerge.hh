@@ -0,0 +1,70 @@
+/**
+ * @file    RunMerge.hh
+ * @author  Mohammadreza Zakeri
+ * @date    2026-10-18
+ *
+ * @brief   Combine the `run.json` summaries of several event shards into one
+ *          statistically exact summary (Geant4-free).
+ *
+ * ────────────────────────────────────────────────────────────────────────────
+ *  Why is a plain sum exact?
+ *  ────────────────────────────────────────────────────────────────────────────
+ *  Every tally in `run.json` is a count over *independent* events, and the
+ *  shards cover disjoint global event ranges with per-event seeding (see
+ *  RunConfig.hh).  The merged counts are therefore identical to those of a
+ *  monolithic run; fractions and errors are recomputed from the merged
+ *  counts with the same formulas (RunStats.hh) – never averaged.  The same
+ *  holds for the per-replica counts of a Sobol run (`qmc` block; replica r
+ *  of the merge is the union of replica r of every shard) and for the raw
+ *  weight sums of a biased run (`weighted` block).  The one exception is
+ *  the `stratified` block (Strata.hh): its estimate depends on the batch
+ *  allocations, so shards – independent unbiased estimates – are combined
+ *  with weights N_s/N, errors in quadrature.
+ *
+ *  Used by the `mergeRuns` command-line tool and by `main` itself.
+ */
+
+#ifndef RUN_MERGE_HH
+#define RUN_MERGE_HH
+
+/*────────────────────────────── stdlib ───────────────────────────────────*/
+#include <string>
+#include <vector>
+
+/*──────────────────────────── third-party ───────────────────────────────*/
+#include <nlohmann/json.hpp>
+
+namespace util {
+
+/// Insertion-ordered JSON so that merged files keep DataLogger's layout.
+using RunJson = nlohmann::ordered_json;
+
+/**
+ * @brief  Parse one `run.json`.
+ * @throw  std::runtime_error if the file cannot be opened or parsed.
+ */
+RunJson LoadRunSummary(const std::string& path);
+
+/**
+ * @brief  Merge shard summaries.
+ *
+ * The first summary serves as template (key order, geometry block, …).
+ * Inputs must share geometry, seed, `config_hash` (if present) and
+ * cone/panel layout, and their event ranges (`first_event`, `n_events`)
+ * must not overlap.  `input_hash` is recomputed for the merged range.
+ *
+ * @throw  std::runtime_error on incompatible or overlapping inputs.
+ */
+RunJson MergeRunSummaries(const std::vector<RunJson>& runs);
+
+/**
+ * @brief  Re-derive fractions, errors and the ratio from the raw counts
+ *         (null when `raw_valid` is false, i.e. under importance splitting).
+ *
+ * Called by MergeRunSummaries(); exposed so that other tools editing the
+ * counts keep the derived fields consistent.
+ */
+void UpdateDerivedStats(RunJson& run);
+
+} // namespace util
+#endif /* RUN_MERGE_HH */
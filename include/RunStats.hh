@@ -0,0 +1,232 @@
+/**
+ * @file    RunStats.hh
+ * @author  Mohammadreza Zakeri
+ * @date    2026-10-18
+ *
+ * @brief   Header-only statistics shared by RunAction, DataLogger and the
+ *          offline merge tool (no Geant4).
+ *
+ * Keeping the error formula in one place guarantees that a merged set of
+ * shards reports exactly the same numbers as a monolithic run would.
+ */
+
+#ifndef RUN_STATS_HH
+#define RUN_STATS_HH
+
+/*────────────────────────────── stdlib ───────────────────────────────────*/
+#include <cmath>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace util {
+
+/**
+ * @brief  Error of a binomial fraction k/n.
+ *
+ * Normal approximation √(p(1−p)/n); falls back to the "rule of three"
+ * (3/n) when k = 0 or k = n, where the normal approximation collapses.
+ *
+ * @return 0 for an empty sample.
+ */
+inline double BinomialError(unsigned long k, unsigned long n) noexcept
+{
+    if (n == 0) return 0.0;
+    const double N = static_cast<double>(n);
+    if (k == 0 || k == n) return 3.0 / N;
+    const double p = k / N;
+    return std::sqrt(p * (1.0 - p) / N);
+}
+
+/** @return k/n, or 0 for an empty sample. */
+inline double Fraction(unsigned long k, unsigned long n) noexcept
+{
+    return n ? static_cast<double>(k) / n : 0.0;
+}
+
+/**
+ * @brief  Two-sided normal quantile z with P(|Z| < z) = `confidence`.
+ *
+ * Newton iteration on erf (converges in a handful of steps for any
+ * confidence in (0, 1)); 0.95 → 1.95996.
+ */
+inline double NormalQuantile(double confidence) noexcept
+{
+    const double target = confidence;                 // erf(z/√2) = target
+    double z = 2.0;
+    for (int it = 0; it < 50; ++it)
+    {
+        const double f  = std::erf(z / std::sqrt(2.0)) - target;
+        const double df = 0.7978845608028654 * std::exp(-0.5 * z * z); // √(2/π)
+        const double dz = f / df;
+        z -= dz;
+        if (z < 0.0) z = 1e-6;
+        if (std::fabs(dz) < 1e-12) break;
+    }
+    return z;
+}
+
+/**
+ * @brief  Relative confidence half-width of a fraction k/n, ratio of
+ *         fractions or both.
+ *
+ * * fraction p = k/n :  z · √((1−p)/k)
+ * * ratio nIon/nCap  :  z · √((1−pI)/nIon + (1−pC)/nCap + 2/n)
+ *   (delta method; both tallies count outcomes of the same events, so
+ *   Cov(p̂I, p̂C) = −pI·pC/n contributes the 2/n)
+ *
+ * @return +∞ while a relevant tally is still zero (nothing to stop on).
+ */
+inline double RelHalfWidth(unsigned long nIon, unsigned long nCap,
+                           unsigned long n, double z,
+                           bool useIon, bool useCap) noexcept
+{
+    const double inf = HUGE_VAL;
+    double var = 0.0;
+    if (useIon) {
+        if (nIon == 0) return inf;
+        var += (1.0 - Fraction(nIon, n)) / nIon;
+    }
+    if (useCap) {
+        if (nCap == 0) return inf;
+        var += (1.0 - Fraction(nCap, n)) / nCap;
+    }
+    if (useIon && useCap) var += 2.0 / n;
+    return z * std::sqrt(var);
+}
+
+/*======================================================================*/
+/*  Randomised-QMC replicas (--sampler=sobol, see Sobol.hh)             */
+/*======================================================================*/
+
+/**
+ * @struct ReplicaCounts
+ * @brief  Events / ionisations / captures per independent QMC replica.
+ */
+struct ReplicaCounts
+{
+    std::vector<unsigned long> n, ion, cap;
+
+    ReplicaCounts() = default;
+    explicit ReplicaCounts(std::size_t replicas)
+    : n(replicas, 0), ion(replicas, 0), cap(replicas, 0) {}
+
+    std::size_t Size() const noexcept { return n.size(); }
+
+    /** @brief Element-wise sum (sizes must match). */
+    void Add(const ReplicaCounts& o)
+    {
+        for (std::size_t r = 0; r < n.size() && r < o.n.size(); ++r)
+        {
+            n[r] += o.n[r];  ion[r] += o.ion[r];  cap[r] += o.cap[r];
+        }
+    }
+};
+
+/** @brief Replica estimate of a fraction: mean of the R replica fractions. */
+struct ReplicaEstimate
+{
+    double mean   {0.0};
+    double stdErr {0.0};   ///< sd(replica fractions) / √R; 0 for R < 2
+};
+
+/**
+ * @brief  Randomised-QMC estimate of k/n from per-replica counts.
+ *
+ * Replicas without events are skipped.  Each replica fraction is unbiased
+ * and the replicas are independent, so the standard error follows from
+ * their sample variance alone – no binomial assumption.
+ */
+inline ReplicaEstimate ReplicaFraction(const std::vector<unsigned long>& k,
+                                       const std::vector<unsigned long>& n) noexcept
+{
+    double sum = 0.0, sum2 = 0.0;
+    int    R   = 0;
+    for (std::size_t r = 0; r < n.size() && r < k.size(); ++r)
+    {
+        if (n[r] == 0) continue;
+        const double p = Fraction(k[r], n[r]);
+        sum += p;  sum2 += p * p;  ++R;
+    }
+    if (R == 0) return {};
+
+    ReplicaEstimate e;
+    e.mean = sum / R;
+    if (R > 1)
+    {
+        const double var = std::fmax(0.0, (sum2 - R * e.mean * e.mean) / (R - 1));
+        e.stdErr = std::sqrt(var / R);
+    }
+    return e;
+}
+
+/*======================================================================*/
+/*  Weighted tallies (--bias, see BeamBias.hh)                          */
+/*======================================================================*/
+
+/**
+ * @struct WeightedSums
+ * @brief  Σw, Σw² overall, Σ X, Σ X² of the ionisation / capture scores
+ *         and their cross sum Σ X_ion·X_cap.
+ *
+ * With N events and per-event score X_i (w_i·1{event}, or the forced
+ * score of `--force-ion`), the estimate is
+ * Σ X / N and its standard error √((Σ X²/N − mean²)/(N − 1)).
+ */
+struct WeightedSums
+{
+    double w {0}, w2 {0};        ///< all events
+    double ion {0}, ion2 {0};    ///< ionisation scores
+    double cap {0}, cap2 {0};    ///< capture scores
+    double ionCap {0};           ///< Σ of ionisation × capture score per event
+
+    void Add(const WeightedSums& o) noexcept
+    {
+        w += o.w;  w2 += o.w2;  ion += o.ion;  ion2 += o.ion2;  cap += o.cap;  cap2 += o.cap2;
+        ionCap += o.ionCap;
+    }
+
+    /** @return weighted estimate of a fraction with score sums (s, s2). */
+    static ReplicaEstimate Estimate(double s, double s2, unsigned long n) noexcept
+    {
+        if (n == 0) return {};
+        const double N = static_cast<double>(n);
+        ReplicaEstimate e;
+        e.mean = s / N;
+        if (n > 1) e.stdErr = std::sqrt(std::fmax(0.0, s2 / N - e.mean * e.mean) / (N - 1.0));
+        return e;
+    }
+
+    ReplicaEstimate Ion(unsigned long n) const noexcept { return Estimate(ion, ion2, n); }
+    ReplicaEstimate Cap(unsigned long n) const noexcept { return Estimate(cap, cap2, n); }
+
+    /** @return Kish effective sample size (Σw)²/Σw². */
+    double EffectiveSize() const noexcept { return w2 > 0.0 ? w * w / w2 : 0.0; }
+
+    /**
+     * @brief  Weighted analogue of RelHalfWidth() (ratio: delta method with
+     *         the empirical covariance of the per-event ion / cap scores).
+     * @return +∞ while a relevant estimate is still zero.
+     */
+    double RelHalfWidth(unsigned long n, double z, bool useIon, bool useCap) const noexcept
+    {
+        double var = 0.0;
+        const ReplicaEstimate ie = Ion(n), ce = Cap(n);
+        for (const auto& [use, e] : {std::pair{useIon, ie}, std::pair{useCap, ce}})
+        {
+            if (!use) continue;
+            if (e.mean <= 0.0) return HUGE_VAL;
+            var += (e.stdErr / e.mean) * (e.stdErr / e.mean);
+        }
+        if (useIon && useCap && n > 1)
+        {
+            const double N   = static_cast<double>(n);
+            const double cov = (ionCap / N - ie.mean * ce.mean) / (N - 1.0);
+            var = std::fmax(0.0, var - 2.0 * cov / (ie.mean * ce.mean));
+        }
+        return z * std::sqrt(var);
+    }
+};
+
+} // namespace util
+#endif /* RUN_STATS_HH */
@@ -0,0 +1,46 @@
+/**
+ * @file    SolveHash.hh
+ * @author  Mohammadreza Zakeri
+ * @date    2026-10-18
+ *
+ * @brief   Fingerprint of a built-in field solve (`field.solve`), header-only
+ *          and without Geant4.
+ *
+ * AxisymmetricSolver names its .fgrid cache after it; RunCache puts it in
+ * the run's config hash.  Both must agree, so it lives here rather than in
+ * the solver, which the Geant4-free cache code should not pull in.
+ */
+
+#ifndef SOLVE_HASH_HH
+#define SOLVE_HASH_HH
+
+/*────────────────────────────── stdlib ───────────────────────────────────*/
+#include <cstdint>
+#include <string_view>
+
+/*──────────────────────────── project ────────────────────────────────────*/
+#include "GeometryConfig.hh"
+#include "Hashing.hh"
+
+namespace util {
+
+/** @return FNV-1a of every input of the solve (and the format version). */
+inline std::uint64_t SolveHash(const geom::GeometryConfig& cfg)
+{
+    static constexpr char kMagic[8] = {'M', 'A', 'F', 'S', 'O', 'L', 'V', '1'};
+
+    const auto& s = cfg.field.solve;
+    const auto& c = cfg.cone;
+    std::uint64_t h = Fnv1a(std::string_view(kMagic, sizeof kMagic));
+    for (double x : {c.r_tip_nm, c.r_base_nm, c.h_cone_nm, cfg.gap_nm,
+                     s.r_max_nm > 0.0 ? s.r_max_nm : cfg.r_outer_nm,
+                     s.cell_nm, s.v_cone_V, s.v_anode_V, s.tolerance,
+                     static_cast<double>(s.max_cycles),
+                     cfg.field.pos_unit_m, cfg.field.e_unit_V_per_m,
+                     s.interpolation == "bicubic" ? 1.0 : 0.0})
+        h = Fnv1a(x, h);
+    return h;
+}
+
+} // namespace util
+#endif /* SOLVE_HASH_HH */
@@ -0,0 +1,52 @@
+/**
+ * @file    StackingAction.hh
+ * @author  Mohammadreza Zakeri
+ * @date    2026-10-18
+ *
+ * @brief   Drop primaries whose straight line misses every shell column.
+ *
+ * With no electric field attached, a mu-α crosses the vacuum world on a
+ * straight line and can only be captured or ionised inside a shell column.
+ * ClassifyNewTrack() intersects each primary's ray with the columns
+ * (ColumnGrid.hh); a miss is counted as *transmitted* in the thread-local
+ * RunAction and the track is killed before it is ever transported.  The
+ * tallies are unchanged, only the transport time is saved.
+ *
+ * The test switches itself off (once per thread, at the first track) when
+ * any field manager in the geometry carries a field, and is not installed
+ * at all with `--no-ray-cull`.
+ */
+
+#ifndef STACKING_ACTION_HH
+#define STACKING_ACTION_HH
+
+/*─────────────────────────── Geant4 core ───────────────────────────────*/
+#include "G4UserStackingAction.hh"
+
+/*──────────────────────────── project ──────────────────────────────────*/
+#include "ColumnGrid.hh"
+#include "GeometryConfig.hh"
+
+class RunAction;   // fwd
+
+/**
+ * @class StackingAction
+ * @brief Analytic early termination of primaries that cannot reach a shell.
+ */
+class StackingAction : public G4UserStackingAction
+{
+  public:
+    StackingAction(const geom::GeometryConfig& cfg, RunAction* run);
+
+    G4ClassificationOfNewTrack ClassifyNewTrack(const G4Track* track) override;
+
+  private:
+    /** @return `true` if any field manager in the geometry has a field. */
+    static bool FieldActive();
+
+    geom::ColumnGrid grid_;
+    RunAction*       runAction_ {nullptr};
+    int              enabled_   {-1};       ///< -1: not yet checked
+};
+
+#endif /* STACKING_ACTION_HH */
@@ -9,6 +9,9 @@
  *          ‣  coneIon / coneCap   (size = #cones)
  *          ‣  panelIon / panelCap (size = #panels)
  *   •  The master thread merges accumulables and writes the JSON/TSV summary.
+ *   •  Weighted runs (`--bias`, `--force-ion`) also keep per-event scores:
+ *      the track weight at capture, and at ionisation either the weight
+ *      (Bernoulli trial fired) or weight·Pint at every crossing (forced).
  */
 
 #ifndef STEPPING_ACTION_HH
@@ -17,13 +20,18 @@
 /*────────────────────────── Geant4 core ───────────────────────────────*/
 #include "G4UserSteppingAction.hh"
 #include "G4Threading.hh"
+#include "G4TrackStatus.hh"
 
 /*──────────────────────────── std / proj ─────────────────────────────*/
 #include <cstddef>
 #include <cmath>
+#include <memory>
+#include "GeometryConfig.hh"   // ImportanceSpec
+#include "RateProvider.hh"     // tunnelling rates (`--rates`)
 
 class DetectorConstruction;   // fwd
 class RunAction;              // fwd
+class G4LogicalVolume;        // fwd
 
 /**
  * @class SteppingAction
@@ -41,6 +49,8 @@ class SteppingAction : public G4UserSteppingAction
     static void   ResetEventFlags();
     static bool   EventHadCapture();
     static bool   EventHadIonization();
+    static double EventIonScore();   ///< Σ ionisation scores of the event
+    static double EventCapScore();   ///< Σ capture scores of the event
 
   private:
     /* geometry handle (for cone LV + ConeInfo look-ups) */
@@ -49,9 +59,20 @@ class SteppingAction : public G4UserSteppingAction
     /* thread-local RunAction → exposes G4Accumulables */
     RunAction* runAction_{nullptr};
 
+    /* geometric importances; with splitting on, kills keep the copies */
+    geom::ImportanceSpec fImp;
+    G4TrackStatus        fKill {fKillTrackAndSecondaries};
+
+    double Importance(const G4LogicalVolume* lv) const;
+
+    /* w(ρ, z): the table, or ADK from the field map with `--rates` */
+    std::unique_ptr<const RateProvider> fRates;
+
     /* event flags (thread-local) */
     static G4ThreadLocal bool gEventCaptureOccurred;
     static G4ThreadLocal bool gEventIonizationOccurred;
+    static G4ThreadLocal double gEventIonScore;
+    static G4ThreadLocal double gEventCapScore;
 };
 
 #endif /* STEPPING_ACTION_HH */
\ No newline at end of file
@@ -0,0 +1,156 @@
+/**
+ * @file    Strata.hh
+ * @author  Mohammadreza Zakeri
+ * @date    2026-10-18
+ *
+ * @brief   Adaptive stratified sampling of the beam phase space with
+ *          Neyman reallocation between batches (`main --strata`, no Geant4).
+ *
+ * ────────────────────────────────────────────────────────────────────────────
+ *  Strata
+ *  ────────────────────────────────────────────────────────────────────────────
+ *  PrimaryGenerator maps four uniforms to the beam:  u₀ → radius quantile,
+ *  u₁ → φ (together an annulus × sector cell of the Gaussian (y, z) spot),
+ *  u₂ → θ, u₃ → ψ.  `--strata=a×b×c×d` cuts each uᵢ into equal slices, so
+ *  the H = a·b·c·d cells all have probability p_h = 1/H.
+ *
+ * ────────────────────────────────────────────────────────────────────────────
+ *  Batches and allocation
+ *  ────────────────────────────────────────────────────────────────────────────
+ *  The job runs in batches (one beamOn each, `--batch`).  Before a batch,
+ *  main turns the current *shares* into integer counts n_h (at least two
+ *  per stratum) and event j of the batch goes to the stratum whose block
+ *  of indices contains j.  After the batch the master RunAction re-derives
+ *  the shares from all strata seen so far (Neyman: n_h ∝ p_h·σ̂_h); the
+ *  first batch is proportional.
+ *
+ *  Unbiasedness: batch b uses an allocation fixed *before* it started, so
+ *  its stratified estimate  μ̂_b = Σ p_h k_h/n_h  is unbiased.  Batches are
+ *  combined with their (fixed) sizes as weights:
+ *
+ *      μ̂ = Σ_b (N_b/N) μ̂_b,      Var μ̂ = Σ_b (N_b/N)² Σ_h p_h² s²_hb / n_hb.
+ *
+ *  A plain MC run of N events would have had Var = μ(1 − μ)/N for a
+ *  Bernoulli score; the ratio of the two is reported as the variance
+ *  reduction.
+ *
+ *  The plan is written by the master only, between beamOn calls, while the
+ *  workers are idle; the run manager's start-of-run barrier publishes it.
+ */
+
+#ifndef STRATA_HH
+#define STRATA_HH
+
+/*────────────────────────────── stdlib ───────────────────────────────────*/
+#include <array>
+#include <vector>
+
+/*──────────────────────────── project ────────────────────────────────────*/
+#include "RunConfig.hh"
+#include "RunStats.hh"   // ReplicaCounts, ReplicaEstimate
+
+namespace sim {
+
+/*======================================================================*/
+/*  1.  Allocation plan (shared by all threads)                         */
+/*======================================================================*/
+
+/**
+ * @class StrataPlan
+ * @brief Stratum grid, current shares and the per-batch event blocks.
+ */
+class StrataPlan
+{
+  public:
+    /** @brief (Re)initialise for a grid; shares become proportional. */
+    void Configure(const std::array<int, 4>& cuts);
+
+    int  Size() const noexcept { return static_cast<int>(shares_.size()); }
+    const std::array<int, 4>& Cuts() const noexcept { return cuts_; }
+
+    /** @brief Replace the shares (need not be normalised). */
+    void SetShares(const std::vector<double>& shares);
+
+    /**
+     * @brief  Turn the shares into counts for a batch of `n` events
+     *         (largest remainder, at least two per stratum).
+     * @throw  std::invalid_argument if `n` < 2·Size().
+     */
+    void Allocate(long n);
+
+    /** @return counts of the current batch. */
+    const std::vector<long>& Allocation() const noexcept { return alloc_; }
+
+    /** @return stratum of event `j` (0-based index inside the batch). */
+    int StratumOf(long j) const noexcept;
+
+    /**
+     * @brief  Map stratum `h` and four uniforms to the unit-cube point
+     *         u_d = (c_d + v_d) / cuts_d.
+     */
+    void Point(int h, const double v[4], double u[4]) const noexcept;
+
+  private:
+    std::array<int, 4>  cuts_   {1, 1, 1, 1};
+    std::vector<double> shares_ {1.0};
+    std::vector<long>   alloc_;
+    std::vector<long>   ends_;       ///< exclusive prefix sums of alloc_
+};
+
+/** @return the process-wide plan (configured by main). */
+inline StrataPlan& Strata()
+{
+    static StrataPlan s_plan;
+    return s_plan;
+}
+
+/*======================================================================*/
+/*  2.  Combined estimator (master RunAction)                           */
+/*======================================================================*/
+
+/**
+ * @class StratifiedEstimator
+ * @brief Batch-combined stratified estimates of the ion / capture fractions.
+ */
+class StratifiedEstimator
+{
+  public:
+    explicit StratifiedEstimator(int strata = 0) : pooled_(strata) {}
+
+    /** @brief Fold in one batch (counts per stratum under a fixed allocation). */
+    void AddBatch(const util::ReplicaCounts& batch);
+
+    /** @return batch-combined estimate and standard error. */
+    util::ReplicaEstimate Ion() const noexcept { return Combined(ion_); }
+    util::ReplicaEstimate Cap() const noexcept { return Combined(cap_); }
+
+    /** @return standard error a plain MC run of the same size would have. */
+    double IonErrMC() const noexcept { return PlainError(ion_); }
+    double CapErrMC() const noexcept { return PlainError(cap_); }
+
+    /**
+     * @brief  Neyman shares p_h·σ̂_h from the pooled strata.
+     *
+     * σ̂²_h sums the *relative* Bernoulli variances of the selected tallies,
+     * with k → k + ½, n → n + 1 so that empty strata keep a nonzero share.
+     */
+    std::vector<double> NeymanShares(bool useIon, bool useCap) const;
+
+    const util::ReplicaCounts& Pooled() const noexcept { return pooled_; }
+    long Events()  const noexcept { return events_; }
+    int  Batches() const noexcept { return batches_; }
+
+  private:
+    struct Sums { double mean {0}, var {0}; };   ///< Σ N_b μ̂_b, Σ N_b² V_b
+
+    util::ReplicaEstimate Combined(const Sums& s) const noexcept;
+    double PlainError(const Sums& s) const noexcept;
+
+    util::ReplicaCounts pooled_;
+    Sums                ion_, cap_;
+    long                events_  {0};
+    int                 batches_ {0};
+};
+
+} // namespace sim
+#endif /* STRATA_HH */
@@ -0,0 +1,136 @@
+/**
+ * @file    TiledFieldMap.hh
+ * @author  Mohammadreza Zakeri
+ * @date    2026-10-18
+ *
+ * @brief   3-D regular-grid electric field map, stored in cache-blocked
+ *          tiles in a memory-mapped file and paged in on demand (no Geant4).
+ *
+ * ────────────────────────────────────────────────────────────────────────────
+ *  Layout (.f3d)
+ *  ────────────────────────────────────────────────────────────────────────────
+ *    FileHeader (64 KiB block) | tile 0 | tile 1 | …
+ *  The grid has nx × ny × nz nodes with spacing (hx, hy, hz).  It is cut
+ *  into tiles of T³ cells.  A tile stores its (T+1)³ corner nodes as
+ *  float (Ex, Ey, Ez), x fastest, so neighbouring tiles share a face.
+ *  Every trilinear cell then lies inside one tile: a lookup reads 8
+ *  nodes from one contiguous block of 58 KiB (T = 16).  Tiles are padded
+ *  to multiples of 64 KiB, the kernel's fault-around window, so a page
+ *  fault never maps pages of a neighbouring tile.  They are ordered x,
+ *  then y, then z.  The layout is native-endian.
+ *
+ * ────────────────────────────────────────────────────────────────────────────
+ *  Residency
+ *  ────────────────────────────────────────────────────────────────────────────
+ *  The file is mapped read-only with MADV_RANDOM, so only touched tiles are
+ *  read.  With a budget, an LRU list keeps at most `budget` tiles mapped;
+ *  the oldest is dropped with MADV_DONTNEED and faults back in from the
+ *  page cache or disk if it is used again.  The list is shared by all
+ *  threads behind one mutex.  Each thread remembers its last tile and
+ *  takes the lock only when it moves to another tile.  A tile still in
+ *  use by one thread may be dropped by another; it then simply faults
+ *  in again.  The budget thus bounds the resident set to within one tile
+ *  per thread.
+ *
+ *  Queries outside the grid are clamped to its faces.  Written by
+ *  Convert() (tools/makeFieldGrid3D.cc); read by TiledG4Field when the
+ *  geometry has a `field.grid3d` block.
+ */
+
+#ifndef TILED_FIELD_MAP_HH
+#define TILED_FIELD_MAP_HH
+
+/*────────────────────────────── stdlib ───────────────────────────────────*/
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/*──────────────────────────── project ────────────────────────────────────*/
+#include "MappedFile.hh"
+
+class TiledFieldMap
+{
+  public:
+    /// Grid geometry, as stored in the file header.
+    struct Grid {
+        std::uint32_t n[3]    {0, 0, 0};      ///< Nodes per axis (≥ 2)
+        std::uint32_t tile    {16};           ///< Cells per tile edge
+        std::uint32_t tiles[3]{0, 0, 0};      ///< Tiles per axis
+        double        origin[3] {0, 0, 0};    ///< Node (0, 0, 0) [map units]
+        double        h[3]      {1, 1, 1};    ///< Spacing        [map units]
+        std::uint64_t tileBytes {0};          ///< Stride between tiles
+        std::uint64_t hash      {0};          ///< FNV-1a of all tiles
+    };
+
+    /**
+     * @brief Map `path` for lookups.
+     * @param residentBytes  Budget of mapped tiles; 0 → no bound.
+     * @throw std::runtime_error if the file cannot be mapped or is malformed.
+     */
+    explicit TiledFieldMap(const std::string& path, std::size_t residentBytes = 0);
+
+    TiledFieldMap(const TiledFieldMap&)            = delete;
+    TiledFieldMap& operator=(const TiledFieldMap&) = delete;
+
+    /**
+     * @brief  Trilinear field at (x, y, z) [map units].
+     * @param[out] E  (Ex, Ey, Ez) [map field units]
+     */
+    void Field(double x, double y, double z, double E[3]) const;
+
+    /** @brief Print the grid, the tile size and the residency counters. */
+    void Report(std::ostream& os) const;
+
+    const Grid&   GetGrid()    const noexcept { return grid_; }
+    std::size_t   Budget()     const noexcept { return budget_; }
+    std::uint64_t PageIns()    const noexcept { return pageIns_.load(std::memory_order_relaxed); }
+    std::uint64_t Evictions()  const noexcept { return evictions_.load(std::memory_order_relaxed); }
+
+    /**
+     * @return the content hash stored in the header of `path` (reads the
+     *         header only; used for the run-cache key).
+     * @throw  std::runtime_error if `path` is not a .f3d grid.
+     */
+    static std::uint64_t FileHash(const std::string& path);
+
+    /**
+     * @brief Convert a text table into a tiled .f3d grid.
+     *
+     * Rows are `x y z Ex Ey Ez` in any order (separated by blanks, tabs or
+     * commas).  Lines starting with '%' or '#' are comments, as in COMSOL
+     * and Gmsh exports.  The rows must fill a regular grid exactly.  The
+     * table is read twice from a mapping and the output is written through
+     * a shared mapping, so neither has to fit in memory.
+     * @throw std::runtime_error on I/O errors, a malformed row or an
+     *        irregular grid.
+     */
+    static Grid Convert(const std::string& table, const std::string& out,
+                        std::uint32_t tile, std::ostream& log);
+
+  private:
+    const float* Tile(std::uint64_t t) const noexcept
+    {
+        return reinterpret_cast<const float*>(base_ + t * grid_.tileBytes);
+    }
+    void Touch(std::uint64_t t) const;
+
+    Grid              grid_;
+    util::MappedFile  map_;
+    const char*       base_ {nullptr};        ///< First tile
+    std::uint64_t     id_;                    ///< Tells instances apart per thread
+
+    /* residency (LRU over tile ids, most recent at head_) */
+    std::size_t                        budget_ {0};   ///< Tiles; 0 → no bound
+    mutable std::mutex                 lruMutex_;
+    mutable std::vector<std::uint32_t> prev_, next_;
+    mutable std::vector<std::uint8_t>  resident_;
+    mutable std::uint32_t              head_, tail_;
+    mutable std::size_t                count_ {0};
+    mutable std::atomic<std::uint64_t> pageIns_ {0}, evictions_ {0};
+};
+
+#endif /* TILED_FIELD_MAP_HH */
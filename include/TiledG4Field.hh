@@ -0,0 +1,50 @@
+#pragma once
+
+#include "G4ElectroMagneticField.hh"
+#include "G4ThreeVector.hh"
+#include "TiledFieldMap.hh"
+
+#include <memory>
+
+/**
+ * @class TiledG4Field
+ * @brief A Geant4-compatible electromagnetic field that wraps a 3-D tiled
+ *        E-field grid.
+ *
+ * Unlike RevolvedG4Field there is no axis: the grid covers (x, y, z)
+ * directly, so staggered or offset panels are described exactly.  Lookups
+ * are trilinear (TiledFieldMap).  Only the electric field is set (magnetic
+ * field is zero).
+ */
+class TiledG4Field : public G4ElectroMagneticField {
+public:
+    /**
+     * @brief Constructor from a mapped grid (shared between threads).
+     * @param map        3-D grid, read-only.
+     * @param origin     Global position of the grid's (0, 0, 0) [Geant4 units].
+     * @param lengthUnit Length unit of the grid coordinates [Geant4 units].
+     * @param fieldUnit  Unit of the grid field values [Geant4 units].
+     */
+    TiledG4Field(std::shared_ptr<const TiledFieldMap> map,
+                 const G4ThreeVector& origin,
+                 G4double lengthUnit, G4double fieldUnit);
+
+    /**
+     * @brief Override Geant4 field query.
+     * @param point Cartesian coordinates of query point (x,y,z,t).
+     * @param field Output array to store [Ex, Ey, Ez, Bx, By, Bz].
+     */
+    void GetFieldValue(const double point[4], double* field) const override;
+
+	/**
+	 * @brief Indicates whether the field contributes to energy change of the particle.
+	 * @return true, because electric fields do work on charged particles.
+	 */
+	G4bool DoesFieldChangeEnergy() const override { return true; }
+
+private:
+    std::shared_ptr<const TiledFieldMap> fieldMap; ///< E-field lookup
+    G4ThreeVector origin     {};    ///< Grid origin (global)
+    G4double      lengthUnit {1.0}; ///< Grid length unit
+    G4double      fieldUnit  {1.0}; ///< Grid field unit
+};
@@ -0,0 +1,49 @@
+/**
+ * @file    WeightTally.hh
+ * @author  Mohammadreza Zakeri
+ * @date    2026-10-18
+ *
+ * @brief   Weighted ionisation / capture scores as a mergeable accumulable
+ *          (`--bias`, see BeamBias.hh; `--force-ion`, see SteppingAction.cc).
+ *
+ * EventAction adds the primary-vertex weight w of every event and the
+ * event's ionisation / capture scores (and their squares and product for
+ * the variance of each and of their ratio); merging is a plain sum.  Without forcing a score is w or 0;
+ * with `--force-ion` it is any value in [0, w].  The master writes the
+ * weighted estimates to the `weighted` block of `run.json`.
+ */
+
+#pragma once
+
+/*─────────────────────────── Geant4 core ───────────────────────────────*/
+#include "G4VAccumulable.hh"
+
+/*──────────────────────────── project ──────────────────────────────────*/
+#include "RunStats.hh"   // util::WeightedSums
+
+class WeightTally : public G4VAccumulable
+{
+  public:
+    WeightTally() : G4VAccumulable("WeightTally") {}
+
+    /** @brief Score one event of weight `w` with scores `ion`, `cap`. */
+    void Add(double w, double ion, double cap) noexcept
+    {
+        sums_.w   += w;    sums_.w2   += w * w;
+        sums_.ion += ion;  sums_.ion2 += ion * ion;
+        sums_.cap += cap;  sums_.cap2 += cap * cap;
+        sums_.ionCap += ion * cap;
+    }
+
+    void Merge(const G4VAccumulable& other) override
+    {
+        sums_.Add(static_cast<const WeightTally&>(other).sums_);
+    }
+
+    void Reset() override { sums_ = {}; }
+
+    const util::WeightedSums& Sums() const noexcept { return sums_; }
+
+  private:
+    util::WeightedSums sums_;
+};
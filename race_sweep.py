@@ -0,0 +1,169 @@
+#!/usr/bin/env python3
+"""
+race_sweep.py – successive-halving race over the 5×5 grid_sweep layouts.
+
+Instead of giving every nx×ny configuration the same (large) event count,
+all configurations start with a small budget.  After each round:
+
+  • a confidence interval is computed for every survivor from its merged
+    tallies (n_events / n_ion / n_capture in run.json),
+  • configurations whose interval lies entirely below (or above, with
+    --minimize) the best lower (upper) bound are dropped as dominated,
+  • of the rest at most ⌈n/η⌉ are kept (best point estimates first),
+  • the survivors' budget is multiplied by η.
+
+Extra events are never re-simulated: each round calls main with the new
+cumulative --nevents and --reuse-cache, so main only simulates the missing
+event range and merges it into run.json (see include/RunCache.hh).
+
+  python race_sweep.py --exe ./build/main --n0 2000 --eta 2 --rounds 6
+  python race_sweep.py --metric cap --minimize        # fewest captures
+
+Writes <out>/race.csv (one row per configuration, final ranking).
+
+Dependencies: Python 3.8+, pandas
+"""
+
+import argparse, math
+from concurrent.futures import ThreadPoolExecutor
+from pathlib import Path
+from statistics import NormalDist
+
+import pandas as pd
+
+from grid_sweep import run_one
+from sweep_queue import load_run
+
+
+# ───────────────────────────────── statistics ───────────────────────────────
+def interval(rec: dict, metric: str, z: float):
+    """(estimate, lo, hi) of ion/cap fraction or their ratio.
+
+    Fractions use the normal approximation; the ratio uses a delta-method
+    interval on log(ion/cap) (same variance as main --estimator=ratio).
+    Zero tallies give an uninformative interval.
+    """
+    n, ion, cap = rec["n_events"], rec["n_ion"], rec["n_capture"]
+    if metric in ("ion", "cap"):
+        k = ion if metric == "ion" else cap
+        p = k / n if n else 0.0
+        if k == 0 or k == n:
+            err = 3.0 / n if n else 1.0            # rule of three (RunStats.hh)
+        else:
+            err = math.sqrt(p * (1 - p) / n)
+        return p, max(0.0, p - z * err), min(1.0, p + z * err)
+
+    if ion == 0 or cap == 0:
+        est = ion / cap if cap else math.inf
+        return est, 0.0, math.inf
+    r = ion / cap
+    s = z * math.sqrt((1 - ion / n) / ion + (1 - cap / n) / cap + 2 / n)
+    return r, r * math.exp(-s), r * math.exp(s)
+
+
+def prune(stats: dict, maximize: bool, eta: float) -> list:
+    """Survivors after dominance elimination and the η-halving cap."""
+    if maximize:
+        bar  = max(lo for _, lo, _ in stats.values())
+        keep = [k for k, (_, _, hi) in stats.items() if hi >= bar]
+    else:
+        bar  = min(hi for _, _, hi in stats.values())
+        keep = [k for k, (_, lo, _) in stats.items() if lo <= bar]
+
+    keep.sort(key=lambda k: stats[k][0], reverse=maximize)
+    if eta > 1:
+        keep = keep[:max(1, math.ceil(len(stats) / eta))]
+    return keep
+
+
+# ───────────────────────────────── driver ───────────────────────────────────
+def main():
+    ap = argparse.ArgumentParser()
+    ap.add_argument("--exe", default="./build/main")
+    ap.add_argument("--out", default="grid_sweep")
+    ap.add_argument("--pitch", type=float, default=150.0, help="lattice pitch [nm]")
+    ap.add_argument("--n0", type=int, default=2000, help="events per config, round 0")
+    ap.add_argument("--eta", type=float, default=2.0,
+                    help="budget growth / halving factor (≤1: dominance only)")
+    ap.add_argument("--rounds", type=int, default=6)
+    ap.add_argument("--max-events", type=int, default=1_000_000,
+                    help="per-configuration event cap")
+    ap.add_argument("--metric", choices=("ratio", "ion", "cap"), default="ratio")
+    ap.add_argument("--minimize", action="store_true")
+    ap.add_argument("--confidence", type=float, default=0.95)
+    ap.add_argument("--jobs", type=int, default=1, help="concurrent simulations")
+    args = ap.parse_args()
+
+    exe  = Path(args.exe).resolve()
+    root = Path(args.out).resolve()
+    root.mkdir(parents=True, exist_ok=True)
+    z = NormalDist().inv_cdf(0.5 + args.confidence / 2)
+    maximize = not args.minimize
+
+    configs = [(nx, ny) for nx in range(1, 6) for ny in range(1, 6)]
+    alive   = list(configs)
+    latest  = {}          # (nx,ny) → last run.json record
+    dropped = {}          # (nx,ny) → round it was eliminated in
+    budget  = args.n0
+
+    for rnd in range(args.rounds):
+        budget = min(budget, args.max_events)
+        print(f"── round {rnd}: {len(alive)} configuration(s) × {budget} events")
+
+        def simulate(c):
+            p = run_one(*c, budget, exe, root, args.pitch, ["--reuse-cache"])
+            return c, p
+
+        with ThreadPoolExecutor(max_workers=args.jobs) as pool:
+            for c, p in pool.map(simulate, alive):
+                if p is None:
+                    print(f"  nx{c[0]}_ny{c[1]}: no result – dropped")
+                    dropped[c] = rnd
+                    continue
+                latest[c] = load_run(p)
+
+        alive = [c for c in alive if c in latest and c not in dropped]
+        if not alive:
+            raise SystemExit(f"race_sweep: every configuration failed in round {rnd} "
+                             f"– nothing to rank (check the main runs under {root})")
+        stats = {c: interval(latest[c], args.metric, z) for c in alive}
+        keep  = prune(stats, maximize, args.eta)
+        for c in alive:
+            if c not in keep:
+                dropped[c] = rnd
+        alive = keep
+
+        for c in alive:
+            est, lo, hi = stats[c]
+            print(f"  nx{c[0]}_ny{c[1]}: {args.metric} = {est:.4g} [{lo:.4g}, {hi:.4g}]")
+        if len(alive) == 1 or budget >= args.max_events:
+            break
+        budget = int(math.ceil(budget * max(args.eta, 1.0 + 1e-9)))
+
+    # ───────────────────────────── report ──────────────────────────────────
+    rows = []
+    for c in configs:
+        if c not in latest:
+            continue
+        est, lo, hi = interval(latest[c], args.metric, z)
+        rec = latest[c]
+        rows.append({"nx": c[0], "ny": c[1], "n_events": rec["n_events"],
+                     "n_ion": rec["n_ion"], "n_capture": rec["n_capture"],
+                     args.metric: est, "lo": lo, "hi": hi,
+                     "status": "alive" if c in alive else f"dropped@{dropped[c]}"})
+
+    df = pd.DataFrame(rows)
+    df["alive"] = df["status"] == "alive"
+    df = (df.sort_values(["alive", args.metric], ascending=[False, not maximize])
+            .drop(columns="alive").reset_index(drop=True))
+    df.index += 1
+    print(f"\nFinal ranking ({args.metric}, {args.confidence:.0%} CI):")
+    print(df.to_string())
+    print(f"Total events: {int(df['n_events'].sum())}"
+          f"  (uniform allocation would use {budget * len(configs)})")
+    df.to_csv(root / "race.csv", index_label="rank")
+    print("★ Wrote", root / "race.csv")
+
+
+if __name__ == "__main__":
+    main()
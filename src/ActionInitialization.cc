@@ -12,6 +12,7 @@
 #include "PrimaryGenerator.hh"
 #include "RunAction.hh"
 #include "SteppingAction.hh"
+#include "StackingAction.hh"
 #include "DetectorConstruction.hh"
 #include "EventAction.hh"
 #include "DataLogger.hh"
@@ -20,12 +21,14 @@
 /*  ctor / dtor                                                       */
 /*════════════════════════════════════════════════════════════════════*/
 ActionInitialization::ActionInitialization(DetectorConstruction*       det,
-                                           const geom::GeometryConfig& cfg)
+                                           const geom::GeometryConfig& cfg,
+                                           const sim::RunConfig&       runCfg)
 : fDet_{det}
 , cfg_{cfg}
+, runCfg_{runCfg}
 {
     /* Create the single master-owned DataLogger right here */
-    logger_ = new util::DataLogger("results");
+    logger_ = new util::DataLogger("results", runCfg_);
 }
 
 ActionInitialization::~ActionInitialization()
@@ -38,7 +41,7 @@ ActionInitialization::~ActionInitialization()
 /*════════════════════════════════════════════════════════════════════*/
 void ActionInitialization::BuildForMaster() const
 {
-    SetUserAction(new RunAction(cfg_, logger_));
+    SetUserAction(new RunAction(cfg_, logger_, runCfg_));
 
     /* ROOT file settings (shared for all threads) */
     auto* mgr = G4AnalysisManager::Instance();
@@ -54,18 +57,22 @@ void ActionInitialization::BuildForMaster() const
 /*════════════════════════════════════════════════════════════════════*/
 void ActionInitialization::Build() const
 {
-    /* 1)  Primary generator */
-    SetUserAction(new PrimaryGenerator());
+    /* 1)  Primary generator (re-seeds per global event ID) */
+    SetUserAction(new PrimaryGenerator(runCfg_, cfg_));
 
     /* 2)  RunAction (thread-local but shares same logger pointer) */
-    auto* runAction = new RunAction(cfg_, logger_);
+    auto* runAction = new RunAction(cfg_, logger_, runCfg_);
     SetUserAction(runAction);
 
     /* 3)  SteppingAction needs geometry + this thread’s RunAction */
     SetUserAction(new SteppingAction(fDet_, runAction));
 
     /* 4)  Optional per-event bookkeeping */
-    SetUserAction(new EventAction());
+    SetUserAction(new EventAction(runAction));
+
+    /* 4b) Kill primaries whose straight line misses every shell */
+    if (runCfg_.rayCull)
+        SetUserAction(new StackingAction(cfg_, runAction));
 
     /* 5)  ROOT settings (same as master) */
     auto* mgr = G4AnalysisManager::Instance();
@@ -0,0 +1,264 @@
+/**
+ * @file    AdkRateTable.cc
+ * @author  Mohammadreza Zakeri
+ * @date    2026-10-18
+ *
+ * @brief   ADK rate and its (ρ, z) table (see AdkRateTable.hh).
+ */
+
+#include "AdkRateTable.hh"
+
+/*────────────────────────────── stdlib ───────────────────────────────────*/
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <thread>
+
+/*────────────────────────────── POSIX ────────────────────────────────────*/
+#include <unistd.h>     // getpid
+
+/*──────────────────────────── third-party ───────────────────────────────*/
+#include <nlohmann/json.hpp>
+
+/*──────────────────────────── project ────────────────────────────────────*/
+#include "Hashing.hh"
+
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr double kHartree_eV = 27.211386245988;     ///< E_h [eV]
+constexpr double kFieldAu    = 5.14220674763e11;    ///< E_h/(e a₀) [V/m]
+constexpr double kTimeAu     = 2.4188843265857e-17; ///< ħ/E_h [s]
+
+/// Write through `path`.tmp<pid> and rename, as the field caches do.
+template <class F>
+void WriteAtomically(const std::string& path, std::ios::openmode mode, F&& body)
+{
+    const std::string tmp = path + ".tmp" + std::to_string(::getpid());
+    {
+        std::ofstream out(tmp, mode);
+        body(out);
+        if (!out) {
+            std::error_code ec;
+            fs::remove(tmp, ec);
+            throw std::runtime_error("AdkRateTable: cannot write " + tmp);
+        }
+    }
+    fs::rename(tmp, path);
+}
+
+} // namespace
+
+/*══════════════════════════════════════════════════════════════════════════*/
+/* 1.  Spec                                                                 */
+/*══════════════════════════════════════════════════════════════════════════*/
+AdkRate::Spec AdkRate::Spec::Load(const std::string& path)
+{
+    std::ifstream in(path);
+    if (!in) throw std::runtime_error("AdkRate: cannot read " + path);
+
+    nlohmann::json j;
+    Spec s;
+    try {
+        in >> j;
+        s.Z          = j.value("Z",          s.Z);
+        s.mass_me    = j.value("mass_me",    s.mass_me);
+        s.cell_nm    = j.value("cell_nm",    s.cell_nm);
+        s.rho_max_nm = j.value("rho_max_nm", s.rho_max_nm);
+        s.z_min_nm   = j.value("z_min_nm",   s.z_min_nm);
+        s.z_max_nm   = j.value("z_max_nm",   s.z_max_nm);
+        s.map_z0_nm  = j.value("map_z0_nm",  s.map_z0_nm);
+        s.memo_rel   = j.value("memo_rel",   s.memo_rel);
+        for (const auto& e : j.at("states")) {
+            State st;
+            e.at("ip_eV").get_to(st.ip_eV);
+            st.l      = e.value("l",      st.l);
+            st.m      = e.value("m",      st.m);
+            st.weight = e.value("weight", st.weight);
+            s.states.push_back(st);
+        }
+    } catch (const nlohmann::json::exception& e) {
+        throw std::invalid_argument("AdkRate: " + path + ": " + e.what());
+    }
+    return s;
+}
+
+std::uint64_t AdkRate::Spec::Hash() const
+{
+    std::uint64_t h = util::Fnv1a("adk1");
+    h = util::Fnv1a(Z, h);
+    h = util::Fnv1a(mass_me, h);
+    for (const auto& s : states) {
+        h = util::Fnv1a(s.ip_eV, h);
+        h = util::Fnv1a(static_cast<double>(s.l), h);
+        h = util::Fnv1a(static_cast<double>(s.m), h);
+        h = util::Fnv1a(s.weight, h);
+    }
+    return util::Fnv1a(memo_rel, h);
+}
+
+/*══════════════════════════════════════════════════════════════════════════*/
+/* 2.  Rate                                                                 */
+/*══════════════════════════════════════════════════════════════════════════*/
+AdkRate::AdkRate(const Spec& spec)
+: fieldAu_{kFieldAu * spec.mass_me * spec.mass_me},
+  rateAu_{spec.mass_me / kTimeAu}
+{
+    if (!(spec.Z > 0.0) || !(spec.mass_me > 0.0) || spec.states.empty())
+        throw std::invalid_argument("AdkRate: need Z > 0, mass_me > 0 and at least one state");
+
+    bsi_ = HUGE_VAL;
+    for (const auto& s : spec.states) {
+        const int am = std::abs(s.m);
+        if (!(s.ip_eV > 0.0) || s.l < 0 || am > s.l || !(s.weight >= 0.0))
+            throw std::invalid_argument("AdkRate: each state needs ip_eV > 0, l >= 0, "
+                                        "|m| <= l and weight >= 0");
+        const double ip = s.ip_eV / (kHartree_eV * spec.mass_me);    // scaled a.u.
+        const double n  = spec.Z / std::sqrt(2.0 * ip);               // n*
+        const double F0 = std::pow(2.0 * ip, 1.5);
+        const double p  = 2.0 * n - am - 1.0;
+
+        // ln C² with l* = n* − 1:  Γ(n*+l*+1) = Γ(2n*),  Γ(n*−l*) = 1
+        const double logC2 = 2.0 * n * std::log(2.0) - std::log(n) - std::lgamma(2.0 * n);
+        const double logF  = std::log(2.0 * s.l + 1.0) + std::lgamma(s.l + am + 1.0)
+                           - am * std::log(2.0) - std::lgamma(am + 1.0)
+                           - std::lgamma(s.l - am + 1.0);
+        bsi_ = std::min(bsi_, ip * ip / (4.0 * spec.Z) * fieldAu_);
+        if (s.weight == 0.0) continue;
+        terms_.push_back({logC2 + logF + std::log(ip) + p * std::log(2.0 * F0)
+                          + std::log(s.weight), p, 2.0 * F0 / 3.0});
+    }
+}
+
+double AdkRate::operator()(double F_V_per_m) const noexcept
+{
+    double w;
+    Evaluate(&F_V_per_m, &w, 1);                // same arithmetic as a batch
+    return w;
+}
+
+void AdkRate::Evaluate(const double* F_V_per_m, double* w, std::size_t n) const noexcept
+{
+    // In chunks on the stack; F ≤ 0 → log F = 0 and 1/F = ∞, so every
+    // term is exp(−∞) = 0
+    constexpr std::size_t kChunk = 64;
+    double logF[kChunk], invF[kChunk];
+    for (std::size_t i0 = 0; i0 < n; i0 += kChunk) {
+        const std::size_t m = std::min(kChunk, n - i0);
+        const double* F = F_V_per_m + i0;
+        double*       o = w + i0;
+        for (std::size_t i = 0; i < m; ++i) {
+            const double f  = F[i] / fieldAu_;
+            const bool   ok = f > 0.0;
+            logF[i] = std::log(ok ? f : 1.0);
+            invF[i] = ok ? 1.0 / f : HUGE_VAL;
+            o[i]    = 0.0;
+        }
+        for (const auto& t : terms_)
+            for (std::size_t i = 0; i < m; ++i)
+                o[i] += std::exp(t.logA - t.p * logF[i] - t.B * invF[i]);
+        for (std::size_t i = 0; i < m; ++i) o[i] *= rateAu_;
+    }
+}
+
+/*══════════════════════════════════════════════════════════════════════════*/
+/* 3.  Table                                                                */
+/*══════════════════════════════════════════════════════════════════════════*/
+AdkRateTable::AdkRateTable(const AxisymmetricField& map, const geom::FieldSpec& field,
+                           const AdkRate::Spec& spec, unsigned threads)
+{
+    const AdkRate rate(spec);
+    bsi_ = rate.BsiField();
+    if (!(spec.cell_nm > 0.0))
+        throw std::invalid_argument("AdkRate: need cell_nm > 0");
+
+    // Extent in cone-local nm; unset parts come from the map's bounds
+    const double scale = 1e-9 / field.pos_unit_m;                  // nm → map units
+    double r0, r1, z0, z1;
+    map.Bounds(r0, r1, z0, z1);
+    const double rhoMax = spec.rho_max_nm > 0.0 ? spec.rho_max_nm : r1 / scale;
+    const bool   zSet   = spec.z_min_nm != 0.0 || spec.z_max_nm != 0.0;
+    const double zMin   = zSet ? spec.z_min_nm : z0 / scale + spec.map_z0_nm;
+    const double zMax   = zSet ? spec.z_max_nm : z1 / scale + spec.map_z0_nm;
+    if (!(rhoMax > 0.0) || !(zMax > zMin))
+        throw std::invalid_argument("AdkRate: empty table extent");
+
+    const double nr = std::max(2.0, std::ceil(rhoMax / spec.cell_nm) + 1);
+    const double nz = std::max(2.0, std::ceil((zMax - zMin) / spec.cell_nm) + 1);
+    if (nr * nz > 1ULL << 28)
+        throw std::invalid_argument("AdkRate: table of " + std::to_string(nr * nz) +
+                                    " nodes; increase cell_nm");
+    std::memcpy(grid_.magic, "MARATE01", sizeof grid_.magic);
+    grid_.nRho = static_cast<std::uint32_t>(nr);
+    grid_.nZ   = static_cast<std::uint32_t>(nz);
+    grid_.rho0 = 0.0;
+    grid_.z0   = zMin * 1e-9;
+    grid_.hRho = rhoMax * 1e-9 / (nr - 1);
+    grid_.hZ   = (zMax - zMin) * 1e-9 / (nz - 1);
+    w_.assign(static_cast<std::size_t>(grid_.nRho) * grid_.nZ, 0.0);
+
+    /*── 3.1  Rows (constant ρ) split over the threads ───────────────────*/
+    const unsigned T = threads ? threads : std::max(1u, std::thread::hardware_concurrency());
+    const double   k = field.pos_unit_m;                           // map units → m
+    std::vector<double>      peakF(T, 0.0), peakW(T, 0.0);
+    std::vector<std::size_t> above(T, 0);
+    auto rows = [&](unsigned t) {
+        for (std::uint32_t i = t; i < grid_.nRho; i += T)
+            for (std::uint32_t j = 0; j < grid_.nZ; ++j) {
+                const double rho = grid_.rho0 + i * grid_.hRho;      // [m]
+                const double z   = grid_.z0   + j * grid_.hZ;
+                double Er, Ez;
+                map.FieldRZ(rho / k, (z - spec.map_z0_nm * 1e-9) / k, Er, Ez);
+                const double F = std::hypot(Er, Ez) * field.e_unit_V_per_m;
+                const double w = rate(F);
+                w_[static_cast<std::size_t>(i) * grid_.nZ + j] = w;
+                peakF[t]  = std::max(peakF[t], F);
+                peakW[t]  = std::max(peakW[t], w);
+                above[t] += F > bsi_;
+            }
+    };
+    std::vector<std::thread> pool;
+    for (unsigned t = 1; t < T; ++t) pool.emplace_back(rows, t);
+    rows(0);
+    for (auto& t : pool) t.join();
+
+    peakField_ = *std::max_element(peakF.begin(), peakF.end());
+    peakRate_  = *std::max_element(peakW.begin(), peakW.end());
+    for (auto a : above) aboveBsi_ += a;
+}
+
+void AdkRateTable::WriteTsv(const std::string& path) const
+{
+    WriteAtomically(path, std::ios::out, [&](std::ofstream& out) {
+        out.precision(17);
+        out << "# ADK rate table (AdkRateTable): rho [m], z [m] from the cone base, w [1/s]\n"
+            << "# rho z w\n";
+        for (std::uint32_t i = 0; i < grid_.nRho; ++i)
+            for (std::uint32_t j = 0; j < grid_.nZ; ++j)
+                out << grid_.rho0 + i * grid_.hRho << '\t' << grid_.z0 + j * grid_.hZ << '\t'
+                    << w_[static_cast<std::size_t>(i) * grid_.nZ + j] << '\n';
+    });
+}
+
+void AdkRateTable::WriteBinary(const std::string& path) const
+{
+    WriteAtomically(path, std::ios::binary, [&](std::ofstream& out) {
+        out.write(reinterpret_cast<const char*>(&grid_), sizeof grid_);
+        out.write(reinterpret_cast<const char*>(w_.data()),
+                  static_cast<std::streamsize>(w_.size() * sizeof(double)));
+    });
+}
+
+void AdkRateTable::Report(std::ostream& os) const
+{
+    os << "  rates " << grid_.nRho << " x " << grid_.nZ << " nodes, h = (" << grid_.hRho
+       << ", " << grid_.hZ << ") m; peak |E| " << peakField_ << " V/m, peak w "
+       << peakRate_ << " 1/s\n";
+    if (aboveBsi_)
+        os << "  rates " << aboveBsi_ << " nodes exceed the barrier-suppression field "
+           << bsi_ << " V/m, where ADK overestimates the rate\n";
+}
@@ -0,0 +1,441 @@
+/**
+ * @file    AxisymmetricSolver.cc
+ * @author  Mohammadreza Zakeri
+ * @date    2026-10-18
+ *
+ * @brief   Multigrid Laplace solve of the cone cell and its field map
+ *          (see AxisymmetricSolver.hh).
+ */
+
+#include "AxisymmetricSolver.hh"
+
+/*────────────────────────────── stdlib ───────────────────────────────────*/
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <stdexcept>
+#include <thread>
+
+/*──────────────────────────── project ────────────────────────────────────*/
+#include "Hashing.hh"
+#include "SolveHash.hh"
+
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr std::uint64_t kMaxNodes      = 1ULL << 26;   ///< Finest grid
+constexpr std::size_t   kParallelNodes = 1u << 15;     ///< Smaller levels stay serial
+constexpr int           kSweeps        = 2;            ///< Pre- and post-smoothing
+constexpr int           kCoarseSweeps  = 20000;        ///< Cap on the coarsest level
+
+/// Cells m·2^L on an axis of length `len` with spacing ≤ `cell`.
+std::uint32_t Cells(double len, double cell, int L)
+{
+    const double block = std::ldexp(cell, L);
+    return static_cast<std::uint32_t>(std::ceil(len / block - 1e-9)) << L;
+}
+
+} // namespace
+
+/*══════════════════════════════════════════════════════════════════════════*/
+/* 1.  Grids                                                                */
+/*══════════════════════════════════════════════════════════════════════════*/
+AxisymmetricSolver::AxisymmetricSolver(const geom::GeometryConfig& cfg)
+: cfg_{cfg}, scale_{1e-9 / cfg.field.pos_unit_m},
+  bicubic_{cfg.field.solve.interpolation == "bicubic"}
+{
+    const auto& s = cfg.field.solve;
+    const auto& c = cfg.cone;
+    if (s.interpolation != "bilinear" && s.interpolation != "bicubic")
+        throw std::invalid_argument("field.solve.interpolation expects bilinear|bicubic, got "
+                                    + s.interpolation);
+    if (!(s.cell_nm > 0.0) || !(s.tolerance > 0.0 && s.tolerance < 1.0) || s.max_cycles < 1)
+        throw std::invalid_argument("field.solve needs cell_nm > 0, 0 < tolerance < 1 "
+                                    "and max_cycles >= 1");
+
+    const double R = s.r_max_nm > 0.0 ? s.r_max_nm : cfg.r_outer_nm;
+    const double Z = c.h_cone_nm + cfg.gap_nm;
+    if (!(cfg.gap_nm > 0.0) || c.h_cone_nm < 0.0 || c.r_tip_nm < 0.0 || !(R > c.r_base_nm))
+        throw std::invalid_argument("field.solve: need gap_nm > 0, h_cone_nm >= 0 and "
+                                    "r_base_nm < r_max_nm");
+
+    // L + 1 levels, the coarsest with ≥ 2 cells on the shorter axis
+    const double n = std::min(R, Z) / s.cell_nm;
+    const int    L = n >= 4.0 ? static_cast<int>(std::floor(std::log2(n / 2.0))) : 0;
+    const std::uint32_t Nr = Cells(R, s.cell_nm, L), Nz = Cells(Z, s.cell_nm, L);
+    if (static_cast<double>(Nr + 1) * (Nz + 1) > kMaxNodes)
+        throw std::invalid_argument("field.solve: grid of " +
+                                    std::to_string(static_cast<double>(Nr + 1) * (Nz + 1)) +
+                                    " nodes; increase cell_nm");
+    if (Z / Nz > cfg.gap_nm)
+        throw std::invalid_argument("field.solve: cell_nm does not resolve gap_nm");
+
+    levels_.resize(L + 1);
+    for (int l = 0; l <= L; ++l) {
+        Level& G = levels_[l];
+        G.nr = (Nr >> l) + 1;
+        G.nz = (Nz >> l) + 1;
+        G.hr = R / (G.nr - 1);
+        G.hz = Z / (G.nz - 1);
+        G.cz = 1.0 / (G.hz * G.hz);
+
+        const double cr = 1.0 / (G.hr * G.hr);
+        G.cE.assign(G.nr, 0.0);  G.cW.assign(G.nr, 0.0);  G.dg.assign(G.nr, 0.0);
+        G.cE[0] = 4.0 * cr;                       // axis: 2 ∂r²φ
+        G.dg[0] = 4.0 * cr + 2.0 * G.cz;
+        for (std::uint32_t i = 1; i + 1 < G.nr; ++i) {
+            G.cE[i] = (1.0 + 0.5 / i) * cr;
+            G.cW[i] = (1.0 - 0.5 / i) * cr;
+            G.dg[i] = 2.0 * cr + 2.0 * G.cz;
+        }
+        G.cW[G.nr - 1] = 2.0 * cr;                // mirror wall
+        G.dg[G.nr - 1] = 2.0 * cr + 2.0 * G.cz;
+
+        const std::size_t N = static_cast<std::size_t>(G.nr) * G.nz;
+        G.phi.assign(N, 0.0);  G.f.assign(N, 0.0);  G.res.assign(N, 0.0);
+        G.fixed.assign(N, 0);
+        for (std::uint32_t j = 0; j < G.nz; ++j) {
+            const double z  = j * G.hz;
+            const double rc = z <= c.h_cone_nm + 1e-9 * Z && c.h_cone_nm > 0.0
+                ? c.r_base_nm + (c.r_tip_nm - c.r_base_nm) * std::min(z / c.h_cone_nm, 1.0)
+                : -1.0;
+            for (std::uint32_t i = 0; i < G.nr; ++i)
+                G.fixed[j * G.nr + i] = j == 0 || j + 1 == G.nz || i * G.hr <= rc + 1e-9 * R;
+        }
+    }
+
+    // Finest level: electrodes at their voltage, a linear ramp in between
+    const Level& F = levels_[0];
+    phi_.resize(F.phi.size());
+    for (std::uint32_t j = 0; j < F.nz; ++j)
+        for (std::uint32_t i = 0; i < F.nr; ++i) {
+            const std::size_t k = static_cast<std::size_t>(j) * F.nr + i;
+            phi_[k] = j + 1 == F.nz ? s.v_anode_V
+                    : F.fixed[k]    ? s.v_cone_V
+                    : s.v_cone_V + (s.v_anode_V - s.v_cone_V) * j / (F.nz - 1.0);
+        }
+}
+
+/*══════════════════════════════════════════════════════════════════════════*/
+/* 2.  Multigrid                                                            */
+/*══════════════════════════════════════════════════════════════════════════*/
+template <class F>
+void AxisymmetricSolver::Rows(const Level& L, F&& fn) const
+{
+    const std::uint32_t rows = L.nz - 2;               // rows 0 and nz−1 are fixed
+    const unsigned      T    = static_cast<std::size_t>(L.nr) * L.nz >= kParallelNodes
+                             ? std::min<unsigned>(threads_, rows) : 1u;
+    if (T <= 1) { fn(1u, L.nz - 1, 0u); return; }
+
+    std::vector<std::thread> pool;
+    for (unsigned t = 1; t < T; ++t)
+        pool.emplace_back(fn, 1 + rows * t / T, 1 + rows * (t + 1) / T, t);
+    fn(1u, 1 + rows / T, 0u);
+    for (auto& t : pool) t.join();
+}
+
+void AxisymmetricSolver::Smooth(Level& L, int sweeps, bool reverse) const
+{
+    const std::uint32_t nr = L.nr;
+    for (int s = 0; s < 2 * sweeps; ++s)
+        Rows(L, [&, colour = (s + reverse) & 1u](std::uint32_t j0, std::uint32_t j1, unsigned) {
+            for (std::uint32_t j = j0; j < j1; ++j) {
+                double*             p  = L.phi.data()   + static_cast<std::size_t>(j) * nr;
+                const double*       f  = L.f.data()     + static_cast<std::size_t>(j) * nr;
+                const std::uint8_t* fx = L.fixed.data() + static_cast<std::size_t>(j) * nr;
+                const double*       dn = p - nr;
+                const double*       up = p + nr;
+                for (std::uint32_t i = (j + colour) & 1u; i < nr; i += 2) {
+                    if (fx[i]) continue;
+                    double s = f[i] + L.cz * (dn[i] + up[i]);
+                    if (i > 0)      s += L.cW[i] * p[i - 1];
+                    if (i + 1 < nr) s += L.cE[i] * p[i + 1];
+                    p[i] = s / L.dg[i];
+                }
+            }
+        });
+}
+
+double AxisymmetricSolver::Residual(const Level& L, const double* v, const double* f,
+                                    double* out) const
+{
+    const std::uint32_t nr = L.nr;
+    std::vector<double> worst(threads_, 0.0);
+    Rows(L, [&](std::uint32_t j0, std::uint32_t j1, unsigned t) {
+        double m = 0.0;
+        for (std::uint32_t j = j0; j < j1; ++j) {
+            const std::size_t row = static_cast<std::size_t>(j) * nr;
+            const double* p  = v + row;
+            const double* dn = p - nr;
+            const double* up = p + nr;
+            for (std::uint32_t i = 0; i < nr; ++i) {
+                double r = 0.0;
+                if (!L.fixed[row + i]) {
+                    r = (f ? f[row + i] : 0.0) + L.cz * (dn[i] + up[i]) - L.dg[i] * p[i];
+                    if (i > 0)      r += L.cW[i] * p[i - 1];
+                    if (i + 1 < nr) r += L.cE[i] * p[i + 1];
+                }
+                out[row + i] = r;
+                m = std::max(m, std::abs(r));
+            }
+        }
+        worst[t] = m;
+    });
+    return *std::max_element(worst.begin(), worst.end());
+}
+
+void AxisymmetricSolver::Restrict(const Level& fine, Level& coarse) const
+{
+    // Full weighting; columns −1 and nr are the mirrors of 1 and nr − 2
+    const std::uint32_t nr = fine.nr;
+    auto at = [&](std::int64_t i, std::uint32_t j) {
+        if (i < 0)                              i = -i;
+        if (i >= static_cast<std::int64_t>(nr)) i = 2 * (nr - 1) - i;
+        return fine.res[static_cast<std::size_t>(j) * nr + i];
+    };
+    std::fill(coarse.phi.begin(), coarse.phi.end(), 0.0);
+    Rows(coarse, [&](std::uint32_t J0, std::uint32_t J1, unsigned) {
+        for (std::uint32_t J = J0; J < J1; ++J)
+            for (std::uint32_t I = 0; I < coarse.nr; ++I) {
+                const std::size_t k = static_cast<std::size_t>(J) * coarse.nr + I;
+                if (coarse.fixed[k]) { coarse.f[k] = 0.0; continue; }
+                const std::int64_t  i = 2 * I;
+                const std::uint32_t j = 2 * J;
+                coarse.f[k] = (4.0 * at(i, j)
+                             + 2.0 * (at(i - 1, j) + at(i + 1, j) + at(i, j - 1) + at(i, j + 1))
+                             + at(i - 1, j - 1) + at(i + 1, j - 1)
+                             + at(i - 1, j + 1) + at(i + 1, j + 1)) / 16.0;
+            }
+    });
+}
+
+void AxisymmetricSolver::Prolong(const Level& coarse, Level& fine) const
+{
+    const std::uint32_t nr = fine.nr, cr = coarse.nr;
+    const double* e = coarse.phi.data();
+    Rows(fine, [&](std::uint32_t j0, std::uint32_t j1, unsigned) {
+        for (std::uint32_t j = j0; j < j1; ++j) {
+            const std::uint32_t J = j / 2, dJ = j & 1u;
+            for (std::uint32_t i = 0; i < nr; ++i) {
+                const std::size_t k = static_cast<std::size_t>(j) * nr + i;
+                if (fine.fixed[k]) continue;
+                const std::uint32_t I = i / 2, dI = i & 1u;
+                const double* a = e + static_cast<std::size_t>(J) * cr + I;
+                const double* b = a + dJ * cr;
+                fine.phi[k] += 0.25 * (a[0] + a[dI] + b[0] + b[dI]);
+            }
+        }
+    });
+}
+
+void AxisymmetricSolver::Cycle(std::size_t l)
+{
+    Level& L = levels_[l];
+    if (l + 1 == levels_.size()) {                    // coarsest: relax it out
+        const double r0 = Residual(L, L.phi.data(), L.f.data(), L.res.data());
+        for (int s = 0; s < kCoarseSweeps && r0 > 0.0; s += 32) {
+            Smooth(L, 32, false);
+            if (Residual(L, L.phi.data(), L.f.data(), L.res.data()) <= 1e-6 * r0) break;
+        }
+        return;
+    }
+    Smooth(L, kSweeps, false);
+    Residual(L, L.phi.data(), L.f.data(), L.res.data());
+    Restrict(L, levels_[l + 1]);
+    Cycle(l + 1);
+    Prolong(levels_[l + 1], L);
+    Smooth(L, kSweeps, true);
+}
+
+void AxisymmetricSolver::Precondition(const std::vector<double>& r, std::vector<double>& z)
+{
+    Level& F = levels_[0];
+    F.f = r;
+    std::fill(F.phi.begin(), F.phi.end(), 0.0);
+    Cycle(0);
+    z = F.phi;
+    ++conv_.cycles;
+}
+
+double AxisymmetricSolver::Dot(const std::vector<double>& a, const std::vector<double>& b) const
+{
+    const Level& F = levels_[0];
+    std::vector<double> part(threads_, 0.0);
+    Rows(F, [&](std::uint32_t j0, std::uint32_t j1, unsigned t) {
+        double s = 0.0;
+        for (std::size_t k = static_cast<std::size_t>(j0) * F.nr; k < std::size_t{j1} * F.nr; ++k)
+            s += a[k] * b[k];
+        part[t] = s;
+    });
+    double s = 0.0;
+    for (double x : part) s += x;
+    return s;
+}
+
+AxisymmetricSolver::Convergence AxisymmetricSolver::Solve(unsigned threads)
+{
+    const auto t0 = std::chrono::steady_clock::now();
+    threads_ = threads ? threads : std::max(1u, std::thread::hardware_concurrency());
+
+    conv_ = Convergence{};
+    conv_.levels  = static_cast<int>(levels_.size());
+    conv_.threads = threads_;
+
+    // BiCGSTAB on A e = r0 (e = 0 on the fixed nodes), right-preconditioned
+    // by one V-cycle.  a = −A·y comes from Residual() with f = 0.
+    const Level&      F = levels_[0];
+    const std::size_t N = phi_.size();
+    const auto&       s = cfg_.field.solve;
+    std::vector<double> r(N), rh, p(N, 0.0), a(N, 0.0), y(N), t(N);
+
+    const double r0    = Residual(F, phi_.data(), nullptr, r.data());
+    const double floor = 1e-13 * F.dg[0] *
+                         std::max({std::abs(s.v_cone_V), std::abs(s.v_anode_V), 1e-300});
+    double res = r0, rho = 1.0, alpha = 1.0, omega = 1.0;
+    rh = r;
+
+    auto update = [&](auto&& fn) {              // threaded loop over the nodes
+        Rows(F, [&](std::uint32_t j0, std::uint32_t j1, unsigned) {
+            for (std::size_t k = std::size_t{j0} * F.nr; k < std::size_t{j1} * F.nr; ++k) fn(k);
+        });
+    };
+
+    while (res > s.tolerance * r0 && res > floor && conv_.cycles + 2 <= s.max_cycles) {
+        const double rhoNew = Dot(rh, r);
+        if (rhoNew == 0.0) break;                      // breakdown: restart
+        const double beta = (rhoNew / rho) * (alpha / omega);
+        rho = rhoNew;
+        update([&](std::size_t k) { p[k] = r[k] + beta * (p[k] + omega * a[k]); });
+
+        Precondition(p, y);
+        Residual(F, y.data(), nullptr, a.data());      // a = −A y
+        alpha = -rho / Dot(rh, a);
+        update([&](std::size_t k) { phi_[k] += alpha * y[k];  r[k] += alpha * a[k]; });
+
+        Precondition(r, y);
+        Residual(F, y.data(), nullptr, t.data());      // t = −A z
+        const double tt = Dot(t, t);
+        omega = tt > 0.0 ? -Dot(t, r) / tt : 0.0;
+        update([&](std::size_t k) { phi_[k] += omega * y[k];  r[k] += omega * t[k]; });
+        if (omega == 0.0) break;
+
+        res = Residual(F, phi_.data(), nullptr, t.data());   // true residual
+    }
+    conv_.residual  = r0 > 0.0 ? res / r0 : 0.0;
+    conv_.converged = res <= s.tolerance * r0 || res <= floor;
+    conv_.seconds  = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    return conv_;
+}
+
+/*══════════════════════════════════════════════════════════════════════════*/
+/* 3.  Results                                                              */
+/*══════════════════════════════════════════════════════════════════════════*/
+double AxisymmetricSolver::Potential(double r_nm, double z_nm) const
+{
+    const Level& F = levels_[0];
+    const double fr = std::clamp(r_nm / F.hr, 0.0, F.nr - 1.0);
+    const double fz = std::clamp(z_nm / F.hz, 0.0, F.nz - 1.0);
+    const std::uint32_t i = std::min<std::uint32_t>(static_cast<std::uint32_t>(fr), F.nr - 2);
+    const std::uint32_t j = std::min<std::uint32_t>(static_cast<std::uint32_t>(fz), F.nz - 2);
+    const double tr = fr - i, tz = fz - j;
+    const double* a = phi_.data() + static_cast<std::size_t>(j) * F.nr + i;
+    const double* b = a + F.nr;
+    return (1 - tz) * ((1 - tr) * a[0] + tr * a[1]) + tz * ((1 - tr) * b[0] + tr * b[1]);
+}
+
+std::shared_ptr<ResampledField> AxisymmetricSolver::FieldMap() const
+{
+    const Level&  F  = levels_[0];
+    const double  k  = 1e9 / cfg_.field.e_unit_V_per_m;     // V/nm → map field units
+    const std::uint32_t nr = F.nr, nz = F.nz;
+    std::vector<double> nodes(2ULL * nr * nz, 0.0);
+
+    for (std::uint32_t j = 0; j < nz; ++j)
+        for (std::uint32_t i = 0; i < nr; ++i) {
+            const std::size_t n = static_cast<std::size_t>(j) * nr + i;
+            const double*     p = phi_.data() + n;
+            const bool electrode = j == 0 || j + 1 == nz;
+            if (F.fixed[n] && !electrode) continue;         // inside the cone
+
+            double Er = 0.0, Ez;
+            if (i > 0 && i + 1 < nr) Er = -(p[1] - p[-1]) / (2.0 * F.hr);
+            if (j == 0)              Ez = -(-3.0 * p[0] + 4.0 * p[nr] - p[2 * nr]) / (2.0 * F.hz);
+            else if (j + 1 == nz)    Ez = -(3.0 * p[0] - 4.0 * p[-static_cast<std::ptrdiff_t>(nr)]
+                                            + p[-2 * static_cast<std::ptrdiff_t>(nr)]) / (2.0 * F.hz);
+            else                     Ez = -(p[nr] - p[-static_cast<std::ptrdiff_t>(nr)]) / (2.0 * F.hz);
+            nodes[2 * n]     = Er * k;
+            nodes[2 * n + 1] = Ez * k;
+        }
+
+    ResampledField::Level L{};
+    L.hr = F.hr * scale_;  L.nr = nr;
+    L.hz = F.hz * scale_;  L.nz = nz;
+    const std::uint64_t h = Hash(cfg_);
+    return std::make_shared<ResampledField>(L, std::move(nodes), bicubic_, h, h);
+}
+
+void AxisymmetricSolver::Report(std::ostream& os) const
+{
+    const Level& F = levels_[0];
+    os << "  solve " << F.nr << " x " << F.nz << " nodes, h = (" << F.hr << ", " << F.hz
+       << ") nm, " << conv_.levels << " levels; " << conv_.cycles << " V-cycles, residual "
+       << conv_.residual << ", " << conv_.seconds << " s on " << conv_.threads << " threads";
+    if (!conv_.converged)
+        os << " (NOT converged to " << cfg_.field.solve.tolerance << ')';
+    os << '\n';
+}
+
+/*══════════════════════════════════════════════════════════════════════════*/
+/* 4.  Cache                                                                */
+/*══════════════════════════════════════════════════════════════════════════*/
+std::uint64_t AxisymmetricSolver::Hash(const geom::GeometryConfig& cfg)
+{
+    return util::SolveHash(cfg);
+}
+
+std::string AxisymmetricSolver::CachePath(const geom::GeometryConfig& cfg)
+{
+    return (fs::path(cfg.field.solve.cache_dir) /
+            ("solve_" + util::HashHex(Hash(cfg)) + ".fgrid")).string();
+}
+
+std::shared_ptr<const ResampledField>
+AxisymmetricSolver::LoadOrSolve(const geom::GeometryConfig& cfg, std::ostream& log, bool rebuild,
+                                unsigned threads)
+{
+    AxisymmetricSolver  solver(cfg);                    // validates before any I/O
+    const std::uint64_t hash = Hash(cfg);
+    const std::string   path = CachePath(cfg);
+
+    if (!rebuild && fs::exists(path)) {
+        try {
+            auto cached = std::make_shared<const ResampledField>(path);
+            if (cached->PosHash() == hash && cached->SpecHash() == hash) {
+                log << "Field solve: " << path << " (cached)\n";
+                cached->Report(log);
+                return cached;
+            }
+        } catch (const std::runtime_error& e) {
+            log << e.what() << " – solving again\n";
+        }
+    }
+
+    solver.Solve(threads);
+    log << "Field solve: cone r_tip " << cfg.cone.r_tip_nm << ", r_base " << cfg.cone.r_base_nm
+        << ", h " << cfg.cone.h_cone_nm << ", gap " << cfg.gap_nm << " nm\n";
+    solver.Report(log);
+    auto built = solver.FieldMap();
+    built->Report(log);
+
+    try {
+        fs::create_directories(cfg.field.solve.cache_dir);
+        built->Write(path);
+        log << "Field solve: wrote " << path << '\n';
+        return std::make_shared<const ResampledField>(path);
+    } catch (const std::exception& e) {
+        log << e.what() << " – keeping the map in memory\n";
+        return built;
+    }
+}
@@ -0,0 +1,287 @@
+/**
+ * @file    BallisticEngine.cc
+ * @author  Mohammadreza Zakeri
+ * @date    2026-10-18
+ *
+ * @brief   Event loop, cone intersection and outcome comparison of
+ *          BallisticEngine.hh.
+ *
+ *  No Geant4 or CLHEP includes appear below.
+ */
+
+#include "BallisticEngine.hh"
+
+/*────────────────────────────── stdlib ───────────────────────────────────*/
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+/*──────────────────────────── project ────────────────────────────────────*/
+#include "EventRandom.hh"
+
+namespace sim {
+
+namespace {
+constexpr double kPi          = 3.14159265358979323846;
+constexpr double kC_nm_per_ns = 299792458.0;   ///< speed of light
+constexpr long   kChunk       = 4096;          ///< events per work item
+}
+
+/*══════════════════════════════════════════════════════════════════════════*/
+/* 1.  Tallies                                                              */
+/*══════════════════════════════════════════════════════════════════════════*/
+void BallisticTally::Add(const BallisticTally& o)
+{
+    auto add = [](std::vector<unsigned>& a, const std::vector<unsigned>& b)
+    { for (std::size_t i = 0; i < a.size() && i < b.size(); ++i) a[i] += b[i]; };
+    add(coneIon,  o.coneIon);   add(coneCap,  o.coneCap);
+    add(panelIon, o.panelIon);  add(panelCap, o.panelCap);
+    nEvents      += o.nEvents;
+    nIon         += o.nIon;
+    nCap         += o.nCap;
+    nTransmitted += o.nTransmitted;
+    weights.Add(o.weights);
+}
+
+/*══════════════════════════════════════════════════════════════════════════*/
+/* 2.  Construction                                                         */
+/*══════════════════════════════════════════════════════════════════════════*/
+BallisticEngine::BallisticEngine(const geom::GeometryConfig& cfg,
+                                 const RunConfig&            run,
+                                 const RateProvider&         rates)
+: cfg_{cfg}, run_{run}, rates_{rates}, grid_{cfg, 0.0}
+{
+    if (run.Biased() || run.Qmc() || run.Stratified() || run.stop.Sequential())
+        throw std::invalid_argument("BallisticEngine: --bias, --sampler=sobol, --strata "
+                                    "and --target-rel-error are not supported");
+    if (cfg.field.Active())
+        throw std::invalid_argument("BallisticEngine: electric fields are not "
+                                    "supported (straight lines only)");
+    if (cfg.importance.Active())
+        throw std::invalid_argument("BallisticEngine: geometry importances are not "
+                                    "supported (nothing to split on a straight line)");
+
+    const double gamma = 1.0 + run.beam.energy_MeV / kMuAlphaMass_MeV;
+    speed_nm_per_ns_   = kC_nm_per_ns * std::sqrt(1.0 - 1.0 / (gamma * gamma));
+}
+
+BallisticTally BallisticEngine::Empty() const
+{
+    BallisticTally t;
+    t.coneIon.assign(cfg_.nCones(), 0);
+    t.coneCap.assign(cfg_.nCones(), 0);
+    t.panelIon.assign(cfg_.nPanels(), 0);
+    t.panelCap.assign(cfg_.nPanels(), 0);
+    return t;
+}
+
+/*══════════════════════════════════════════════════════════════════════════*/
+/* 3.  Ray / truncated cone                                                 */
+/*══════════════════════════════════════════════════════════════════════════*/
+/*  Cone-local frame: axis through (x, y), z' = z − base.  The solid is
+ *      x'² + y'² ≤ R(z')²,   R(z') = R_b + s·z',  s = (R_t − R_b)/h,  0 ≤ z' ≤ h.
+ *  Along the ray f(t) = A t² + 2B t + C ≤ 0 describes a double cone; its
+ *  second nappe lies beyond the apex (R < 0), i.e. outside the slab.       */
+bool BallisticEngine::ConeEntry(const geom::ShellColumn& c,
+                                const double o[3], const double d[3],
+                                double t0, double t1, double& tHit) const noexcept
+{
+    const double h  = cfg_.cone.h_cone_nm;
+    const double s  = (cfg_.cone.r_tip_nm - cfg_.cone.r_base_nm) / h;
+    const double px = o[0] - c.x_nm, py = o[1] - c.y_nm;
+    const double pz = o[2] - (c.z_lo_nm + cfg_.gap_nm);
+
+    /*── 3.1  Axial slab 0 ≤ z' ≤ h, clipped to the column chord ─────*/
+    double lo = t0, hi = t1;
+    if (d[2] == 0.0)
+    {
+        if (pz < 0.0 || pz > h) return false;
+    }
+    else
+    {
+        double ta = -pz / d[2], tb = (h - pz) / d[2];
+        if (ta > tb) std::swap(ta, tb);
+        lo = std::max(lo, ta);
+        hi = std::min(hi, tb);
+    }
+    if (lo > hi) return false;
+
+    /*── 3.2  Quadric  f(t) ≤ 0  intersected with [lo, hi] ────────────*/
+    const double R0 = cfg_.cone.r_base_nm + s * pz;   // radius at the origin's z'
+    const double dR = s * d[2];                       // radius change per unit t
+    const double A  = d[0] * d[0] + d[1] * d[1] - dR * dR;
+    const double B  = px * d[0] + py * d[1] - R0 * dR;
+    const double C  = px * px + py * py - R0 * R0;
+
+    auto first = [&](double a, double b) {           // earliest t of [a, b] ∩ [lo, hi]
+        a = std::max(a, lo);
+        if (a > std::min(b, hi)) return false;
+        tHit = a;
+        return true;
+    };
+    constexpr double kInf = HUGE_VAL;
+
+    if (A == 0.0)                                     // ray parallel to a generator
+    {
+        if (B == 0.0) return C <= 0.0 && first(lo, hi);
+        const double r = -C / (2.0 * B);
+        return B > 0.0 ? first(-kInf, r) : first(r, kInf);
+    }
+
+    const double disc = B * B - A * C;
+    if (A > 0.0)                                      // f ≤ 0 between the roots
+    {
+        if (disc < 0.0) return false;
+        const double q = std::sqrt(disc);
+        return first((-B - q) / A, (-B + q) / A);
+    }
+    if (disc < 0.0) return first(lo, hi);             // A < 0: f < 0 everywhere
+    const double q = std::sqrt(disc);                 // A < 0: outside the roots
+    return first(-kInf, (-B + q) / A) || first((-B - q) / A, kInf);
+}
+
+/*══════════════════════════════════════════════════════════════════════════*/
+/* 4.  One event                                                            */
+/*══════════════════════════════════════════════════════════════════════════*/
+std::uint8_t BallisticEngine::Event(long global, BallisticTally& t,
+                                    std::vector<geom::ColumnGrid::Crossing>& xs) const
+{
+    /*── 4.1  Primary: same draws, same order as PrimaryGenerator ────────*/
+    const bool  philox = run_.rng == RngKind::Philox;
+    EventStream prim(run_.seed, static_cast<std::uint64_t>(global), Stream::Primary,    philox);
+    EventStream ion (run_.seed, static_cast<std::uint64_t>(global), Stream::Ionization, philox);
+
+    const BeamSpec& beam = run_.beam;
+    const double r     = beam.sigma_nm * std::sqrt(-2.0 * std::log(prim.Uniform()));
+    const double phi   = 2.0 * kPi * prim.Uniform();
+    const double theta = beam.max_theta_deg * kPi / 180.0 * prim.Uniform();
+    const double psi   = 2.0 * kPi * prim.Uniform();
+
+    const double o[3] = {beam.x0_nm, r * std::cos(phi), beam.z0_nm + r * std::sin(phi)};
+    const double d[3] = {std::cos(theta),
+                         std::sin(theta) * std::cos(psi),
+                         std::sin(theta) * std::sin(psi)};
+
+    ++t.nEvents;
+    grid_.Crossings(o, d, xs);
+    if (xs.empty() && run_.rayCull) ++t.nTransmitted;   // StackingAction's count
+
+    /*── 4.2  Shell columns in flight order ──────────────────────────────*/
+    std::uint8_t flags = 0;
+    double w = 1.0, ionScore = 0.0, capScore = 0.0;
+    for (const auto& x : xs)
+    {
+        const geom::ShellColumn& c = grid_.Column(static_cast<std::size_t>(x.column));
+
+        double tCone;
+        if (ConeEntry(c, o, d, x.tIn, x.tOut, tCone))
+        {
+            ++t.coneCap[x.column];
+            ++t.panelCap[c.panel];
+            ++t.nCap;
+            capScore += w;
+            flags    |= BallisticTally::kCap;
+            break;
+        }
+
+        /* chord endpoints, cone-local [m]; crossing time in Geant4 units (ns) */
+        const double zb = c.z_lo_nm + cfg_.gap_nm;
+        const double p0[3] = {1e-9 * (o[0] + x.tIn  * d[0] - c.x_nm),
+                              1e-9 * (o[1] + x.tIn  * d[1] - c.y_nm),
+                              1e-9 * (o[2] + x.tIn  * d[2] - zb)};
+        const double p1[3] = {1e-9 * (o[0] + x.tOut * d[0] - c.x_nm),
+                              1e-9 * (o[1] + x.tOut * d[1] - c.y_nm),
+                              1e-9 * (o[2] + x.tOut * d[2] - zb)};
+        const double Pint = CrossingProbability(rates_, p0, p1,
+                                                (x.tOut - x.tIn) / speed_nm_per_ns_);
+
+        if (run_.forceIon)
+        {
+            ionScore += w * Pint;
+            w        *= 1.0 - Pint;
+            if (Pint >= 1.0) break;
+        }
+        else if (ion.Uniform() < Pint)
+        {
+            ++t.coneIon[x.column];
+            ++t.panelIon[c.panel];
+            ++t.nIon;
+            flags |= BallisticTally::kIon;
+            break;
+        }
+    }
+
+    if (run_.forceIon)
+    {
+        auto& W = t.weights;
+        W.w   += 1.0;       W.w2   += 1.0;
+        W.ion += ionScore;  W.ion2 += ionScore * ionScore;
+        W.cap += capScore;  W.cap2 += capScore * capScore;
+        W.ionCap += ionScore * capScore;
+    }
+    return flags;
+}
+
+/*══════════════════════════════════════════════════════════════════════════*/
+/* 5.  Event loop                                                           */
+/*══════════════════════════════════════════════════════════════════════════*/
+BallisticTally BallisticEngine::Run(unsigned threads) const
+{
+    const auto start = std::chrono::steady_clock::now();
+    const long n     = run_.nEvents;
+    threads          = std::max(1u, threads);
+
+    BallisticTally total = Empty();
+    if (run_.crn) total.outcomes.assign(static_cast<std::size_t>(n), 0);
+
+    /* work items of kChunk events; every event writes its own outcome byte */
+    std::atomic<long>           next {0};
+    std::vector<BallisticTally> parts(threads, Empty());
+    auto worker = [&](unsigned id)
+    {
+        std::vector<geom::ColumnGrid::Crossing> xs;
+        for (long lo; (lo = next.fetch_add(kChunk)) < n; )
+            for (long i = lo; i < std::min(n, lo + kChunk); ++i)
+            {
+                const std::uint8_t f = Event(run_.firstEvent + i, parts[id], xs);
+                if (run_.crn) total.outcomes[static_cast<std::size_t>(i)] = f;
+            }
+    };
+
+    std::vector<std::thread> pool;
+    for (unsigned id = 1; id < threads; ++id) pool.emplace_back(worker, id);
+    worker(0);
+    for (auto& th : pool) th.join();
+
+    for (const auto& p : parts) total.Add(p);
+    total.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return total;
+}
+
+/*══════════════════════════════════════════════════════════════════════════*/
+/* 6.  Paired comparison                                                    */
+/*══════════════════════════════════════════════════════════════════════════*/
+OutcomeComparison CompareOutcomes(const std::vector<std::uint8_t>& geant4,
+                                  const std::vector<std::uint8_t>& ballistic)
+{
+    if (geant4.size() != ballistic.size())
+        throw std::invalid_argument("CompareOutcomes: outcome arrays differ in length");
+
+    OutcomeComparison c;
+    c.n = geant4.size();
+    for (std::size_t i = 0; i < geant4.size(); ++i)
+    {
+        const bool iG = geant4[i] & BallisticTally::kIon, iB = ballistic[i] & BallisticTally::kIon;
+        const bool cG = geant4[i] & BallisticTally::kCap, cB = ballistic[i] & BallisticTally::kCap;
+        c.agree      += geant4[i] == ballistic[i];
+        c.ionG4      += iG;         c.ionBal     += iB;
+        c.capG4      += cG;         c.capBal     += cB;
+        c.ionOnlyG4  += iG && !iB;  c.ionOnlyBal += iB && !iG;
+        c.capOnlyG4  += cG && !cB;  c.capOnlyBal += cB && !cG;
+    }
+    return c;
+}
+
+} // namespace sim
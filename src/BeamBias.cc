@@ -0,0 +1,144 @@
+/**
+ * @file    BeamBias.cc
+ * @author  Mohammadreza Zakeri
+ * @date    2026-10-18
+ *
+ * @brief   Focus window, exact P(U) and cell sampler of BeamBias.hh.
+ *
+ *  No Geant4 or CLHEP includes appear below.
+ */
+
+#include "BeamBias.hh"
+
+/*────────────────────────────── stdlib ───────────────────────────────────*/
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace sim {
+
+/*══════════════════════════════════════════════════════════════════════════*/
+/* 1.  Normal CDF and its inverse                                           */
+/*══════════════════════════════════════════════════════════════════════════*/
+namespace {
+
+double Phi(double x) noexcept { return 0.5 * std::erfc(-x * 0.7071067811865476); }
+
+/** Acklam's rational approximation, polished by one Halley step. */
+double PhiInv(double p) noexcept
+{
+    static constexpr double a[] = {-3.969683028665376e+01,  2.209460984245205e+02,
+                                   -2.759285104469687e+02,  1.383577518672690e+02,
+                                   -3.066479806614716e+01,  2.506628277459239e+00};
+    static constexpr double b[] = {-5.447609879822406e+01,  1.615858368580409e+02,
+                                   -1.556989798598866e+02,  6.680131188771972e+01,
+                                   -1.328068155288572e+01};
+    static constexpr double c[] = {-7.784894002430293e-03, -3.223964580411365e-01,
+                                   -2.400758277161838e+00, -2.549732539343734e+00,
+                                    4.374664141464968e+00,  2.938163982698783e+00};
+    static constexpr double d[] = { 7.784695709041462e-03,  3.224671290700398e-01,
+                                    2.445134137142996e+00,  3.754408661907416e+00};
+
+    p = std::clamp(p, 1e-300, 1.0 - 1e-16);
+    double x;
+    if (p < 0.02425) {
+        const double q = std::sqrt(-2.0 * std::log(p));
+        x = (((((c[0]*q + c[1])*q + c[2])*q + c[3])*q + c[4])*q + c[5]) /
+            ((((d[0]*q + d[1])*q + d[2])*q + d[3])*q + 1.0);
+    } else if (p > 1.0 - 0.02425) {
+        const double q = std::sqrt(-2.0 * std::log1p(-p));
+        x = -(((((c[0]*q + c[1])*q + c[2])*q + c[3])*q + c[4])*q + c[5]) /
+             ((((d[0]*q + d[1])*q + d[2])*q + d[3])*q + 1.0);
+    } else {
+        const double q = p - 0.5, r = q * q;
+        x = (((((a[0]*r + a[1])*r + a[2])*r + a[3])*r + a[4])*r + a[5]) * q /
+            (((((b[0]*r + b[1])*r + b[2])*r + b[3])*r + b[4])*r + 1.0);
+    }
+    const double e = Phi(x) - p;                         // Halley step
+    const double u = e * 2.5066282746310002 * std::exp(0.5 * x * x);
+    return x - u / (1.0 + 0.5 * x * u);
+}
+
+/** Inverse-CDF draw of a normal(mu, sigma) truncated to [lo, hi]. */
+double TruncatedNormal(double mu, double sigma, double lo, double hi, double u) noexcept
+{
+    const double a = Phi((lo - mu) / sigma), b = Phi((hi - mu) / sigma);
+    return std::clamp(mu + sigma * PhiInv(a + u * (b - a)), lo, hi);
+}
+
+} // namespace
+
+/*══════════════════════════════════════════════════════════════════════════*/
+/* 2.  Construction: focus window U, disjoint cells, P(U)                   */
+/*══════════════════════════════════════════════════════════════════════════*/
+FocusedBeam::FocusedBeam(const geom::GeometryConfig& cfg, const BeamSpec& beam,
+                         double fraction)
+: f_{fraction}, muY_{0.0}, muZ_{beam.z0_nm}, sigma_{beam.sigma_nm}
+{
+    if (!(f_ >= 0.0 && f_ < 1.0))
+        throw std::invalid_argument("BeamBias: --bias must lie in [0, 1)");
+
+    /*── 2.1  Start-plane window of every reachable column ─────────────*/
+    const double tanT = std::tan(beam.max_theta_deg * 3.14159265358979323846 / 180.0);
+    for (const auto& c : geom::ShellColumns(cfg))
+    {
+        const double reach = c.x_nm + c.r_nm - beam.x0_nm;
+        if (reach <= 0.0) continue;                      // behind the source
+        const double drift = reach * tanT;
+        rects_.push_back({c.y_nm - c.r_nm - drift, c.y_nm + c.r_nm + drift,
+                          c.z_lo_nm - drift,       c.z_hi_nm + drift});
+    }
+
+    /*── 2.2  Cut the union into disjoint cells on the edge grid ───────*/
+    std::vector<double> ys, zs;
+    for (const auto& r : rects_) { ys.insert(ys.end(), {r.y0, r.y1}); zs.insert(zs.end(), {r.z0, r.z1}); }
+    std::sort(ys.begin(), ys.end());  ys.erase(std::unique(ys.begin(), ys.end()), ys.end());
+    std::sort(zs.begin(), zs.end());  zs.erase(std::unique(zs.begin(), zs.end()), zs.end());
+
+    std::vector<double> py(ys.size()), pz(zs.size());
+    for (std::size_t i = 0; i < ys.size(); ++i) py[i] = Phi((ys[i] - muY_) / sigma_);
+    for (std::size_t j = 0; j < zs.size(); ++j) pz[j] = Phi((zs[j] - muZ_) / sigma_);
+
+    for (std::size_t i = 0; i + 1 < ys.size(); ++i)
+        for (std::size_t j = 0; j + 1 < zs.size(); ++j)
+        {
+            const double mass = (py[i + 1] - py[i]) * (pz[j + 1] - pz[j]);
+            if (mass <= 0.0 || !Inside(0.5 * (ys[i] + ys[i + 1]), 0.5 * (zs[j] + zs[j + 1])))
+                continue;
+            pU_ += mass;
+            cells_.push_back({ys[i], ys[i + 1], zs[j], zs[j + 1], pU_});
+        }
+
+    if (f_ > 0.0 && pU_ <= 0.0)
+        throw std::runtime_error("BeamBias: no shell column is reachable from the beam");
+}
+
+/*══════════════════════════════════════════════════════════════════════════*/
+/* 3.  Weight + sampling                                                    */
+/*══════════════════════════════════════════════════════════════════════════*/
+bool FocusedBeam::Inside(double y, double z) const noexcept
+{
+    for (const auto& r : rects_)
+        if (y >= r.y0 && y <= r.y1 && z >= r.z0 && z <= r.z1) return true;
+    return false;
+}
+
+double FocusedBeam::Weight(double y, double z) const noexcept
+{
+    const double q = (1.0 - f_) + (f_ > 0.0 && Inside(y, z) ? f_ / pU_ : 0.0);
+    return 1.0 / q;
+}
+
+void FocusedBeam::SampleFocused(double uCell, double uy, double uz,
+                                double& y, double& z) const noexcept
+{
+    const double target = uCell * pU_;
+    auto it = std::upper_bound(cells_.begin(), cells_.end(), target,
+                               [](double t, const Cell& c) { return t < c.cum; });
+    if (it == cells_.end()) --it;
+
+    y = TruncatedNormal(muY_, sigma_, it->y0, it->y1, uy);
+    z = TruncatedNormal(muZ_, sigma_, it->z0, it->z1, uz);
+}
+
+} // namespace sim
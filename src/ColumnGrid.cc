@@ -0,0 +1,193 @@
+/**
+ * @file    ColumnGrid.cc
+ * @author  Mohammadreza Zakeri
+ * @date    2026-10-18
+ *
+ * @brief   Cell list and ray walk of ColumnGrid.hh.
+ *
+ *  No Geant4 or CLHEP includes appear below.
+ */
+
+#include "ColumnGrid.hh"
+
+/*────────────────────────────── stdlib ───────────────────────────────────*/
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace geom {
+
+namespace {
+constexpr double kInf     = std::numeric_limits<double>::infinity();
+constexpr int    kMaxCells = 1024;   ///< per axis; wider layouts get bigger cells
+}
+
+/*══════════════════════════════════════════════════════════════════════════*/
+/* 1.  Construction: widen the columns, bin their footprints                */
+/*══════════════════════════════════════════════════════════════════════════*/
+ColumnGrid::ColumnGrid(const GeometryConfig& cfg, double margin_nm)
+: cols_{ShellColumns(cfg)}, margin_{margin_nm}
+{
+    if (cols_.empty()) return;
+
+    double x1 = -kInf, y1 = -kInf;
+    x0_ = y0_ = kInf;
+    for (auto& c : cols_)
+    {
+        c.r_nm    += margin_;
+        c.z_lo_nm -= margin_;
+        c.z_hi_nm += margin_;
+        x0_ = std::min(x0_, c.x_nm - c.r_nm);  x1 = std::max(x1, c.x_nm + c.r_nm);
+        y0_ = std::min(y0_, c.y_nm - c.r_nm);  y1 = std::max(y1, c.y_nm + c.r_nm);
+    }
+
+    h_ = std::max(2.0 * cols_.front().r_nm,
+                  std::max(x1 - x0_, y1 - y0_) / kMaxCells);
+    nx_ = std::max(1, static_cast<int>(std::ceil((x1 - x0_) / h_)));
+    ny_ = std::max(1, static_cast<int>(std::ceil((y1 - y0_) / h_)));
+    cells_.assign(static_cast<std::size_t>(nx_) * ny_, {});
+
+    auto clampX = [&](double x) { return std::clamp(static_cast<int>(std::floor((x - x0_) / h_)), 0, nx_ - 1); };
+    auto clampY = [&](double y) { return std::clamp(static_cast<int>(std::floor((y - y0_) / h_)), 0, ny_ - 1); };
+
+    for (std::size_t k = 0; k < cols_.size(); ++k)
+    {
+        const auto& c = cols_[k];
+        for (int iy = clampY(c.y_nm - c.r_nm); iy <= clampY(c.y_nm + c.r_nm); ++iy)
+            for (int ix = clampX(c.x_nm - c.r_nm); ix <= clampX(c.x_nm + c.r_nm); ++ix)
+                cells_[iy * nx_ + ix].push_back(static_cast<int>(k));
+    }
+}
+
+/*══════════════════════════════════════════════════════════════════════════*/
+/* 2.  Exact ray / finite z-aligned cylinder chord                          */
+/*══════════════════════════════════════════════════════════════════════════*/
+bool ColumnGrid::Chord(const ShellColumn& c, const double o[3], const double d[3],
+                       double& tIn, double& tOut) const noexcept
+{
+    double t0 = 0.0, t1 = kInf;
+
+    /* radial: |(o − axis) + t·d|² ≤ r² in (x, y) */
+    const double px = o[0] - c.x_nm, py = o[1] - c.y_nm;
+    const double a  = d[0] * d[0] + d[1] * d[1];
+    const double cc = px * px + py * py - c.r_nm * c.r_nm;
+    if (a == 0.0)
+    {
+        if (cc > 0.0) return false;                     // parallel, outside
+    }
+    else
+    {
+        const double b    = px * d[0] + py * d[1];      // half the linear term
+        const double disc = b * b - a * cc;
+        if (disc < 0.0) return false;
+        const double s = std::sqrt(disc);
+        t0 = std::max(t0, (-b - s) / a);
+        t1 = std::min(t1, (-b + s) / a);
+    }
+
+    /* axial slab */
+    if (d[2] == 0.0)
+    {
+        if (o[2] < c.z_lo_nm || o[2] > c.z_hi_nm) return false;
+    }
+    else
+    {
+        double ta = (c.z_lo_nm - o[2]) / d[2], tb = (c.z_hi_nm - o[2]) / d[2];
+        if (ta > tb) std::swap(ta, tb);
+        t0 = std::max(t0, ta);
+        t1 = std::min(t1, tb);
+    }
+    tIn = t0;  tOut = t1;
+    return t0 <= t1;
+}
+
+/*══════════════════════════════════════════════════════════════════════════*/
+/* 3.  Ray walk (Amanatides–Woo in the x-y plane)                           */
+/*══════════════════════════════════════════════════════════════════════════*/
+/* Calls visit(cell) for every cell the ray crosses, in order, until visit
+   returns true (→ true) or the ray leaves the grid (→ false). */
+template <class Visit>
+bool ColumnGrid::Walk(const double o[3], const double d[3], Visit&& visit) const
+{
+    if (cells_.empty()) return false;
+
+    /*── 3.1  Clip to the grid rectangle, t ≥ 0 ────────────────────────*/
+    double tIn = 0.0, tOut = kInf;
+    const double lo[2] = {x0_, y0_}, hi[2] = {x0_ + nx_ * h_, y0_ + ny_ * h_};
+    for (int k = 0; k < 2; ++k)
+    {
+        if (d[k] == 0.0)
+        {
+            if (o[k] < lo[k] || o[k] > hi[k]) return false;
+            continue;
+        }
+        double ta = (lo[k] - o[k]) / d[k], tb = (hi[k] - o[k]) / d[k];
+        if (ta > tb) std::swap(ta, tb);
+        tIn  = std::max(tIn, ta);
+        tOut = std::min(tOut, tb);
+    }
+    if (tIn > tOut) return false;
+
+    /*── 3.2  Starting cell + per-axis stepping state ─────────────────*/
+    int ix = std::clamp(static_cast<int>(std::floor((o[0] + tIn * d[0] - x0_) / h_)), 0, nx_ - 1);
+    int iy = std::clamp(static_cast<int>(std::floor((o[1] + tIn * d[1] - y0_) / h_)), 0, ny_ - 1);
+
+    const int sx = d[0] > 0.0 ? 1 : -1, sy = d[1] > 0.0 ? 1 : -1;
+    double tMaxX = d[0] == 0.0 ? kInf : (x0_ + (ix + (sx > 0)) * h_ - o[0]) / d[0];
+    double tMaxY = d[1] == 0.0 ? kInf : (y0_ + (iy + (sy > 0)) * h_ - o[1]) / d[1];
+    const double dX = d[0] == 0.0 ? kInf : h_ / std::abs(d[0]);
+    const double dY = d[1] == 0.0 ? kInf : h_ / std::abs(d[1]);
+
+    /*── 3.3  Visit cells until the visitor stops or the ray leaves ───*/
+    for (;;)
+    {
+        if (visit(Cell(ix, iy))) return true;
+
+        if (tMaxX < tMaxY)
+        {
+            if (tMaxX >= tOut) return false;
+            ix += sx;  tMaxX += dX;
+        }
+        else
+        {
+            if (tMaxY >= tOut) return false;     // also ends a ray along z
+            iy += sy;  tMaxY += dY;
+        }
+        if (ix < 0 || ix >= nx_ || iy < 0 || iy >= ny_) return false;
+    }
+}
+
+/*══════════════════════════════════════════════════════════════════════════*/
+/* 4.  Queries                                                              */
+/*══════════════════════════════════════════════════════════════════════════*/
+bool ColumnGrid::Hits(const double o[3], const double d[3]) const noexcept
+{
+    return Walk(o, d, [&](const std::vector<int>& cell) {
+        double t0, t1;
+        for (int k : cell)
+            if (Chord(cols_[k], o, d, t0, t1)) return true;
+        return false;
+    });
+}
+
+void ColumnGrid::Crossings(const double o[3], const double d[3],
+                           std::vector<Crossing>& out) const
+{
+    out.clear();
+    Walk(o, d, [&](const std::vector<int>& cell) {
+        double t0, t1;
+        for (int k : cell)
+        {
+            /* a column straddles up to four cells: keep the first visit */
+            if (std::any_of(out.begin(), out.end(),
+                            [k](const Crossing& x) { return x.column == k; }))
+                continue;
+            if (Chord(cols_[k], o, d, t0, t1)) out.push_back({k, t0, t1});
+        }
+        return false;
+    });
+    std::sort(out.begin(), out.end(),
+              [](const Crossing& a, const Crossing& b) { return a.tIn < b.tIn; });
+}
+
+} // namespace geom
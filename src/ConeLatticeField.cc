@@ -0,0 +1,210 @@
+/**
+ * @file    ConeLatticeField.cc
+ * @author  Mohammadreza Zakeri
+ * @date    2026-10-18
+ *
+ * @brief   Decay envelope, cell list and K-nearest superposition of
+ *          ConeLatticeField.hh.
+ */
+
+#include "ConeLatticeField.hh"
+
+/*────────────────────────────── stdlib ───────────────────────────────────*/
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+namespace {
+constexpr double kInf      = std::numeric_limits<double>::infinity();
+constexpr int    kMaxCells = 1024;   ///< per axis; wider layouts get bigger cells
+constexpr int    kRaster   = 256;    ///< (r, z) samples per axis of the envelope
+}
+
+/*══════════════════════════════════════════════════════════════════════════*/
+/* 1.  Construction                                                         */
+/*══════════════════════════════════════════════════════════════════════════*/
+ConeLatticeField::ConeLatticeField(std::shared_ptr<const AxisymmetricField> map,
+                                   std::vector<Cone> cones, const geom::FieldSpec& f)
+: map_{std::move(map)}, cones_{std::move(cones)},
+  k_{f.lattice.k_nearest}, bg_{f.lattice.background_ez},
+  scale_{1e-9 / f.pos_unit_m}
+{
+    const auto& l = f.lattice;
+    if (!map_ || cones_.empty())
+        throw std::invalid_argument("field.lattice: no map or no cones");
+    if (k_ < 1 || k_ > kMaxNearest)
+        throw std::invalid_argument("field.lattice: k_nearest must be in 1.." +
+                                    std::to_string(kMaxNearest));
+    if (!(l.tolerance > 0.0 && l.tolerance < 1.0) || !(l.cutoff_nm >= 0.0))
+        throw std::invalid_argument("field.lattice: need 0 < tolerance < 1 and cutoff_nm >= 0");
+
+    double r0;
+    map_->Bounds(r0, r1_, z0_, z1_);
+    if (!(r1_ > 0.0 && z1_ > z0_))
+        throw std::invalid_argument("field.lattice: the map has no extent");
+
+    for (auto& c : cones_) {                   // base centre → map origin
+        c.x += f.origin_nm.x_nm;
+        c.y += f.origin_nm.y_nm;
+        c.z += f.origin_nm.z_nm;
+    }
+
+    Envelope(l.tolerance, l.cutoff_nm);
+    BuildCells();
+    acc_.crowd = Crowd();
+}
+
+/*──────────────────────── decay envelope D(ρ) ────────────────────────────*/
+void ConeLatticeField::Envelope(double tolerance, double cutoff_nm)
+{
+    // D[i] = max |δE| over the raster columns i … kRaster−1 (all z)
+    std::vector<double> D(kRaster, 0.0);
+    const double hr = r1_ / (kRaster - 1), hz = (z1_ - z0_) / (kRaster - 1);
+    for (int i = 0; i < kRaster; ++i)
+        for (int j = 0; j < kRaster; ++j) {
+            double Er, Ez;
+            map_->FieldRZ(i * hr, z0_ + j * hz, Er, Ez);
+            D[i] = std::max(D[i], std::hypot(Er, Ez - bg_));
+        }
+    for (int i = kRaster - 2; i >= 0; --i) D[i] = std::max(D[i], D[i + 1]);
+
+    acc_.peak    = D[0];
+    acc_.edge_nm = r1_ / scale_;
+    if (acc_.peak <= 0.0)
+        throw std::invalid_argument("field.lattice: the map equals background_ez everywhere");
+
+    int i = 0;
+    if (cutoff_nm > 0.0)
+        i = static_cast<int>(std::floor(cutoff_nm * scale_ / hr));   // D[i] ≥ D(ρ_c)
+    else
+        while (i < kRaster && D[i] > tolerance * acc_.peak) ++i;
+
+    acc_.capped = i >= kRaster;                // beyond the map a cone adds nothing
+    i = std::min(i, kRaster - 1);
+    acc_.tail      = D[i];
+    acc_.cutoff_nm = cutoff_nm > 0.0 && !acc_.capped ? cutoff_nm : i * hr / scale_;
+    cut2_ = acc_.cutoff_nm * acc_.cutoff_nm;
+
+    // Σ D(ρ) of the cones the cutoff drops, on the most central axis
+    double cx = 0.0, cy = 0.0;
+    for (const auto& c : cones_) { cx += c.x;  cy += c.y; }
+    cx /= cones_.size();  cy /= cones_.size();
+    const Cone* mid = &*std::min_element(cones_.begin(), cones_.end(),
+        [&](const Cone& a, const Cone& b) {
+            return std::hypot(a.x - cx, a.y - cy) < std::hypot(b.x - cx, b.y - cy);
+        });
+    for (const auto& c : cones_) {
+        const double rho = std::hypot(c.x - mid->x, c.y - mid->y);
+        const int    k   = static_cast<int>(std::floor(rho * scale_ / hr));
+        if (rho * rho > cut2_ && k < kRaster) acc_.sum += D[k];
+    }
+}
+
+/*──────────────────── cell list of the cone axes ─────────────────────────*/
+void ConeLatticeField::BuildCells()
+{
+    double x1 = -kInf, y1 = -kInf;
+    x0_ = y0_ = kInf;
+    for (const auto& c : cones_) {
+        x0_ = std::min(x0_, c.x);  x1 = std::max(x1, c.x);
+        y0_ = std::min(y0_, c.y);  y1 = std::max(y1, c.y);
+    }
+
+    // Side ≥ ρ_c, so the 3 × 3 block around a query holds every candidate.
+    h_ = std::max({acc_.cutoff_nm, std::max(x1 - x0_, y1 - y0_) / kMaxCells, 1e-6});
+    nx_ = std::max(1, static_cast<int>(std::ceil((x1 - x0_) / h_)));
+    ny_ = std::max(1, static_cast<int>(std::ceil((y1 - y0_) / h_)));
+    cells_.assign(static_cast<std::size_t>(nx_) * ny_, {});
+
+    for (std::size_t k = 0; k < cones_.size(); ++k)
+        cells_[CellY(cones_[k].y) * nx_ + CellX(cones_[k].x)].push_back(static_cast<int>(k));
+}
+
+int ConeLatticeField::CellX(double x) const noexcept
+{
+    return std::clamp(static_cast<int>(std::floor((x - x0_) / h_)), 0, nx_ - 1);
+}
+int ConeLatticeField::CellY(double y) const noexcept
+{
+    return std::clamp(static_cast<int>(std::floor((y - y0_) / h_)), 0, ny_ - 1);
+}
+
+/** @return the most cone axes within ρ_c of one cone axis (itself included). */
+int ConeLatticeField::Crowd() const
+{
+    int most = 0;
+    for (const auto& c : cones_) {
+        const int cx = CellX(c.x), cy = CellY(c.y);
+        int n = 0;
+        for (int iy = std::max(cy - 1, 0); iy <= std::min(cy + 1, ny_ - 1); ++iy)
+            for (int ix = std::max(cx - 1, 0); ix <= std::min(cx + 1, nx_ - 1); ++ix)
+                for (int k : cells_[iy * nx_ + ix]) {
+                    const double dx = cones_[k].x - c.x, dy = cones_[k].y - c.y;
+                    n += dx * dx + dy * dy <= cut2_;
+                }
+        most = std::max(most, n);
+    }
+    return most;
+}
+
+/*══════════════════════════════════════════════════════════════════════════*/
+/* 2.  Report                                                               */
+/*══════════════════════════════════════════════════════════════════════════*/
+void ConeLatticeField::Report(std::ostream& os) const
+{
+    os << "  lattice " << cones_.size() << " cones, " << k_ << " nearest within "
+       << acc_.cutoff_nm << " nm; a neglected cone adds at most |dE| " << acc_.tail
+       << " (" << acc_.tail / acc_.peak << " of its peak " << acc_.peak << ")"
+       << ", all of them at most " << acc_.sum << '\n';
+    if (acc_.capped)
+        os << "  lattice cutoff capped at the map's radial extent " << acc_.edge_nm
+           << " nm; a wider map is needed for the requested tolerance\n";
+    if (acc_.crowd > k_)
+        os << "  lattice up to " << acc_.crowd << " cones lie within the cutoff of an"
+           << " axis; k_nearest = " << k_ << " drops the farthest of them\n";
+}
+
+/*══════════════════════════════════════════════════════════════════════════*/
+/* 3.  Lookup                                                               */
+/*══════════════════════════════════════════════════════════════════════════*/
+void ConeLatticeField::Field(double x, double y, double z, double E[3]) const
+{
+    // K nearest contributing axes, sorted by ρ² (insertion into ≤ 64 slots)
+    int    idx[kMaxNearest];
+    double d2 [kMaxNearest];
+    int    n = 0;
+
+    const int cx = CellX(x), cy = CellY(y);
+    for (int iy = std::max(cy - 1, 0); iy <= std::min(cy + 1, ny_ - 1); ++iy)
+        for (int ix = std::max(cx - 1, 0); ix <= std::min(cx + 1, nx_ - 1); ++ix)
+            for (int k : cells_[iy * nx_ + ix]) {
+                const Cone&  c   = cones_[k];
+                const double dx  = x - c.x, dy = y - c.y;
+                const double rho = dx * dx + dy * dy;
+                const double zl  = (z - c.z) * scale_;
+                if (rho > cut2_ || zl < z0_ || zl > z1_) continue;
+
+                int pos;
+                if (n < k_)                 pos = n++;
+                else if (rho >= d2[n - 1])  continue;
+                else                        pos = n - 1;
+                for (; pos > 0 && d2[pos - 1] > rho; --pos) {
+                    d2[pos] = d2[pos - 1];  idx[pos] = idx[pos - 1];
+                }
+                d2[pos] = rho;  idx[pos] = k;
+            }
+
+    double ex = 0.0, ey = 0.0, ez = bg_;
+    for (int i = 0; i < n; ++i) {
+        const Cone&  c  = cones_[idx[i]];
+        const double lx = (x - c.x) * scale_, ly = (y - c.y) * scale_;
+        const double r  = std::sqrt(lx * lx + ly * ly);
+        double Er, Ez;
+        map_->FieldRZ(r, (z - c.z) * scale_, Er, Ez);
+        ez += Ez - bg_;
+        if (r >= 1e-9) { ex += Er * lx / r;  ey += Er * ly / r; }
+    }
+    E[0] = ex;  E[1] = ey;  E[2] = ez;
+}
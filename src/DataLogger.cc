@@ -27,6 +27,7 @@
 
 /*────────────────────────────── C++ stdlib ────────────────────────────────*/
 #include <chrono>
+#include <cmath>
 #include <filesystem>
 #include <iomanip>
 #include <sstream>
@@ -38,6 +39,9 @@
 
 /*────────────────────────── project headers  ──────────────────────────────*/
 #include "DetectorConstruction.hh" // for cone dictionary helper
+#include "RateProvider.hh"         // rate checksum
+#include "RunCache.hh"             // ConfigHash() / InputHash()
+#include "RunStats.hh"             // BinomialError()
 
 using namespace util;
 namespace fs = std::filesystem;    // shorthand
@@ -46,8 +50,10 @@ namespace fs = std::filesystem;    // shorthand
 /* 1.  Ctor / Dtor                                                         */
 /*══════════════════════════════════════════════════════════════════════════*/
 
-DataLogger::DataLogger(const std::string& outDir)
-: outDir_{outDir}
+DataLogger::DataLogger(const std::string&    outDir,
+                       const sim::RunConfig& runCfg)
+: runCfg_{runCfg}
+, outDir_{outDir}
 {
     /* The top-level “results” directory is created once (idempotent). */
     fs::create_directories(outDir_);
@@ -78,6 +84,9 @@ void DataLogger::InitOutputFiles(const geom::GeometryConfig& cfg)
     std::strftime(stamp, sizeof(stamp), "%Y%m%dT%H%M%S", std::localtime(&t_c));
 
     subDir_   = outDir_ + "/" + stamp;
+    if (runCfg_.IsSharded())   // shards of one job may start in the same second
+        subDir_ += "_shard" + std::to_string(runCfg_.shardIndex)
+                 + "of"     + std::to_string(runCfg_.shardCount);
     tsvPath_  = subDir_ + "/events.tsv";
     jsonPath_ = subDir_ + "/run.json";
 
@@ -149,19 +158,24 @@ void DataLogger::InitOutputFiles(const geom::GeometryConfig& cfg)
 /* 3.  DumpRunSummary – called ONCE in EndOfRunAction (master)              */
 /*══════════════════════════════════════════════════════════════════════════*/
 
-void DataLogger::DumpRunSummary(const geom::GeometryConfig& cfg,
-                                unsigned long               nEvents,
-                                unsigned long               nIon,
-                                unsigned long               nCap,
-                                const std::vector<unsigned>& coneIon,
-                                const std::vector<unsigned>& coneCap,
-                                const std::vector<unsigned>& panelIon,
-                                const std::vector<unsigned>& panelCap)
+void DataLogger::DumpRunSummary(const geom::GeometryConfig& cfg, const RunSummary& run)
 {
+    const unsigned long nEvents = run.nEvents, nIon = run.nIon, nCap = run.nCap;
+    const unsigned long nTransmitted = run.nTransmitted;
+    const auto& coneIon  = run.coneIon;
+    const auto& coneCap  = run.coneCap;
+    const auto& panelIon = run.panelIon;
+    const auto& panelCap = run.panelCap;
+    const bool  final    = run.final;
+    const auto* stop     = run.stop;
+    const auto* qmc      = run.qmc;
+    const auto* weighted = run.weighted;
+    const auto* strata   = run.strata;
+
     /*------------------------------------------------------------------*/
     /** 3.1  Finalize TSV footer                                        */
     /*------------------------------------------------------------------*/
-    if (tsv_.is_open()) {
+    if (final && tsv_.is_open()) {
         tsv_ << "# ------------------------------------------------------------\n"
              << "# Total mu-α ionization events: " << nIon << "\n"
              << "# Total mu-α capture    events: " << nCap << "\n"
@@ -183,16 +197,19 @@ void DataLogger::DumpRunSummary(const geom::GeometryConfig& cfg,
     }
 
     /*------------------------------------------------------------------*/
-    /** 3.3  Simple stats (fractions + Wilson errors)                   */
+    /** 3.3  Simple stats (fractions + binomial errors, see RunStats.hh) */
     /*------------------------------------------------------------------*/
-    const double N  = static_cast<double>(nEvents);
-    const double fI = N ? nIon / N : 0.0;
-    const double fC = N ? nCap / N : 0.0;
-
-    auto wilson95 = [N](unsigned long k, double p) -> double
-    {
-        if (k == 0 || k == N) return 3.0 / N;      // “rule of three”
-        return std::sqrt(p * (1.0 - p) / N);
+    const double fI = Fraction(nIon, nEvents);
+    const double fC = Fraction(nCap, nEvents);
+
+    // Any weighted run biases the raw tallies (and the cone / panel ones):
+    // --bias over-samples the shell shadow, forced crossings never ionise a
+    // track (n_ion = 0, captures count reach) and importance splitting
+    // counts every copy as a hit.  Only `weighted` is an estimate; the
+    // counts stay for merging, the fractions are null.
+    const bool rawValid = !(runCfg_.Weighted() || cfg.importance.Active());
+    auto raw = [&js, rawValid](double x) -> std::ostream& {
+        return rawValid ? js << x : js << "null";
     };
 
     /*------------------------------------------------------------------*/
@@ -203,11 +220,126 @@ void DataLogger::DumpRunSummary(const geom::GeometryConfig& cfg,
        << "  \"n_events\"      : " << nEvents << ",\n"
        << "  \"n_ion\"         : " << nIon    << ",\n"
        << "  \"n_capture\"     : " << nCap    << ",\n"
-       << "  \"ion_frac\"      : " << fI      << ",\n"
-       << "  \"ion_err\"       : " << wilson95(nIon, fI) << ",\n"
-       << "  \"cap_frac\"      : " << fC      << ",\n"
-       << "  \"cap_err\"       : " << wilson95(nCap, fC) << ",\n"
-       << "  \"ion_cap_ratio\" : " << (nCap ? double(nIon) / nCap : 0.0) << ",\n";
+       << "  \"n_transmitted\" : " << nTransmitted << ",\n"
+       << "  \"raw_valid\"     : " << (rawValid ? "true" : "false") << ",\n";
+    js << "  \"ion_frac\"      : ";  raw(fI) << ",\n";
+    js << "  \"ion_err\"       : ";  raw(BinomialError(nIon, nEvents)) << ",\n";
+    js << "  \"cap_frac\"      : ";  raw(fC) << ",\n";
+    js << "  \"cap_err\"       : ";  raw(BinomialError(nCap, nEvents)) << ",\n";
+    js << "  \"ion_cap_ratio\" : ";  raw(nCap ? double(nIon) / nCap : 0.0) << ",\n";
+
+    /*── Seed + event range (needed to merge shards, see RunMerge.hh) ─*/
+    js << "  \"seed\"          : " << runCfg_.seed       << ",\n"
+       << "  \"crn\"           : " << (runCfg_.crn ? "true" : "false") << ",\n"
+       << "  \"rng\"           : \"" << sim::RngName(runCfg_.rng) << "\",\n"
+       << "  \"sampler\"       : \"" << sim::SamplerName(runCfg_.sampler) << "\",\n"
+       << "  \"bias\"          : " << runCfg_.biasFraction << ",\n"
+       << "  \"strata\"        : \"" << sim::StrataName(runCfg_.strata) << "\",\n"
+       << "  \"force_ion\"     : " << (runCfg_.forceIon ? "true" : "false") << ",\n"
+       << "  \"engine\"        : \""
+       << (runCfg_.engine == sim::Engine::Ballistic ? "ballistic" : "geant4") << "\",\n"
+       << "  \"first_event\"   : " << runCfg_.firstEvent << ",\n"
+       << "  \"shard_index\"   : " << runCfg_.shardIndex << ",\n"
+       << "  \"shard_count\"   : " << runCfg_.shardCount << ",\n";
+
+    /*── Cache keys (see RunCache.hh) ────────────────────────────────*/
+    const std::string configHash = ConfigHash(cfg, runCfg_, RateChecksum(runCfg_.rateSpec));
+    js << "  \"config_hash\"   : \"" << configHash << "\",\n"
+       << "  \"input_hash\"    : \""
+       << InputHash(configHash, runCfg_.firstEvent, static_cast<long>(nEvents)) << "\",\n";
+
+    /*── Sequential stopping decision (--target-rel-error) ───────────*/
+    if (stop) {
+        const sim::StopRule& r = runCfg_.stop;
+        js << "  \"stopping\" : {\n"
+           << "    \"estimator\"        : \"" << sim::EstimatorName(r.estimator) << "\",\n"
+           << "    \"target_rel_error\" : " << r.targetRelError << ",\n"
+           << "    \"confidence\"       : " << r.confidence     << ",\n"
+           << "    \"rel_half_width\"   : ";
+        if (std::isfinite(stop->relHalfWidth)) js << stop->relHalfWidth;
+        else                                   js << "null";
+        js << ",\n"
+           << "    \"batch_events\"     : " << r.batchEvents    << ",\n"
+           << "    \"batches\"          : " << stop->batches    << ",\n"
+           << "    \"max_events\"       : " << runCfg_.nEvents  << ",\n"
+           << "    \"reason\"           : \"" << stop->reason << "\"\n"
+           << "  },\n";
+    }
+
+    /*── Randomised QMC replicas (--sampler=sobol, see Sobol.hh) ──────*/
+    if (qmc) {
+        const ReplicaEstimate ion = ReplicaFraction(qmc->ion, qmc->n);
+        const ReplicaEstimate cap = ReplicaFraction(qmc->cap, qmc->n);
+        auto list = [&js](const std::vector<unsigned long>& v) {
+            js << '[';
+            for (std::size_t r = 0; r < v.size(); ++r) js << (r ? ", " : "") << v[r];
+            js << ']';
+        };
+        js << "  \"qmc\" : {\n"
+           << "    \"replicas\"    : " << qmc->Size() << ",\n"
+           << "    \"ion_frac\"    : " << ion.mean   << ",\n"
+           << "    \"ion_err\"     : " << ion.stdErr << ",\n"
+           << "    \"cap_frac\"    : " << cap.mean   << ",\n"
+           << "    \"cap_err\"     : " << cap.stdErr << ",\n"
+           << "    \"replica_n\"   : ";  list(qmc->n);
+        js << ",\n    \"replica_ion\" : ";  list(qmc->ion);
+        js << ",\n    \"replica_cap\" : ";  list(qmc->cap);
+        js << "\n  },\n";
+    }
+
+    /*── Weighted scores (--bias: BeamBias.hh, --force-ion: SteppingAction) */
+    if (weighted) {
+        const ReplicaEstimate ion = weighted->Ion(nEvents);
+        const ReplicaEstimate cap = weighted->Cap(nEvents);
+        js << std::scientific << std::setprecision(10)   // rare rates
+           << "  \"weighted\" : {\n"
+           << "    \"ion_frac\"       : " << ion.mean   << ",\n"
+           << "    \"ion_err\"        : " << ion.stdErr << ",\n"
+           << "    \"cap_frac\"       : " << cap.mean   << ",\n"
+           << "    \"cap_err\"        : " << cap.stdErr << ",\n"
+           << "    \"ion_cap_ratio\"  : " << (cap.mean > 0.0 ? ion.mean / cap.mean : 0.0) << ",\n"
+           << "    \"mean_weight\"    : " << (nEvents ? weighted->w / nEvents : 0.0) << ",\n"
+           << "    \"effective_size\" : " << weighted->EffectiveSize() << ",\n"
+           << std::setprecision(17)                      // raw sums merge exactly
+           << "    \"sum_w\"          : " << weighted->w    << ",\n"
+           << "    \"sum_w2\"         : " << weighted->w2   << ",\n"
+           << "    \"sum_w_ion\"      : " << weighted->ion  << ",\n"
+           << "    \"sum_w2_ion\"     : " << weighted->ion2 << ",\n"
+           << "    \"sum_w_cap\"      : " << weighted->cap  << ",\n"
+           << "    \"sum_w2_cap\"     : " << weighted->cap2 << ",\n"
+           << "    \"sum_w2_ion_cap\" : " << weighted->ionCap << "\n"
+           << "  },\n"
+           << std::fixed << std::setprecision(6);
+    }
+
+    /*── Stratified beam (--strata, see Strata.hh) ────────────────────*/
+    if (strata) {
+        const ReplicaEstimate ion = strata->Ion(), cap = strata->Cap();
+        const double eI = strata->IonErrMC(), eC = strata->CapErrMC();
+        auto vrf = [](double mc, double st) { return st > 0.0 ? (mc * mc) / (st * st) : 0.0; };
+        auto list = [&js](const auto& v) {
+            js << '[';
+            for (std::size_t h = 0; h < v.size(); ++h) js << (h ? ", " : "") << v[h];
+            js << ']';
+        };
+        const auto& pooled = strata->Pooled();
+        js << "  \"stratified\" : {\n"
+           << "    \"strata\"      : " << pooled.Size()      << ",\n"
+           << "    \"batches\"     : " << strata->Batches()  << ",\n"
+           << "    \"ion_frac\"    : " << ion.mean           << ",\n"
+           << "    \"ion_err\"     : " << ion.stdErr         << ",\n"
+           << "    \"ion_err_mc\"  : " << eI                 << ",\n"
+           << "    \"ion_vrf\"     : " << vrf(eI, ion.stdErr) << ",\n"
+           << "    \"cap_frac\"    : " << cap.mean           << ",\n"
+           << "    \"cap_err\"     : " << cap.stdErr         << ",\n"
+           << "    \"cap_err_mc\"  : " << eC                 << ",\n"
+           << "    \"cap_vrf\"     : " << vrf(eC, cap.stdErr) << ",\n"
+           << "    \"last_alloc\"  : ";  list(sim::Strata().Allocation());
+        js << ",\n    \"stratum_n\"   : ";  list(pooled.n);
+        js << ",\n    \"stratum_ion\" : ";  list(pooled.ion);
+        js << ",\n    \"stratum_cap\" : ";  list(pooled.cap);
+        js << "\n  },\n";
+    }
 
     /*── Geometry parameters (flat) ───────────────────────────────────*/
     js << "  \"geometry\" : {\n"
@@ -216,8 +348,13 @@ void DataLogger::DumpRunSummary(const geom::GeometryConfig& cfg,
        << "    \"h_cone_nm\"   : " << cfg.cone.h_cone_nm  << ",\n"
        << "    \"gap_nm\"      : " << cfg.gap_nm          << ",\n"
        << "    \"r_middle_nm\" : " << cfg.r_middle_nm     << ",\n"
-       << "    \"r_outer_nm\"  : " << cfg.r_outer_nm      << "\n"
-       << "  },\n";
+       << "    \"r_outer_nm\"  : " << cfg.r_outer_nm;
+    if (cfg.importance.Active())
+        js << ",\n    \"importance\"  : { \"world\" : "  << cfg.importance.world
+           << ", \"outer\" : "  << cfg.importance.outer
+           << ", \"middle\" : " << cfg.importance.middle
+           << ", \"inner\" : "  << cfg.importance.inner << " }";
+    js << "\n  },\n";
 
     /*── Per-panel / per-cone tallies (optional, but useful) ──────────*/
     js << "  \"panel_stats\" : [\n";
@@ -245,4 +382,21 @@ void DataLogger::DumpRunSummary(const geom::GeometryConfig& cfg,
     G4cout << "[DataLogger] > Wrote " << jsonPath_ << G4endl;
 }
 
+/*══════════════════════════════════════════════════════════════════════════*/
+/* 4.  DumpEventOutcomes – CRN mode, after every (batch) run (master)       */
+/*══════════════════════════════════════════════════════════════════════════*/
+
+void DataLogger::DumpEventOutcomes(const std::vector<std::uint8_t>& flags)
+{
+    const std::string path = subDir_ + "/outcomes.u8";
+    std::ofstream out(path, std::ios::binary);
+    if (!out) {
+        G4cerr << "[DataLogger] ERROR: cannot open " << path << G4endl;
+        return;
+    }
+    out.write(reinterpret_cast<const char*>(flags.data()),
+              static_cast<std::streamsize>(flags.size()));
+    G4cout << "[DataLogger] > Wrote " << path << G4endl;
+}
+
 /*──────────────────────────── end of file ─────────────────────────────────*/
\ No newline at end of file
@@ -276,7 +276,8 @@
  *    1.  Build an axis-aligned vacuum “world” box that comfortably
  *        encloses *all* cone panels requested in ::geom::GeometryConfig.
  *    2.  Delegate creation & placement of the nano-cone comb to
- *        ::ConeCombBuilder.
+ *        ::ConeCombBuilder, inside a panel envelope that carries the
+ *        free-flight fast-simulation region (FreeFlightModel.hh).
  *    3.  Cache pointers / spike centres so that physics actions can
  *        query them at run-time.
  *
@@ -302,23 +303,39 @@
 #include "DetectorConstruction.hh"
 
 // Geant4 geometry core
+#include "G4AutoDelete.hh"
 #include "G4Box.hh"
+#include "G4Exception.hh"
 #include "G4LogicalVolume.hh"
 #include "G4NistManager.hh"
 #include "G4PVPlacement.hh"
+#include "G4Region.hh"
 #include "G4SystemOfUnits.hh"
 
+// project
+#include "ConeLattice.hh"     // geom::ShellColumns
+#include "FieldSetup.hh"
+#include "FreeFlightModel.hh"
+#include "AxisymmetricSolver.hh"
+#include "ConeLatticeField.hh"
+#include "ResampledField.hh"
+#include "TiledFieldMap.hh"
+#include "RevolvedFieldFromPOS.hh"
+
 // C++ std
 #include <algorithm>  // std::max_element
+#include <cmath>      // std::abs
 #include <numeric>    // std::accumulate
 
 // -----------------------------------------------------------------------------
 //  Constructor – make a deep copy of the data-only config
 //  and create the builder helper.
 // -----------------------------------------------------------------------------
-DetectorConstruction::DetectorConstruction(const geom::GeometryConfig& cfg)
+DetectorConstruction::DetectorConstruction(const geom::GeometryConfig& cfg,
+                                           bool freeFlight)
   : cfg_{cfg}
   , builder_{std::make_unique<ConeCombBuilder>(cfg_)}
+  , fFreeFlight_{freeFlight}
 {
   /* nothing else – heavy G4 objects created later in Construct() */
 }
@@ -372,9 +389,52 @@ G4VPhysicalVolume* DetectorConstruction::Construct()
                                       false);
 
   // ────────────────────────────────────────────────────────────────
-  // 2)  Ask the builder to place every panel into the world.
+  // 2)  Panel envelope: bounding box of the shell columns, padded by
+  //     1 nm and clipped to the world.  It is the root of the region
+  //     that FreeFlightModel is attached to.
+  // ────────────────────────────────────────────────────────────────
+  const double halfWorld[3] = {xWorld / nm, yWorld / nm, zWorld / nm};
+  double lo[3] = { halfWorld[0],  halfWorld[1],  halfWorld[2]};
+  double hi[3] = {-halfWorld[0], -halfWorld[1], -halfWorld[2]};
+  for (const auto& c : geom::ShellColumns(cfg_))
+  {
+    lo[0] = std::min(lo[0], c.x_nm - c.r_nm);  hi[0] = std::max(hi[0], c.x_nm + c.r_nm);
+    lo[1] = std::min(lo[1], c.y_nm - c.r_nm);  hi[1] = std::max(hi[1], c.y_nm + c.r_nm);
+    lo[2] = std::min(lo[2], c.z_lo_nm);        hi[2] = std::max(hi[2], c.z_hi_nm);
+  }
+  for (int k = 0; k < 3; ++k)
+  {
+    lo[k] = std::max(lo[k] - 1.0, -halfWorld[k]);
+    hi[k] = std::min(hi[k] + 1.0,  halfWorld[k]);
+  }
+
+  auto* solidEnvelope = new G4Box("PanelEnvelopeSolid",
+                                  0.5 * (hi[0] - lo[0]) * nm,
+                                  0.5 * (hi[1] - lo[1]) * nm,
+                                  0.5 * (hi[2] - lo[2]) * nm);
+
+  fEnvelopeLogical_ = new G4LogicalVolume(solidEnvelope,
+                                          vacuum,
+                                          "PanelEnvelopeLogical");
+
+  new G4PVPlacement(nullptr,
+                    G4ThreeVector(0.5 * (lo[0] + hi[0]) * nm,
+                                  0.5 * (lo[1] + hi[1]) * nm,
+                                  0.5 * (lo[2] + hi[2]) * nm),
+                    fEnvelopeLogical_,
+                    "PanelEnvelope",
+                    fWorldLogical_,
+                    false,
+                    0,
+                    false);
+
+  fEnvelopeRegion_ = new G4Region("PanelEnvelopeRegion");
+  fEnvelopeRegion_->AddRootLogicalVolume(fEnvelopeLogical_);
+
+  // ────────────────────────────────────────────────────────────────
+  // 3)  Ask the builder to place every panel into the envelope.
   // ────────────────────────────────────────────────────────────────
-  builder_->Build(fWorldLogical_);
+  builder_->Build(fEnvelopeLogical_);
 
   // Cache shared cone LV & base list for later retrieval
   fConeLogical_  = builder_->ConeLogical();
@@ -383,10 +443,97 @@ G4VPhysicalVolume* DetectorConstruction::Construct()
   fOutShellLogical_ = builder_->OutShellLogical();
   fConesInfo_ = builder_->GetConesInfo();
 
+  // ────────────────────────────────────────────────────────────────
+  // 4)  Field map: read once here, attached per thread in
+  //     ConstructSDandField().  With `field.resample` the regular
+  //     grids come from the cache (or are built and cached now);
+  //     `field.solve` solves for the map the same way, and
+  //     `field.grid3d` maps a 3-D grid instead of the revolved map.
+  // ────────────────────────────────────────────────────────────────
+  if (cfg_.field.grid3d.Active())
+  {
+    if (!fFieldGrid3D_) {
+      try {
+        fFieldGrid3D_ = std::make_shared<const TiledFieldMap>(
+            cfg_.field.grid3d.file,
+            static_cast<std::size_t>(cfg_.field.grid3d.resident_mb * (1 << 20)));
+      } catch (const std::exception& e) {
+        G4Exception("DetectorConstruction", "NoFieldMap", FatalException, e.what());
+      }
+      G4cout << "Field grid 3-D: " << cfg_.field.grid3d.file << '\n';
+      fFieldGrid3D_->Report(G4cout);
+    }
+  }
+  else if (cfg_.field.Solved() && !fFieldMap_)
+  {
+    try {
+      fFieldMap_ = AxisymmetricSolver::LoadOrSolve(cfg_, G4cout);
+    } catch (const std::exception& e) {
+      G4Exception("DetectorConstruction", "BadFieldSolve", FatalException, e.what());
+    }
+  }
+  else if (cfg_.field.Active() && !fFieldMap_ && cfg_.field.resample.Active())
+  {
+    try {
+      fFieldMap_ = ResampledField::LoadOrBuild(cfg_.field, G4cout);
+    } catch (const std::exception& e) {
+      G4Exception("DetectorConstruction", "NoFieldMap", FatalException, e.what());
+    }
+  }
+  else if (cfg_.field.Active() && !fFieldMap_)
+  {
+    auto mesh = std::make_shared<const RevolvedFieldFromPOS>(cfg_.field.pos_file);
+    if (mesh->Size() == 0)
+      G4Exception("DetectorConstruction", "NoFieldMap", FatalException,
+                  ("no VT field points in " + cfg_.field.pos_file).c_str());
+    fFieldMap_ = std::move(mesh);
+  }
+
+  // With `field.lattice` every cone gets its own copy of the map, placed
+  // at its base centre (ConeInfo is in metres).
+  if (fFieldMap_ && !fLatticeField_ && cfg_.field.lattice.Active() && !cfg_.field.grid3d.Active())
+  {
+    std::vector<ConeLatticeField::Cone> cones;
+    cones.reserve(fConesInfo_.size());
+    for (const auto& c : fConesInfo_)
+      cones.push_back({1e9 * c.baseCentre.x(), 1e9 * c.baseCentre.y(), 1e9 * c.baseCentre.z()});
+    try {
+      fLatticeField_ = std::make_shared<const ConeLatticeField>(fFieldMap_, std::move(cones),
+                                                                cfg_.field);
+    } catch (const std::exception& e) {
+      G4Exception("DetectorConstruction", "BadFieldLattice", FatalException, e.what());
+    }
+    fLatticeField_->Report(G4cout);
+  }
+
 #ifdef VERBOSE_GEOM
   G4cout << "[DetectorConstruction] geometry built with "
          << fSpikeCenters_.size() << " spike centres\n";
 #endif
 
   return physWorld;
+}
+
+// -----------------------------------------------------------------------------
+//  ConstructSDandField – per thread.  Shells and cones share one field
+//  manager; open space uses the global one.  The free-flight model
+//  registers itself with the region's G4FastSimulationManager (created on
+//  first use) and stays idle wherever the envelope feels a field.
+// -----------------------------------------------------------------------------
+void DetectorConstruction::ConstructSDandField()
+{
+  if (cfg_.field.Active())
+  {
+    auto* setup = fFieldGrid3D_ ? new FieldSetup(cfg_.field, fFieldGrid3D_)
+                                : new FieldSetup(cfg_.field, fFieldMap_, fLatticeField_);
+    G4AutoDelete::Register(setup);
+
+    for (auto* lv : {fConeLogical_, fInShellLogical_, fMidShellLogical_, fOutShellLogical_})
+      lv->SetFieldManager(setup->ShellManager(), true);
+    if (cfg_.field.open_space)
+      setup->ConfigureGlobal();
+  }
+
+  if (fFreeFlight_)
+    new FreeFlightModel("FreeFlight", fEnvelopeRegion_, cfg_);
 }
\ No newline at end of file
@@ -13,14 +13,18 @@
 #include "EventAction.hh"
 
 #include "G4Event.hh"
+#include "G4PrimaryVertex.hh"
+#include "G4Run.hh"
+#include "G4RunManager.hh"
+#include "RunAction.hh"
 #include "SteppingAction.hh"
 
 // ======================================================================
 //  EventAction implementation
 // ======================================================================
 // -----------------------------------------------------------------------------
-EventAction::EventAction()
-    : G4UserEventAction()
+EventAction::EventAction(RunAction* run)
+    : G4UserEventAction(), fRunAction(run)
 {
     // No special construction needed
 }
@@ -52,6 +56,44 @@ void EventAction::EndOfEventAction(const G4Event* event)
         const_cast<G4Event*>(event)->KeepTheEvent();
     }
 
+    // ------------------------------------------------------------------
+    // CRN mode: remember the outcome of this global event for pairing;
+    // Sobol sampler: count the event in its QMC replica (g mod R)
+    // ------------------------------------------------------------------
+    if (fRunAction && (fRunAction->Config().crn || fRunAction->Config().Qmc()))
+    {
+        const auto&  cfg = fRunAction->Config();
+        const G4Run* run = G4RunManager::GetRunManager()->GetCurrentRun();
+        const long global = cfg.GlobalEvent(run ? run->GetRunID() : 0, event->GetEventID());
+        if (cfg.crn)
+            fRunAction->Outcomes().Set(static_cast<std::size_t>(global - cfg.firstEvent),
+                                       hadIonization, hadCapture);
+        if (cfg.Qmc())
+            fRunAction->Replicas().Add(static_cast<std::size_t>(global % cfg.qmcReplicas),
+                                       hadIonization, hadCapture);
+    }
+
+    // ------------------------------------------------------------------
+    // Weighted run: likelihood-ratio weight (--bias) and the summed
+    // ionisation / capture scores of all tracks (forced with --force-ion,
+    // split copies with geometry importances)
+    // ------------------------------------------------------------------
+    if (fRunAction && fRunAction->Weighted())
+    {
+        const G4PrimaryVertex* vtx = event->GetPrimaryVertex();
+        fRunAction->Weights().Add(vtx ? vtx->GetWeight() : 1.0,
+                                  SteppingAction::EventIonScore(),
+                                  SteppingAction::EventCapScore());
+    }
+
+    // ------------------------------------------------------------------
+    // Stratified beam: count the event in the stratum it was drawn from
+    // ------------------------------------------------------------------
+    if (fRunAction && fRunAction->Config().Stratified())
+        fRunAction->StrataTally().Add(
+            static_cast<std::size_t>(sim::Strata().StratumOf(event->GetEventID())),
+            hadIonization, hadCapture);
+
     // Optional: you could also log which events were kept
     // G4cout << "[EventAction] Event " << event->GetEventID()
     //        << " kept? " << (nCaptures > 0 || nIonization > 0) << G4endl;
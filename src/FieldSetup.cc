@@ -0,0 +1,168 @@
+/**
+ * @file    FieldSetup.cc
+ * @brief   Stepper factory, field cache and field-manager tuning
+ *          (see FieldSetup.hh).
+ */
+
+#include "FieldSetup.hh"
+
+/*────────────────────────────── Geant4 ───────────────────────────────*/
+#include "G4BogackiShampine23.hh"
+#include "G4BogackiShampine45.hh"
+#include "G4CashKarpRKF45.hh"
+#include "G4ChordFinder.hh"
+#include "G4ClassicalRK4.hh"
+#include "G4DormandPrince745.hh"
+#include "G4DormandPrinceRK56.hh"
+#include "G4EqMagElectricField.hh"
+#include "G4Exception.hh"
+#include "G4FieldManager.hh"
+#include "G4MagIntegratorDriver.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4TransportationManager.hh"
+#include "G4TsitourasRK45.hh"
+
+/*──────────────────────────── std / proj ─────────────────────────────*/
+#include <algorithm>
+#include "RevolvedG4Field.hh"
+#include "TiledG4Field.hh"
+
+namespace {
+
+constexpr G4int kNvar = 8;   ///< x, p, t (+1 spare) for G4EqMagElectricField
+const G4String  kCached = "Cached";
+
+/*====================================================================*/
+/*  last-point cache in front of the map field                        */
+/*====================================================================*/
+class CachedElectricField : public G4ElectroMagneticField
+{
+  public:
+    CachedElectricField(const G4Field* field, G4double distance)
+    : field_(field), d2_(distance * distance) {}
+
+    void GetFieldValue(const G4double point[4], G4double* value) const override
+    {
+        const G4ThreeVector x(point[0], point[1], point[2]);
+        if (!valid_ || (x - last_).mag2() > d2_)
+        {
+            field_->GetFieldValue(point, cache_);
+            last_  = x;
+            valid_ = true;
+        }
+        std::copy(cache_, cache_ + 6, value);
+    }
+    G4bool DoesFieldChangeEnergy() const override { return true; }
+
+  private:
+    const G4Field*        field_;
+    G4double              d2_;
+    mutable G4ThreeVector last_;
+    mutable G4double      cache_[6] {};
+    mutable bool          valid_ {false};
+};
+
+} // namespace
+
+/*====================================================================*/
+/*  ctor / dtor                                                       */
+/*====================================================================*/
+FieldSetup::FieldSetup(const geom::FieldSpec& spec,
+                       std::shared_ptr<const AxisymmetricField> map,
+                       std::shared_ptr<const ConeLatticeField> lattice)
+: spec_(spec)
+{
+    const auto& o = spec_.origin_nm;
+    mapField_ = lattice
+              ? new RevolvedG4Field(std::move(lattice), spec_.e_unit_V_per_m * volt / m)
+              : new RevolvedG4Field(std::move(map),
+                                    G4ThreeVector(o.x_nm, o.y_nm, o.z_nm) * nm,
+                                    spec_.pos_unit_m * m,
+                                    spec_.e_unit_V_per_m * volt / m);
+    Init();
+}
+
+FieldSetup::FieldSetup(const geom::FieldSpec& spec,
+                       std::shared_ptr<const TiledFieldMap> grid)
+: spec_(spec)
+{
+    const auto& o = spec_.origin_nm;
+    mapField_ = new TiledG4Field(std::move(grid),
+                                 G4ThreeVector(o.x_nm, o.y_nm, o.z_nm) * nm,
+                                 spec_.pos_unit_m * m,
+                                 spec_.e_unit_V_per_m * volt / m);
+    Init();
+}
+
+void FieldSetup::Init()
+{
+    for (const auto* t : {&spec_.shell, &spec_.open})
+        if (t->eps_min <= 0.0 || t->eps_min > t->eps_max || t->delta_chord_nm <= 0.0)
+            G4Exception("FieldSetup", "BadFieldTuning", FatalException,
+                        "field tuning needs 0 < eps_min <= eps_max and delta_chord_nm > 0");
+
+    field_ = spec_.stepper.rfind(kCached, 0) == 0
+           ? new CachedElectricField(mapField_, spec_.cache_distance_nm * nm)
+           : mapField_;
+
+    equation_ = new G4EqMagElectricField(field_);
+    shellMgr_ = new G4FieldManager();
+    Configure(shellMgr_, spec_.shell);
+}
+
+FieldSetup::~FieldSetup()
+{
+    chords_.clear();                        // drivers go with them
+    steppers_.clear();
+    delete shellMgr_;
+    delete equation_;
+    if (field_ != mapField_) delete field_;
+    delete mapField_;
+}
+
+/*====================================================================*/
+/*  stepper factory                                                   */
+/*====================================================================*/
+G4MagIntegratorStepper* FieldSetup::MakeStepper(const G4String& name,
+                                                G4EqMagElectricField* eq)
+{
+    const G4String s = name.rfind(kCached, 0) == 0 ? G4String(name.substr(kCached.size())) : name;
+
+    if (s == "ClassicalRK4")      return new G4ClassicalRK4     (eq, kNvar);
+    if (s == "CashKarpRKF45")     return new G4CashKarpRKF45    (eq, kNvar);
+    if (s == "BogackiShampine23") return new G4BogackiShampine23(eq, kNvar);
+    if (s == "BogackiShampine45") return new G4BogackiShampine45(eq, kNvar);
+    if (s == "DormandPrince745")  return new G4DormandPrince745 (eq, kNvar);
+    if (s == "DormandPrinceRK56") return new G4DormandPrinceRK56(eq, kNvar);
+    if (s == "TsitourasRK45")     return new G4TsitourasRK45    (eq, kNvar);
+
+    G4Exception("FieldSetup", "BadStepper", FatalException,
+                ("unknown field stepper " + name).c_str());
+    return nullptr;
+}
+
+/*====================================================================*/
+/*  one field manager: stepper → driver → chord finder + tolerances   */
+/*====================================================================*/
+void FieldSetup::Configure(G4FieldManager* mgr, const geom::FieldTuning& t)
+{
+    auto* stepper = steppers_.emplace_back(MakeStepper(spec_.stepper, equation_)).get();
+    auto* driver  = new G4MagInt_Driver(spec_.min_step_nm * nm, stepper,
+                                        stepper->GetNumberOfVariables());
+    auto* chord   = chords_.emplace_back(std::make_unique<G4ChordFinder>(driver)).get();
+    chord->SetDeltaChord(t.delta_chord_nm * nm);
+
+    mgr->SetDetectorField(field_);
+    mgr->SetFieldChangesEnergy(true);
+    mgr->SetChordFinder(chord);
+    mgr->SetDeltaOneStep(t.delta_one_step_nm * nm);
+    mgr->SetDeltaIntersection(t.delta_intersection_nm * nm);
+    mgr->SetMaximumEpsilonStep(t.eps_max);   // max first: min must not exceed it
+    mgr->SetMinimumEpsilonStep(t.eps_min);
+}
+
+void FieldSetup::ConfigureGlobal()
+{
+    Configure(G4TransportationManager::GetTransportationManager()->GetFieldManager(),
+              spec_.open);
+}
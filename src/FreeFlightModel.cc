@@ -0,0 +1,114 @@
+/**
+ * @file    FreeFlightModel.cc
+ * @brief   Trigger and analytic step of the free-flight model
+ *          (see FreeFlightModel.hh).
+ */
+
+#include "FreeFlightModel.hh"
+
+/*────────────────────────────── Geant4 ───────────────────────────────*/
+#include "G4FastStep.hh"
+#include "G4FastTrack.hh"
+#include "G4FieldManager.hh"
+#include "G4GeometryTolerance.hh"
+#include "G4LogicalVolume.hh"
+#include "G4PhysicalConstants.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4Threading.hh"
+#include "G4Track.hh"
+#include "G4TransportationManager.hh"
+#include "G4VSolid.hh"
+
+/*──────────────────────────── std / proj ─────────────────────────────*/
+#include <algorithm>
+#include "MuAlpha5p.hh"
+
+/*====================================================================*/
+/*  ctor                                                              */
+/*====================================================================*/
+FreeFlightModel::FreeFlightModel(const G4String& name, G4Region* envelope,
+                                 const geom::GeometryConfig& cfg)
+: G4VFastSimulationModel(name, envelope), grid_(cfg, 0.0)
+{}
+
+/*====================================================================*/
+/*  field check (envelope field manager, else the global one)         */
+/*====================================================================*/
+bool FreeFlightModel::FieldInEnvelope(const G4FastTrack& fastTrack)
+{
+    const G4FieldManager* fm = fastTrack.GetEnvelopeLogicalVolume()->GetFieldManager();
+    if (!fm) fm = G4TransportationManager::GetTransportationManager()->GetFieldManager();
+    return fm && fm->GetDetectorField();
+}
+
+/*====================================================================*/
+/*  IsApplicable                                                      */
+/*====================================================================*/
+G4bool FreeFlightModel::IsApplicable(const G4ParticleDefinition& particle)
+{
+    return &particle == MuAlpha5p::Definition();
+}
+
+/*====================================================================*/
+/*  ModelTrigger – distance to the next column or the envelope wall   */
+/*====================================================================*/
+G4bool FreeFlightModel::ModelTrigger(const G4FastTrack& fastTrack)
+{
+    /* Fields exist by the first track of the first event */
+    if (enabled_ < 0)
+    {
+        enabled_ = FieldInEnvelope(fastTrack) ? 0 : 1;
+        if (!enabled_)
+            G4cout << "[FreeFlightModel] field in the panel envelope – free flight off on thread "
+                   << G4Threading::G4GetThreadId() << G4endl;
+    }
+    if (!enabled_ || fastTrack.OnTheBoundaryButExiting()) return false;
+
+    /* only in the envelope itself, never inside a shell or a cone */
+    const G4Track* track = fastTrack.GetPrimaryTrack();
+    if (track->GetVolume()->GetLogicalVolume() != fastTrack.GetEnvelopeLogicalVolume())
+        return false;
+
+    const G4double tol = G4GeometryTolerance::GetInstance()->GetSurfaceTolerance();
+
+    /* envelope wall (local frame) */
+    flight_ = fastTrack.GetEnvelopeSolid()->DistanceToOut(
+                  fastTrack.GetPrimaryTrackLocalPosition(),
+                  fastTrack.GetPrimaryTrackLocalDirection());
+
+    /* first column entered ahead; skip the one just left (tOut ≈ 0) */
+    const G4ThreeVector& p = track->GetPosition();
+    const G4ThreeVector& u = track->GetMomentumDirection();
+    const double o[3] = {p.x() / nm, p.y() / nm, p.z() / nm};
+    const double d[3] = {u.x(), u.y(), u.z()};
+    grid_.Crossings(o, d, xs_);
+    for (const auto& x : xs_)
+        if (x.tOut * nm > tol)
+        {
+            flight_ = std::min(flight_, x.tIn * nm);
+            break;
+        }
+
+    return flight_ > tol;
+}
+
+/*====================================================================*/
+/*  DoIt – straight line at constant velocity                         */
+/*====================================================================*/
+void FreeFlightModel::DoIt(const G4FastTrack& fastTrack, G4FastStep& fastStep)
+{
+    const G4Track*            track = fastTrack.GetPrimaryTrack();
+    const G4DynamicParticle*  dyn   = track->GetDynamicParticle();
+
+    const G4double v  = c_light * dyn->GetTotalMomentum() / dyn->GetTotalEnergy();
+    const G4double dt = flight_ / v;
+    const G4double gamma = dyn->GetTotalEnergy() / dyn->GetMass();
+
+    /* kinetic energy and direction keep their initial (current) values */
+    fastStep.ProposePrimaryTrackFinalPosition(
+        track->GetPosition() + flight_ * track->GetMomentumDirection(), false);
+    fastStep.ProposePrimaryTrackFinalTime(track->GetGlobalTime() + dt);
+    fastStep.ProposePrimaryTrackFinalProperTime(track->GetProperTime() + dt / gamma);
+    fastStep.ProposePrimaryTrackPathLength(flight_);
+    fastStep.ProposeTotalEnergyDeposited(0.0);
+}
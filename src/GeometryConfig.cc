@@ -449,6 +449,28 @@ std::ostream& operator<<(std::ostream& os, const GeometryConfig& cfg)
                                       << p.offset_nm.z_nm << ")\n"
            << "    }\n";
     }
+    if (cfg.importance.Active())
+        os << "  importance  = world " << cfg.importance.world
+           << ", outer "  << cfg.importance.outer
+           << ", middle " << cfg.importance.middle
+           << ", inner "  << cfg.importance.inner << '\n';
+    if (cfg.field.Active()) {
+        os << "  field       = ";
+        if (cfg.field.Solved())
+            os << "solved, " << cfg.field.solve.cell_nm << " nm cells, "
+               << cfg.field.solve.v_cone_V << " V cone, " << cfg.field.solve.v_anode_V
+               << " V anode";
+        else
+            os << cfg.field.MapFile();
+        os << " (" << cfg.field.stepper
+           << (cfg.field.open_space ? ", shells + open space" : ", shells only")
+           << (cfg.field.resample.Active() && !cfg.field.grid3d.Active() && !cfg.field.Solved()
+                 ? ", resampled " + cfg.field.resample.interpolation : "")
+           << (cfg.field.lattice.Active() && !cfg.field.grid3d.Active()
+                 ? ", " + std::to_string(cfg.field.lattice.k_nearest) + " nearest cones" : "")
+           << (cfg.field.grid3d.Active() ? ", 3-D tiled grid" : "")
+           << ")\n";
+    }
     os << "}\n";
     return os;
 }
@@ -515,6 +537,153 @@ void from_json(const json& j, PanelSpec& p)
     j.at("offset_nm").get_to(p.offset_nm);
 }
 
+/*── ImportanceSpec ──────────────────────────────────────────────────────*/
+void to_json(json& j, const ImportanceSpec& s)
+{
+    j = json{{"world",  s.world},
+             {"outer",  s.outer},
+             {"middle", s.middle},
+             {"inner",  s.inner}};
+}
+void from_json(const json& j, ImportanceSpec& s)
+{
+    s.world  = j.value("world",  1.0);      // missing volumes keep 1
+    s.outer  = j.value("outer",  1.0);
+    s.middle = j.value("middle", 1.0);
+    s.inner  = j.value("inner",  1.0);
+}
+
+/*── FieldTuning / FieldSpec ─────────────────────────────────────────────*/
+void to_json(json& j, const FieldTuning& t)
+{
+    j = json{{"delta_chord_nm",        t.delta_chord_nm},
+             {"delta_one_step_nm",     t.delta_one_step_nm},
+             {"delta_intersection_nm", t.delta_intersection_nm},
+             {"eps_min",               t.eps_min},
+             {"eps_max",               t.eps_max}};
+}
+void from_json(const json& j, FieldTuning& t)
+{
+    t.delta_chord_nm        = j.value("delta_chord_nm",        t.delta_chord_nm);
+    t.delta_one_step_nm     = j.value("delta_one_step_nm",     t.delta_one_step_nm);
+    t.delta_intersection_nm = j.value("delta_intersection_nm", t.delta_intersection_nm);
+    t.eps_min               = j.value("eps_min",               t.eps_min);
+    t.eps_max               = j.value("eps_max",               t.eps_max);
+}
+
+void to_json(json& j, const FieldResample& r)
+{
+    j = json{{"cell_nm",       r.cell_nm},
+             {"tip_cell_nm",   r.tip_cell_nm},
+             {"tip_r_max_nm",  r.tip_r_max_nm},
+             {"tip_z_min_nm",  r.tip_z_min_nm},
+             {"tip_z_max_nm",  r.tip_z_max_nm},
+             {"interpolation", r.interpolation},
+             {"cache_dir",     r.cache_dir}};
+}
+void from_json(const json& j, FieldResample& r)
+{
+    j.at("cell_nm").get_to(r.cell_nm);
+    r.tip_cell_nm   = j.value("tip_cell_nm",   r.tip_cell_nm);
+    r.tip_r_max_nm  = j.value("tip_r_max_nm",  r.tip_r_max_nm);
+    r.tip_z_min_nm  = j.value("tip_z_min_nm",  r.tip_z_min_nm);
+    r.tip_z_max_nm  = j.value("tip_z_max_nm",  r.tip_z_max_nm);
+    r.interpolation = j.value("interpolation", r.interpolation);
+    r.cache_dir     = j.value("cache_dir",     r.cache_dir);
+}
+
+void to_json(json& j, const FieldLattice& l)
+{
+    j = json{{"k_nearest",     l.k_nearest},
+             {"cutoff_nm",     l.cutoff_nm},
+             {"tolerance",     l.tolerance},
+             {"background_ez", l.background_ez}};
+}
+void from_json(const json& j, FieldLattice& l)
+{
+    j.at("k_nearest").get_to(l.k_nearest);
+    l.cutoff_nm     = j.value("cutoff_nm",     l.cutoff_nm);
+    l.tolerance     = j.value("tolerance",     l.tolerance);
+    l.background_ez = j.value("background_ez", l.background_ez);
+}
+
+void to_json(json& j, const FieldGrid3D& g)
+{
+    j = json{{"file",        g.file},
+             {"resident_mb", g.resident_mb}};
+}
+void from_json(const json& j, FieldGrid3D& g)
+{
+    j.at("file").get_to(g.file);
+    g.resident_mb = j.value("resident_mb", g.resident_mb);
+}
+
+void to_json(json& j, const FieldSolve& s)
+{
+    j = json{{"cell_nm",       s.cell_nm},
+             {"v_cone_V",      s.v_cone_V},
+             {"v_anode_V",     s.v_anode_V},
+             {"r_max_nm",      s.r_max_nm},
+             {"tolerance",     s.tolerance},
+             {"max_cycles",    s.max_cycles},
+             {"interpolation", s.interpolation},
+             {"cache_dir",     s.cache_dir}};
+}
+void from_json(const json& j, FieldSolve& s)
+{
+    j.at("cell_nm").get_to(s.cell_nm);
+    s.v_cone_V      = j.value("v_cone_V",      s.v_cone_V);
+    s.v_anode_V     = j.value("v_anode_V",     s.v_anode_V);
+    s.r_max_nm      = j.value("r_max_nm",      s.r_max_nm);
+    s.tolerance     = j.value("tolerance",     s.tolerance);
+    s.max_cycles    = j.value("max_cycles",    s.max_cycles);
+    s.interpolation = j.value("interpolation", s.interpolation);
+    s.cache_dir     = j.value("cache_dir",     s.cache_dir);
+}
+
+void to_json(json& j, const FieldSpec& f)
+{
+    j = json{{"pos_file",          f.pos_file},
+             {"pos_unit_m",        f.pos_unit_m},
+             {"e_unit_V_per_m",    f.e_unit_V_per_m},
+             {"origin_nm",         f.origin_nm},
+             {"stepper",           f.stepper},
+             {"cache_distance_nm", f.cache_distance_nm},
+             {"min_step_nm",       f.min_step_nm},
+             {"open_space",        f.open_space},
+             {"shell",             f.shell},
+             {"open",              f.open}};
+    if (f.resample.Active())        // keeps older config hashes unchanged
+        j["resample"] = f.resample;
+    if (f.lattice.Active())
+        j["lattice"] = f.lattice;
+    if (f.grid3d.Active())
+        j["grid3d"] = f.grid3d;
+    if (f.solve.Active())
+        j["solve"] = f.solve;
+}
+void from_json(const json& j, FieldSpec& f)
+{
+    f = FieldSpec{};                           // missing keys keep the defaults
+    if (j.contains("grid3d")) j.at("grid3d").get_to(f.grid3d);
+    if (j.contains("solve"))  j.at("solve").get_to(f.solve);
+    if (f.grid3d.Active() || f.solve.Active()) // these maps need no .pos
+        f.pos_file = j.value("pos_file", f.pos_file);
+    else
+        j.at("pos_file").get_to(f.pos_file);
+    f.pos_unit_m        = j.value("pos_unit_m",        f.pos_unit_m);
+    f.e_unit_V_per_m    = j.value("e_unit_V_per_m",    f.e_unit_V_per_m);
+    f.stepper           = j.value("stepper",           f.stepper);
+    f.cache_distance_nm = j.value("cache_distance_nm", f.cache_distance_nm);
+    f.min_step_nm       = j.value("min_step_nm",       f.min_step_nm);
+    f.open_space        = j.value("open_space",        f.open_space);
+    if (j.contains("origin_nm")) j.at("origin_nm").get_to(f.origin_nm);
+    if (j.contains("shell"))     j.at("shell").get_to(f.shell);
+    if (j.contains("open"))      j.at("open").get_to(f.open);
+    if (j.contains("resample"))  j.at("resample").get_to(f.resample);
+    if (j.contains("lattice"))   j.at("lattice").get_to(f.lattice);
+}
+
 /*── GeometryConfig ──────────────────────────────────────────────────────*/
 void to_json(json& j, const GeometryConfig& g)
 {
@@ -525,6 +694,10 @@ void to_json(json& j, const GeometryConfig& g)
         {"r_outer_nm",  g.r_outer_nm},
         {"panels",      g.panels}
     };
+    if (g.importance.Active())      // keeps older config hashes unchanged
+        j["importance"] = g.importance;
+    if (g.field.Active())
+        j["field"] = g.field;
 }
 void from_json(const json& j, GeometryConfig& g)
 {
@@ -533,6 +706,10 @@ void from_json(const json& j, GeometryConfig& g)
     j.at("r_middle_nm").get_to(g.r_middle_nm);
     j.at("r_outer_nm"). get_to(g.r_outer_nm);
     j.at("panels").     get_to(g.panels);
+    if (j.contains("importance"))
+        j.at("importance").get_to(g.importance);
+    if (j.contains("field"))
+        j.at("field").get_to(g.field);
 }
 
 /*══════════════════════════════════════════════════════════════════════════*/
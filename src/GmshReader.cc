@@ -0,0 +1,486 @@
+/**
+ * @file    GmshReader.cc
+ * @author  Mohammadreza Zakeri
+ * @date    2026-10-18
+ *
+ * @brief   Parallel .pos parser and .msh view reader (see GmshReader.hh).
+ *
+ *  No Geant4 or CLHEP includes appear below.
+ */
+
+#include "GmshReader.hh"
+
+/*────────────────────────────── stdlib ───────────────────────────────────*/
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <stdexcept>
+#include <string_view>
+#include <thread>
+
+/*──────────────────────────── project ────────────────────────────────────*/
+#include "MappedFile.hh"
+
+namespace util {
+namespace {
+
+/*══════════════════════════════════════════════════════════════════════════*/
+/* 1.  .pos                                                                 */
+/*══════════════════════════════════════════════════════════════════════════*/
+constexpr std::size_t kMinChunk = 1 << 20;   ///< Bytes per parser thread, at least
+
+inline bool IsSep(char c)
+{
+    return c == ' ' || c == ',' || c == '\t' || c == '\n' || c == '\r' || c == '+';
+}
+
+/// Parse `n` numbers starting at `p`; returns the end of the last one.
+const char* ParseNumbers(const char* p, const char* end, double* out, int n,
+                         const char* base)
+{
+    for (int i = 0; i < n; ++i) {
+        while (p < end && IsSep(*p)) ++p;
+        const auto [q, ec] = std::from_chars(p, end, out[i]);
+        if (ec != std::errc())
+            throw std::runtime_error("malformed VT entry at byte " + std::to_string(p - base));
+        p = q;
+    }
+    return p;
+}
+
+/// All VT entries that start in [b, e); an entry may run on up to `end`.
+void ParseChunk(const char* b, const char* e, const char* end, const char* base,
+                std::vector<GmshTriangle>& out)
+{
+    const std::string_view chunk(b, static_cast<std::size_t>(e - b));
+    for (std::size_t at = chunk.find("VT("); at != std::string_view::npos;
+         at = chunk.find("VT(", at)) {
+        double c[9], v[9];
+        const char* p = ParseNumbers(b + at + 3, end, c, 9, base);
+        p = static_cast<const char*>(std::memchr(p, '{', static_cast<std::size_t>(end - p)));
+        if (!p)
+            throw std::runtime_error("VT entry without values at byte " + std::to_string(b + at - base));
+        p = ParseNumbers(p + 1, end, v, 9, base);
+
+        GmshTriangle t;
+        for (int i = 0; i < 3; ++i) {
+            t.r[i]  = std::sqrt(c[3 * i] * c[3 * i] + c[3 * i + 1] * c[3 * i + 1]);
+            t.z[i]  = c[3 * i + 2];
+            t.Er[i] = v[3 * i];
+            t.Ez[i] = v[3 * i + 2];
+        }
+        out.push_back(t);
+        at = static_cast<std::size_t>(p - b);
+        if (at >= chunk.size()) break;
+    }
+}
+
+/*══════════════════════════════════════════════════════════════════════════*/
+/* 2.  .msh                                                                 */
+/*══════════════════════════════════════════════════════════════════════════*/
+/// Nodes per Gmsh element type (0 → unknown).
+int NodesOf(long type)
+{
+    static constexpr int n[] = {0,  2,  3,  4,  4,  8,  6,  5,  3,  6,  9, 10, 27, 18, 14, 1,
+                                8, 20, 15, 13,  9, 10, 12, 15, 15, 21,  4,  5,  6, 20, 35, 56};
+    return type > 0 && type < static_cast<long>(std::size(n)) ? n[type] : 0;
+}
+
+/// Triangles of any order (corner nodes come first).
+bool IsTriangle(long type)
+{
+    return type == 2 || type == 9 || (type >= 20 && type <= 25);
+}
+
+/// Reader over the mapped bytes; binary-aware where the format is.
+class MshCursor
+{
+  public:
+    MshCursor(const char* b, const char* e) : p_(b), end_(e), base_(b) {}
+
+    bool binary {false};
+    bool v4     {false};
+    int  sizeT  {8};
+
+    bool AtEnd() const { return p_ >= end_; }
+
+    [[noreturn]] void Fail(const std::string& what) const
+    {
+        throw std::runtime_error(what + " at byte " + std::to_string(p_ - base_));
+    }
+
+    /// Rest of the current line (without "\r\n").
+    std::string_view Line()
+    {
+        const char* b  = p_;
+        const char* nl = static_cast<const char*>(std::memchr(p_, '\n', static_cast<std::size_t>(end_ - p_)));
+        p_ = nl ? nl + 1 : end_;
+        const char* e = nl ? nl : end_;
+        if (e > b && e[-1] == '\r') --e;
+        return {b, static_cast<std::size_t>(e - b)};
+    }
+
+    std::string_view Token()
+    {
+        while (p_ < end_ && std::isspace(static_cast<unsigned char>(*p_))) ++p_;
+        const char* b = p_;
+        while (p_ < end_ && !std::isspace(static_cast<unsigned char>(*p_))) ++p_;
+        return {b, static_cast<std::size_t>(p_ - b)};
+    }
+
+    template <class T> T TextNumber()
+    {
+        const auto s = Token();
+        T v {};
+        const auto [q, ec] = std::from_chars(s.data(), s.data() + s.size(), v);
+        if (ec != std::errc() || q != s.data() + s.size()) Fail("expected a number, got '" + std::string(s) + "'");
+        return v;
+    }
+
+    template <class T> T Raw()
+    {
+        if (static_cast<std::size_t>(end_ - p_) < sizeof(T)) Fail("truncated binary data");
+        T v;
+        std::memcpy(&v, p_, sizeof v);
+        p_ += sizeof v;
+        return v;
+    }
+
+    long long Int()     { return binary ? Raw<std::int32_t>() : TextNumber<long long>(); }
+    double    Real()    { return binary ? Raw<double>()       : TextNumber<double>(); }
+    unsigned long long Size()
+    {
+        if (!binary) return TextNumber<unsigned long long>();
+        return sizeT == 8 ? Raw<std::uint64_t>() : Raw<std::uint32_t>();
+    }
+    /// Node / element tag: size_t in MSH 4, int in MSH 2.
+    unsigned long long Tag() { return v4 ? Size() : static_cast<unsigned long long>(Int()); }
+
+    /// Tag inside a post-processing section (`dataTagBytes` wide if binary).
+    int dataTagBytes {4};
+    unsigned long long DataTag()
+    {
+        if (!binary) return TextNumber<unsigned long long>();
+        if (dataTagBytes == 8) return Raw<std::uint64_t>();
+        return static_cast<std::uint32_t>(Raw<std::int32_t>());
+    }
+
+    const char* Pos() const { return p_; }
+    void        Seek(const char* p) { p_ = p; }
+
+    /// `true` if only white space separates the cursor from "$End<name>".
+    bool AtSectionEnd(std::string_view name) const
+    {
+        const char* q = p_;
+        while (q < end_ && std::isspace(static_cast<unsigned char>(*q))) ++q;
+        const std::string tag = "$End" + std::string(name);
+        return static_cast<std::size_t>(end_ - q) >= tag.size() &&
+               std::memcmp(q, tag.data(), tag.size()) == 0;
+    }
+
+    /// Move past "$End<name>" and its line.
+    void EndSection(std::string_view name)
+    {
+        const std::string tag = "$End" + std::string(name);
+        const std::string_view rest(p_, static_cast<std::size_t>(end_ - p_));
+        const auto at = rest.find(tag);
+        if (at == std::string_view::npos) Fail("missing " + tag);
+        p_ += at;
+        Line();
+    }
+
+  private:
+    const char* p_;
+    const char* end_;
+    const char* base_;
+};
+
+struct MshTri {
+    std::uint64_t node[3];
+    double        Er[3], Ez[3];
+    bool          hasData {false};
+};
+
+/// One entry of a vector view: first three node values of an element, or
+/// the value of one node.
+struct DataEntry {
+    unsigned long long tag;
+    int                n;             ///< Node values kept (≤ 3)
+    double             Er[3], Ez[3];
+};
+
+/// Grow `v` so that index `tag` exists; guards against absurd sparse tags.
+template <class T>
+void FitTag(std::vector<T>& v, unsigned long long tag, std::size_t count, const MshCursor& cur,
+            const T& fill)
+{
+    if (tag < v.size()) return;
+    if (tag > 16 * count + (1u << 20)) cur.Fail("tag " + std::to_string(tag) + " too sparse");
+    v.resize(static_cast<std::size_t>(tag) + 1, fill);
+}
+
+} // namespace
+
+/*══════════════════════════════════════════════════════════════════════════*/
+/* 3.  Public entry points                                                  */
+/*══════════════════════════════════════════════════════════════════════════*/
+std::vector<GmshTriangle> ReadPosTriangles(const std::string& path, unsigned threads)
+{
+    const MappedFile file(path, /*sequential=*/true);
+    const char* base = file.Data();
+    const char* end  = base + file.Size();
+    if (file.Size() == 0) return {};
+
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    threads = static_cast<unsigned>(std::clamp<std::size_t>(file.Size() / kMinChunk, 1, threads));
+
+    /*── 3.1  Cut at line starts ─────────────────────────────────────────*/
+    std::vector<const char*> cut(threads + 1, end);
+    cut[0] = base;
+    for (unsigned k = 1; k < threads; ++k) {
+        const char* c  = base + file.Size() / threads * k;
+        const char* nl = static_cast<const char*>(std::memchr(c, '\n', static_cast<std::size_t>(end - c)));
+        cut[k] = std::max(cut[k - 1], nl ? nl + 1 : end);
+    }
+
+    /*── 3.2  Parse the chunks concurrently ──────────────────────────────*/
+    std::vector<std::vector<GmshTriangle>> parts(threads);
+    std::vector<std::exception_ptr>        errors(threads);
+    auto work = [&](unsigned k) {
+        try { ParseChunk(cut[k], cut[k + 1], end, base, parts[k]); }
+        catch (...) { errors[k] = std::current_exception(); }
+    };
+    std::vector<std::thread> pool;
+    for (unsigned k = 1; k < threads; ++k) pool.emplace_back(work, k);
+    work(0);
+    for (auto& t : pool) t.join();
+    for (const auto& e : errors)
+        if (e) std::rethrow_exception(e);
+
+    /*── 3.3  Merge in file order ────────────────────────────────────────*/
+    if (threads == 1) return std::move(parts[0]);
+    std::size_t total = 0;
+    for (const auto& p : parts) total += p.size();
+    std::vector<GmshTriangle> out;
+    out.reserve(total);
+    for (auto& p : parts) {
+        out.insert(out.end(), p.begin(), p.end());
+        std::vector<GmshTriangle>().swap(p);
+    }
+    return out;
+}
+
+std::vector<GmshTriangle> ReadMshTriangles(const std::string& path)
+{
+    const MappedFile file(path, /*sequential=*/true);
+    MshCursor cur(file.Data(), file.Data() + file.Size());
+
+    std::vector<std::array<double, 3>> nodes;      // by node tag
+    std::vector<MshTri>                tris;       // file order
+    std::vector<std::int64_t>          triOfTag;   // element tag → tris index
+    std::vector<std::array<double, 2>> nodeE;      // $NodeData, by node tag
+    std::vector<char>                  hasNodeE;
+    bool haveFormat = false, haveData = false, nodeData = false;
+
+    while (!cur.AtEnd()) {
+        const std::string_view line = cur.Line();
+        if (line.empty() || line[0] != '$') continue;
+        const std::string_view name = line.substr(1);
+
+        /*── $MeshFormat ─────────────────────────────────────────────────*/
+        if (name == "MeshFormat") {
+            const double version = cur.TextNumber<double>();
+            cur.binary = cur.TextNumber<int>() == 1;
+            cur.sizeT  = cur.TextNumber<int>();
+            cur.Line();
+            if (version < 2.0 || version >= 5.0) cur.Fail("unsupported MSH version");
+            if (cur.sizeT != 4 && cur.sizeT != 8) cur.Fail("unsupported data size");
+            cur.v4 = version >= 4.0;
+            if (cur.binary && cur.Raw<std::int32_t>() != 1)
+                cur.Fail("binary .msh with foreign byte order");
+            haveFormat = true;
+        }
+        else if (!haveFormat) {
+            cur.Fail("no $MeshFormat before $" + std::string(name));
+        }
+        /*── $Nodes ──────────────────────────────────────────────────────*/
+        else if (name == "Nodes" && cur.v4) {
+            const auto blocks = cur.Size(), count = cur.Size();
+            cur.Size();                                   // min tag
+            const auto maxTag = cur.Size();
+            FitTag(nodes, maxTag, count, cur, {});
+            std::vector<unsigned long long> tags;
+            for (unsigned long long b = 0; b < blocks; ++b) {
+                const long long dim = cur.Int();
+                cur.Int();                                // entity tag
+                const bool param = cur.Int() != 0;
+                tags.resize(cur.Size());
+                for (auto& t : tags) t = cur.Size();
+                for (auto t : tags) {
+                    FitTag(nodes, t, count, cur, {});
+                    nodes[t] = {cur.Real(), cur.Real(), cur.Real()};
+                    for (long long k = 0; param && k < dim; ++k) cur.Real();
+                }
+            }
+        }
+        else if (name == "Nodes") {
+            const auto count = cur.TextNumber<unsigned long long>();
+            cur.Line();
+            for (unsigned long long i = 0; i < count; ++i) {
+                const auto t = cur.Tag();
+                FitTag(nodes, t, count, cur, {});
+                nodes[t] = {cur.Real(), cur.Real(), cur.Real()};
+            }
+        }
+        /*── $Elements ───────────────────────────────────────────────────*/
+        else if (name == "Elements") {
+            auto add = [&](unsigned long long tag, long type, const std::uint64_t* n, std::size_t count) {
+                if (!IsTriangle(type)) return;
+                FitTag(triOfTag, tag, count, cur, std::int64_t{-1});
+                triOfTag[tag] = static_cast<std::int64_t>(tris.size());
+                tris.push_back({{n[0], n[1], n[2]}, {}, {}, false});
+            };
+            std::uint64_t n[64];
+            if (cur.v4) {
+                const auto blocks = cur.Size(), count = cur.Size();
+                cur.Size();  cur.Size();                  // min / max tag
+                for (unsigned long long b = 0; b < blocks; ++b) {
+                    cur.Int();  cur.Int();                // dim, entity tag
+                    const long type = static_cast<long>(cur.Int());
+                    const int  nn   = NodesOf(type);
+                    if (nn == 0) cur.Fail("unknown element type " + std::to_string(type));
+                    const auto inBlock = cur.Size();
+                    for (unsigned long long e = 0; e < inBlock; ++e) {
+                        const auto tag = cur.Size();
+                        for (int k = 0; k < nn; ++k) n[k] = cur.Size();
+                        add(tag, type, n, count);
+                    }
+                }
+            } else {
+                const auto count = cur.TextNumber<unsigned long long>();
+                cur.Line();
+                for (unsigned long long read = 0; read < count;) {
+                    long type;  long long inBlock, nTags;
+                    if (cur.binary) {                     // block header, then elements
+                        type = static_cast<long>(cur.Int());
+                        inBlock = cur.Int();
+                        nTags = cur.Int();
+                    } else {
+                        inBlock = 1;
+                        type = -1;
+                        nTags = 0;
+                    }
+                    for (long long e = 0; e < inBlock; ++e) {
+                        const auto tag = static_cast<unsigned long long>(cur.Int());
+                        if (!cur.binary) { type = static_cast<long>(cur.Int()); nTags = cur.Int(); }
+                        const int nn = NodesOf(type);
+                        if (nn == 0) cur.Fail("unknown element type " + std::to_string(type));
+                        for (long long k = 0; k < nTags; ++k) cur.Int();
+                        for (int k = 0; k < nn; ++k) n[k] = static_cast<std::uint64_t>(cur.Int());
+                        add(tag, type, n, count);
+                    }
+                    read += static_cast<unsigned long long>(inBlock);
+                }
+            }
+        }
+        /*── $ElementNodeData / $NodeData (first vector view) ────────────*/
+        else if (!haveData && (name == "ElementNodeData" || name == "NodeData")) {
+            const bool perElement = name == "ElementNodeData";
+            const auto nStr = cur.TextNumber<int>();
+            cur.Line();
+            for (int k = 0; k < nStr; ++k) cur.Line();
+            const auto nReal = cur.TextNumber<int>();
+            for (int k = 0; k < nReal; ++k) cur.TextNumber<double>();
+            const auto nInt = cur.TextNumber<int>();
+            long long ints[8] = {0, 0, 0};
+            for (int k = 0; k < nInt; ++k) {
+                const auto v = cur.TextNumber<long long>();
+                if (k < 8) ints[k] = v;
+            }
+            cur.Line();
+            const long long comps = ints[1], count = ints[2];
+
+            if (comps == 3) {
+                if (perElement && tris.empty()) cur.Fail("$ElementNodeData before any triangle");
+
+                // Binary tags are int in the files Gmsh writes; size_t is
+                // tried as well, and a pass counts only if it ends exactly
+                // at the section's end.
+                std::vector<DataEntry> got;
+                auto pass = [&](int tagBytes) {
+                    cur.dataTagBytes = tagBytes;
+                    got.clear();
+                    try {
+                        for (long long e = 0; e < count; ++e) {
+                            DataEntry d {cur.DataTag(), 0, {}, {}};
+                            const long long nn = perElement ? cur.Int() : 1;
+                            if (nn < 1 || nn > 64) return false;
+                            for (long long k = 0; k < nn; ++k) {
+                                const double ex = cur.Real();
+                                cur.Real();
+                                const double ez = cur.Real();
+                                if (k < 3) { d.Er[k] = ex;  d.Ez[k] = ez;  d.n = static_cast<int>(k + 1); }
+                            }
+                            got.push_back(d);
+                        }
+                    } catch (const std::runtime_error&) { return false; }
+                    return cur.AtSectionEnd(name);
+                };
+                const char* start = cur.Pos();
+                bool ok = pass(4);
+                if (!ok && cur.binary) { cur.Seek(start);  ok = pass(8); }
+                if (!ok) cur.Fail("unreadable $" + std::string(name));
+
+                if (!perElement) { nodeE.assign(nodes.size(), {}); hasNodeE.assign(nodes.size(), 0); }
+                for (const auto& d : got) {
+                    if (perElement && d.tag < triOfTag.size() && triOfTag[d.tag] >= 0 && d.n == 3) {
+                        MshTri& t = tris[static_cast<std::size_t>(triOfTag[d.tag])];
+                        std::copy(d.Er, d.Er + 3, t.Er);
+                        std::copy(d.Ez, d.Ez + 3, t.Ez);
+                        t.hasData = true;
+                    }
+                    if (!perElement && d.tag < nodeE.size()) {
+                        nodeE[d.tag] = {d.Er[0], d.Ez[0]};
+                        hasNodeE[d.tag] = 1;
+                    }
+                }
+                haveData = true;
+                nodeData = !perElement;
+            }
+        }
+        cur.EndSection(name);
+    }
+
+    /*── Assemble ────────────────────────────────────────────────────────*/
+    if (!haveData) throw std::runtime_error(path + ": no 3-component view");
+    std::vector<GmshTriangle> out;
+    out.reserve(tris.size());
+    for (const auto& t : tris) {
+        GmshTriangle g;
+        bool ok = nodeData || t.hasData;
+        for (int i = 0; i < 3 && ok; ++i) {
+            const auto id = t.node[i];
+            if (id >= nodes.size() || (nodeData && !hasNodeE[id])) { ok = false; break; }
+            const auto& x = nodes[id];
+            g.r[i]  = std::sqrt(x[0] * x[0] + x[1] * x[1]);
+            g.z[i]  = x[2];
+            g.Er[i] = nodeData ? nodeE[id][0] : t.Er[i];
+            g.Ez[i] = nodeData ? nodeE[id][1] : t.Ez[i];
+        }
+        if (ok) out.push_back(g);
+    }
+    if (out.empty()) throw std::runtime_error(path + ": the view has no triangles");
+    return out;
+}
+
+bool IsMshFile(const std::string& path)
+{
+    return path.size() >= 4 && path.compare(path.size() - 4, 4, ".msh") == 0;
+}
+
+} // namespace util
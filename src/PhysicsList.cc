@@ -6,6 +6,7 @@
 #include "G4SystemOfUnits.hh"
 #include "G4DecayPhysics.hh"
 #include "G4EmStandardPhysics.hh"
+#include "G4FastSimulationPhysics.hh"
 #include "G4HadronPhysicsQGSP_BERT.hh"
 #include "G4IonPhysics.hh"
 
@@ -34,5 +35,11 @@ PhysicsList::PhysicsList() {
     RegisterPhysics(new G4IonPhysics());
 
     RegisterPhysics(new MuAlphaStepLimiterPhysics());
+
+    // Fast-simulation hook for mu-α (FreeFlightModel in the panel envelope);
+    // inert in regions without a model.
+    auto* fastSim = new G4FastSimulationPhysics();
+    fastSim->ActivateFastSimulation("muAlpha5p");
+    RegisterPhysics(fastSim);
 }
 // -----------------------------------------------------------------------------
\ No newline at end of file
@@ -6,10 +6,14 @@
 #include "G4MuonMinus.hh"
 #include "G4SystemOfUnits.hh"
 #include "G4Event.hh"
+#include "G4Run.hh"
+#include "G4RunManager.hh"
 #include "Randomize.hh"
 
 #include "PrimaryGenerator.hh"
+#include "EventRandom.hh"
 #include "MuAlpha5p.hh"
+#include "Strata.hh"
 
 
 // -----------------------------------------------------------------------------
@@ -20,12 +24,19 @@
  * in the +z direction with a user-defined kinetic energy.
  */
 // -----------------------------------------------------------------------------
-PrimaryGenerator::PrimaryGenerator() 
+PrimaryGenerator::PrimaryGenerator(const sim::RunConfig&       runCfg,
+                                   const geom::GeometryConfig& cfg)
+    : fRunCfg(runCfg)
+    , fSobol(runCfg.seed, runCfg.qmcReplicas)
 {
+    if (fRunCfg.Biased())
+        fFocus = std::make_unique<sim::FocusedBeam>(cfg, fRunCfg.beam, fRunCfg.biasFraction);
+
     fParticleGun = new G4ParticleGun(1); // One particle per event
 
     auto* particle = MuAlpha5p::Definition(); ///< Custom particle definition
     fParticleGun->SetParticleDefinition(particle);
+    fParticleGun->SetParticleEnergy(fRunCfg.beam.energy_MeV * MeV);
 }
 
 // -----------------------------------------------------------------------------
@@ -44,23 +55,73 @@ PrimaryGenerator::~PrimaryGenerator()
  */
 void PrimaryGenerator::GeneratePrimaries(G4Event* event) 
 {
-    // --- Spatial distribution (Gaussian beam around y-z plane at x = -10 µm)
-    G4double sigma_r = 100 * nm;
-    G4double r = sigma_r * std::sqrt(-2.0 * std::log(G4UniformRand()));
-    G4double phi = 2.0 * CLHEP::pi * G4UniformRand();
+    // --- Per-event seeding: the stream depends only on (seed, global event ID)
+    long seeds[3];
+    const G4Run* run = G4RunManager::GetRunManager()->GetCurrentRun();
+    const long global =
+        fRunCfg.GlobalEvent(run ? run->GetRunID() : 0, event->GetEventID());
+    sim::EventSeeds(fRunCfg.seed, global, seeds);
+    G4Random::setTheSeeds(seeds);
+
+    // --- CRN / Philox: kinematics + ionisation trials get their own streams
+    const bool streams = fRunCfg.CounterStreams();
+    if (streams)
+        sim::EventStreams::Begin(fRunCfg.seed, global,
+                                 fRunCfg.rng == sim::RngKind::Philox);
+
+    // --- Sobol sampler: coordinate d of the event's scrambled QMC point
+    int dim = 0;
+    auto uniform = [&] {
+        if (fRunCfg.Qmc()) return fSobol.Uniform(global, dim++);
+        return streams ? sim::EventStreams::Primary().Uniform() : G4UniformRand();
+    };
+
+    // --- Stratified beam: the event's cell of the (r, φ, θ, ψ) unit cube
+    const bool stratified = fRunCfg.Stratified();
+    double cell[4];
+    if (stratified)
+    {
+        double v[4];
+        for (double& u : v) u = uniform();
+        sim::Strata().Point(sim::Strata().StratumOf(event->GetEventID()), v, cell);
+    }
+    auto beamUniform = [&](int d) { return stratified ? cell[d] : uniform(); };
+
+    const sim::BeamSpec& beam = fRunCfg.beam;
+
+    // --- Spatial distribution (Gaussian beam around y-z plane at x = x0)
+    G4double x = beam.x0_nm * nm;  // Starting x-plane
+    G4double y, z;
+    G4double weight = 1.0;
+
+    if (fFocus && fFocus->PickFocused(uniform()))
+    {
+        // Biased part: the same spot restricted to the shell columns
+        G4double y_nm, z_nm;
+        const G4double uCell = uniform(), uy = uniform(), uz = uniform();
+        fFocus->SampleFocused(uCell, uy, uz, y_nm, z_nm);
+        y = y_nm * nm;
+        z = z_nm * nm;
+    }
+    else
+    {
+        G4double sigma_r = beam.sigma_nm * nm;
+        G4double r = sigma_r * std::sqrt(-2.0 * std::log(beamUniform(0)));
+        G4double phi = 2.0 * CLHEP::pi * beamUniform(1);
 
-    G4double x = -2.0 * um;  // Starting x-plane
-    G4double y = r * std::cos(phi);
-    G4double z_offset = 975 * nm;  // Shift beam to target the tip of the cone
-    G4double z = z_offset + r * std::sin(phi);
+        G4double z_offset = beam.z0_nm * nm;  // Shift beam to target the tip of the cone
+        y = r * std::cos(phi);
+        z = z_offset + r * std::sin(phi);
+    }
+    if (fFocus) weight = fFocus->Weight(y / nm, z / nm);
 
     fParticleGun->SetParticlePosition(G4ThreeVector(x, y, z));
 
     // --- Momentum direction (narrow cone around +x)
-    G4double angular_spread = 2.0 * CLHEP::deg;
+    G4double angular_spread = beam.max_theta_deg * CLHEP::deg;
 
-    G4double theta = angular_spread * G4UniformRand(); // [0, θ_max]
-    G4double psi   = 2.0 * CLHEP::pi * G4UniformRand(); // full azimuthal angle
+    G4double theta = angular_spread * beamUniform(2); // [0, θ_max]
+    G4double psi   = 2.0 * CLHEP::pi * beamUniform(3); // full azimuthal angle
 
     // Convert spherical deviation from x-axis
     G4ThreeVector direction(
@@ -72,6 +133,7 @@ void PrimaryGenerator::GeneratePrimaries(G4Event* event)
     fParticleGun->SetParticleMomentumDirection(direction);
 
     fParticleGun->GeneratePrimaryVertex(event);
+    event->GetPrimaryVertex()->SetWeight(weight);   // inherited by the track
 
     // G4cout << "[DEBUG] GeneratePrimaries called. Firing: muAlpha5p from "
     //        << fParticleGun->GetParticlePosition()
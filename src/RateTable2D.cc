@@ -6,26 +6,50 @@
  * unstructured 2D data in cylindrical (rho, z) coordinates.
  */
 
+#include <cstring>
 #include <fstream>
 #include <sstream>
 #include <algorithm>
 #include <cmath>
 #include <limits>
 #include <iostream>
+#include <iterator>
 
 #include "RateTable2D.hh"
+#include "Hashing.hh"
 
 // -----------------------------------------------------------------------------
 // Constructor: Load file and store raw points
 // -----------------------------------------------------------------------------
 RateTable2D::RateTable2D(const std::string& filename, char delim)
 {
-    std::ifstream fin(filename);
+    std::ifstream fin(filename, std::ios::binary);
     if (!fin)
         throw std::runtime_error("RateTable2D: cannot open file " + filename);
 
+    // Binary regular grid (AdkRateTable), else the text columns
+    RateGridHeader h{};
+    fin.read(reinterpret_cast<char*>(&h), sizeof h);
+    const bool binary = fin && std::memcmp(h.magic, "MARATE01", sizeof h.magic) == 0;
+    if (binary) {
+        std::vector<double> w(static_cast<std::size_t>(h.nRho) * h.nZ);
+        fin.read(reinterpret_cast<char*>(w.data()),
+                 static_cast<std::streamsize>(w.size() * sizeof(double)));
+        if (!fin || w.empty())
+            throw std::runtime_error("RateTable2D: truncated binary table " + filename);
+        mPoints.reserve(w.size());
+        for (std::uint32_t i = 0; i < h.nRho; ++i)
+            for (std::uint32_t j = 0; j < h.nZ; ++j)
+                mPoints.push_back({h.rho0 + i * h.hRho, h.z0 + j * h.hZ,
+                                   w[static_cast<std::size_t>(i) * h.nZ + j]});
+    }
+    else {
+        fin.clear();
+        fin.seekg(0);
+    }
+
     std::string line;
-    while (std::getline(fin, line)) {
+    while (!binary && std::getline(fin, line)) {
         if (line.empty() || line[0] == '#') continue;  // Skip comments
         std::replace(line.begin(), line.end(), delim, ' ');
         std::istringstream iss(line);
@@ -37,6 +61,39 @@ RateTable2D::RateTable2D(const std::string& filename, char delim)
 
     if (mPoints.empty())
         throw std::runtime_error("RateTable2D: no data loaded from file.");
+
+    GetBoundingBox(mMinRho, mMaxRho, mMinZ, mMaxZ);
+    for (const auto& pt : mPoints) {
+        mRhoSorted.push_back(pt.rho);
+        mZSorted.push_back(pt.z);
+    }
+    std::sort(mRhoSorted.begin(), mRhoSorted.end());
+    std::sort(mZSorted.begin(), mZSorted.end());
+
+    // Full rectangular grid → dense rates for GridInterp()
+    std::unique_copy(mRhoSorted.begin(), mRhoSorted.end(), std::back_inserter(mRhoNodes));
+    std::unique_copy(mZSorted.begin(),   mZSorted.end(),   std::back_inserter(mZNodes));
+    if (mRhoNodes.size() * mZNodes.size() == mPoints.size()) {
+        std::vector<char> seen(mPoints.size(), 0);
+        mGrid.resize(mPoints.size());
+        for (const auto& pt : mPoints) {
+            const std::size_t i = std::lower_bound(mRhoNodes.begin(), mRhoNodes.end(), pt.rho)
+                                - mRhoNodes.begin();
+            const std::size_t j = std::lower_bound(mZNodes.begin(), mZNodes.end(), pt.z)
+                                - mZNodes.begin();
+            const std::size_t k = i * mZNodes.size() + j;
+            if (seen[k]) { mGrid.clear(); break; }   // duplicate → some node missing
+            seen[k]  = 1;
+            mGrid[k] = pt.rate;
+        }
+    }
+
+    mChecksum = util::kFnvOffset;
+    for (const auto& pt : mPoints) {
+        mChecksum = util::Fnv1a(pt.rho,  mChecksum);
+        mChecksum = util::Fnv1a(pt.z,    mChecksum);
+        mChecksum = util::Fnv1a(pt.rate, mChecksum);
+    }
 }
 
 // -----------------------------------------------------------------------------
@@ -46,27 +103,8 @@ bool RateTable2D::Inside(double rho, double z) const
 {
     if (mPoints.empty()) return false;
 
-    double minRho = std::numeric_limits<double>::max();
-    double maxRho = std::numeric_limits<double>::lowest();
-    double minZ = std::numeric_limits<double>::max();
-    double maxZ = std::numeric_limits<double>::lowest();
-
-    for (const auto& pt : mPoints) {
-        minRho = std::min(minRho, pt.rho);
-        maxRho = std::max(maxRho, pt.rho);
-        minZ = std::min(minZ, pt.z);
-        maxZ = std::max(maxZ, pt.z);
-    }
-
-    // Debug output for bounding box
-    // std::cout << "[DEBUG] Bounding box: "
-    //        << "Rho [" << minRho << ", " << maxRho << "] m, "
-    //        << "Z [" << minZ << ", " << maxZ << "] m" 
-    //        << "Given Point (rho, z): (" << rho << 
-    //        ", " << z  << ")" << std::endl;
-
-    // Check if (rho, z) is within the bounding box
-    return (rho >= minRho && rho <= maxRho && z >= minZ && z <= maxZ);
+    // Check if (rho, z) is within the bounding box (cached by the ctor)
+    return (rho >= mMinRho && rho <= mMaxRho && z >= mMinZ && z <= mMaxZ);
 }
 
 // -----------------------------------------------------------------------------
@@ -93,6 +131,8 @@ void RateTable2D::GetBoundingBox(double& minRho, double& maxRho,
 // -----------------------------------------------------------------------------
 double RateTable2D::Interp(double rho, double z) const
 {
+    if (!mGrid.empty()) return GridInterp(rho, z);
+
     std::vector<RatePoint> neighbors;
     if (FindBilinearNeighbors(rho, z, neighbors)) {
         return BilinearInterp(neighbors, rho, z);
@@ -113,6 +153,41 @@ double RateTable2D::Interp(double rho, double z) const
     return bestValue;
 }
 
+// -----------------------------------------------------------------------------
+// GridInterp: Interp on a full grid – bisection for the cell, per-axis
+// nearest node outside it (the Euclidean nearest on a rectangular grid)
+// -----------------------------------------------------------------------------
+double RateTable2D::GridInterp(double rho, double z) const
+{
+    const std::size_t nR = mRhoNodes.size(), nZ = mZNodes.size();
+    const std::size_t i = std::lower_bound(mRhoNodes.begin(), mRhoNodes.end(), rho)
+                        - mRhoNodes.begin();
+    const std::size_t j = std::lower_bound(mZNodes.begin(), mZNodes.end(), z)
+                        - mZNodes.begin();
+
+    if (i > 0 && i < nR && j > 0 && j < nZ) {
+        // Same weights, in the same order, as BilinearInterp
+        const double x1 = mRhoNodes[i - 1], x2 = mRhoNodes[i];
+        const double y1 = mZNodes[j - 1],   y2 = mZNodes[j];
+        const double f11 = mGrid[(i - 1) * nZ + j - 1], f21 = mGrid[i * nZ + j - 1];
+        const double f12 = mGrid[(i - 1) * nZ + j],     f22 = mGrid[i * nZ + j];
+
+        const double denom = (x2 - x1) * (y2 - y1);
+        const double a = (x2 - rho) * (y2 - z) / denom;
+        const double b = (rho - x1) * (y2 - z) / denom;
+        const double c = (x2 - rho) * (z - y1) / denom;
+        const double d = (rho - x1) * (z - y1) / denom;
+        return a * f11 + b * f21 + c * f12 + d * f22;
+    }
+
+    auto nearest = [](const std::vector<double>& v, std::size_t k, double x) {
+        if (k == v.size()) return k - 1;
+        if (k == 0)        return k;
+        return (x - v[k - 1] <= v[k] - x) ? k - 1 : k;
+    };
+    return mGrid[nearest(mRhoNodes, i, rho) * nZ + nearest(mZNodes, j, z)];
+}
+
 // -----------------------------------------------------------------------------
 // FindBilinearNeighbors: Find the 4 corners of a rectangle enclosing the point
 // -----------------------------------------------------------------------------
@@ -121,15 +196,9 @@ bool RateTable2D::FindBilinearNeighbors(double rho, double z,
 {
     neighbors.clear();
 
-    // Create lists of points that lie on the same rows and columns
-    std::vector<double> rho_vals, z_vals;
-    for (const auto& pt : mPoints) {
-        rho_vals.push_back(pt.rho);
-        z_vals.push_back(pt.z);
-    }
-
-    std::sort(rho_vals.begin(), rho_vals.end());
-    std::sort(z_vals.begin(), z_vals.end());
+    // Sorted lists of the row / column coordinates (built once by the ctor)
+    const std::vector<double>& rho_vals = mRhoSorted;
+    const std::vector<double>& z_vals   = mZSorted;
     auto it_rho = std::lower_bound(rho_vals.begin(), rho_vals.end(), rho);
     auto it_z   = std::lower_bound(z_vals.begin(), z_vals.end(), z);
 
@@ -139,19 +208,19 @@ bool RateTable2D::FindBilinearNeighbors(double rho, double z,
     double r1 = *(it_rho - 1), r2 = *it_rho;
     double z1 = *(it_z - 1), z2 = *it_z;
 
-    // Find 4 corners (r1,z1), (r2,z1), (r1,z2), (r2,z2)
-    int found = 0;
+    // Find 4 corners (r1,z1), (r2,z1), (r1,z2), (r2,z2), stored in that
+    // order whatever the row order of the file (BilinearInterp relies on it)
+    neighbors.resize(4);
+    unsigned found = 0;                                    // one bit per corner
     for (const auto& pt : mPoints) {
-        if (std::fabs(pt.rho - r1) < 1e-12 && std::fabs(pt.z - z1) < 1e-12)
-            { neighbors.push_back(pt); ++found; continue; }
-        if (std::fabs(pt.rho - r2) < 1e-12 && std::fabs(pt.z - z1) < 1e-12)
-            { neighbors.push_back(pt); ++found; continue; }
-        if (std::fabs(pt.rho - r1) < 1e-12 && std::fabs(pt.z - z2) < 1e-12)
-            { neighbors.push_back(pt); ++found; continue; }
-        if (std::fabs(pt.rho - r2) < 1e-12 && std::fabs(pt.z - z2) < 1e-12)
-            { neighbors.push_back(pt); ++found; continue; }
+        const bool atR1 = std::fabs(pt.rho - r1) < 1e-12, atR2 = std::fabs(pt.rho - r2) < 1e-12;
+        const bool atZ1 = std::fabs(pt.z - z1) < 1e-12,   atZ2 = std::fabs(pt.z - z2) < 1e-12;
+        if (!(atR1 || atR2) || !(atZ1 || atZ2)) continue;
+        const int k = (atR1 ? 0 : 1) + (atZ1 ? 0 : 2);
+        neighbors[k] = pt;
+        found |= 1u << k;
     }
-    return (found == 4);
+    return (found == 0xFu);
 }
 
 // -----------------------------------------------------------------------------
@@ -179,4 +248,4 @@ double RateTable2D::BilinearInterp(const std::vector<RatePoint>& N,
 
     return a * f11 + b * f21 + c * f12 + d * f22;
 }
-// -----------------------------------------------------------------------------
\ No newline at end of file
+// -----------------------------------------------------------------------------
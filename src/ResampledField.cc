@@ -0,0 +1,402 @@
+/**
+ * @file    ResampledField.cc
+ * @author  Mohammadreza Zakeri
+ * @date    2026-10-18
+ *
+ * @brief   Regular-grid resampling of the field map and its mmap cache
+ *          (see ResampledField.hh).
+ */
+
+#include "ResampledField.hh"
+
+/*────────────────────────────── stdlib ───────────────────────────────────*/
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <thread>
+
+/*────────────────────────────── POSIX ────────────────────────────────────*/
+#include <unistd.h>     // getpid
+
+/*──────────────────────────── project ────────────────────────────────────*/
+#include "Hashing.hh"
+#include "RevolvedFieldFromPOS.hh"
+
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr char          kMagic[8]  = {'M', 'A', 'F', 'G', 'R', 'I', 'D', '1'};
+constexpr std::uint64_t kMaxNodes  = 1ULL << 27;   ///< Per level (2 GiB of doubles)
+
+/// On-disk header; the nodes follow immediately.
+struct FileHeader {
+    char                  magic[8];
+    std::uint64_t         posHash, specHash;
+    std::uint32_t         levels, bicubic;
+    ResampledField::Level level[2];
+    ResampledField::Error error[2];
+};
+static_assert(sizeof(FileHeader) % sizeof(double) == 0, "nodes must stay aligned");
+
+/// Grid spanning [r0, r1] × [z0, z1] with spacing ≤ h.
+ResampledField::Level MakeLevel(double r0, double r1, double z0, double z1,
+                                double h, std::uint64_t offset)
+{
+    const double nr = std::max(2.0, std::ceil((r1 - r0) / h) + 1);
+    const double nz = std::max(2.0, std::ceil((z1 - z0) / h) + 1);
+    if (nr * nz > kMaxNodes)
+        throw std::invalid_argument("ResampledField: grid of " + std::to_string(nr * nz) +
+                                    " nodes; increase the cell size");
+    ResampledField::Level L{};
+    L.r0 = r0;  L.hr = r1 > r0 ? (r1 - r0) / (nr - 1) : h;
+    L.z0 = z0;  L.hz = z1 > z0 ? (z1 - z0) / (nz - 1) : h;
+    L.nr = static_cast<std::uint32_t>(nr);
+    L.nz = static_cast<std::uint32_t>(nz);
+    L.offset = offset;
+    return L;
+}
+
+/// Cell index and fraction of coordinate `x` on an axis of `n` nodes.
+inline int Cell(double x, double x0, double invH, std::uint32_t n, double& t)
+{
+    const double f = std::clamp((x - x0) * invH, 0.0, static_cast<double>(n - 1));
+    const int    i = std::min(static_cast<int>(f), static_cast<int>(n) - 2);
+    t = f - i;
+    return i;
+}
+
+/// Catmull–Rom weights of nodes i−1 … i+2 at fraction t.
+inline void CubicWeights(double t, double w[4])
+{
+    const double t2 = t * t, t3 = t2 * t;
+    w[0] = 0.5 * (-t3 + 2 * t2 - t);
+    w[1] = 0.5 * (3 * t3 - 5 * t2 + 2);
+    w[2] = 0.5 * (-3 * t3 + 4 * t2 + t);
+    w[3] = 0.5 * (t3 - t2);
+}
+
+} // namespace
+
+/*══════════════════════════════════════════════════════════════════════════*/
+/* 1.  Spec                                                                 */
+/*══════════════════════════════════════════════════════════════════════════*/
+ResampledField::Spec ResampledField::Spec::FromConfig(const geom::FieldSpec& f)
+{
+    const auto& R = f.resample;
+    if (R.interpolation != "bilinear" && R.interpolation != "bicubic")
+        throw std::invalid_argument("field.resample.interpolation expects bilinear|bicubic, got "
+                                    + R.interpolation);
+    if (!(R.cell_nm > 0.0) || R.tip_cell_nm < 0.0)
+        throw std::invalid_argument("field.resample needs cell_nm > 0 and tip_cell_nm >= 0");
+
+    const double k = 1e-9 / f.pos_unit_m;               // nm → map units
+    Spec s;
+    s.cell    = R.cell_nm * k;
+    s.bicubic = R.interpolation == "bicubic";
+    if (R.Tip()) {
+        s.tipCell = R.tip_cell_nm  * k;
+        s.tipRMax = R.tip_r_max_nm * k;
+        s.tipZMin = R.tip_z_min_nm * k;
+        s.tipZMax = R.tip_z_max_nm * k;
+    }
+    return s;
+}
+
+std::uint64_t ResampledField::Spec::Hash() const
+{
+    std::uint64_t h = util::Fnv1a(std::string_view(kMagic, sizeof kMagic));
+    for (double x : {cell, tipCell, tipRMax, tipZMin, tipZMax, bicubic ? 1.0 : 0.0})
+        h = util::Fnv1a(x, h);
+    return h;
+}
+
+/*══════════════════════════════════════════════════════════════════════════*/
+/* 2.  Build from the mesh                                                  */
+/*══════════════════════════════════════════════════════════════════════════*/
+ResampledField::ResampledField(const RevolvedFieldFromPOS& mesh, const Spec& spec)
+: bicubic_(spec.bicubic), specHash_(spec.Hash())
+{
+    if (mesh.Size() == 0)
+        throw std::invalid_argument("ResampledField: empty field map");
+
+    double r0, r1, z0, z1;
+    mesh.Bounds(r0, r1, z0, z1);
+    level_[0] = MakeLevel(r0, r1, z0, z1, spec.cell, 0);
+    nLevels_  = 1;
+    if (spec.tipCell > 0.0) {
+        level_[1] = MakeLevel(0.0, spec.tipRMax, spec.tipZMin, spec.tipZMax, spec.tipCell,
+                              2ULL * level_[0].nr * level_[0].nz);
+        nLevels_  = 2;
+        tipRMax_  = spec.tipRMax;
+        tipZMin_  = spec.tipZMin;
+        tipZMax_  = spec.tipZMax;
+    }
+
+    const Level& last = level_[nLevels_ - 1];
+    owned_.resize(last.offset + 2ULL * last.nr * last.nz);
+    for (std::uint32_t l = 0; l < nLevels_; ++l) data_[l] = owned_.data() + level_[l].offset;
+
+    /*── 2.1  Nodes: rows split over the hardware threads ────────────────*/
+    const unsigned nThreads = std::max(1u, std::thread::hardware_concurrency());
+    for (std::uint32_t l = 0; l < nLevels_; ++l) {
+        const Level& L = level_[l];
+        double*      d = owned_.data() + L.offset;
+        auto rows = [&](std::uint32_t j0) {
+            for (std::uint32_t j = j0; j < L.nz; j += nThreads)
+                for (std::uint32_t i = 0; i < L.nr; ++i) {
+                    double* e = d + 2 * (static_cast<std::size_t>(j) * L.nr + i);
+                    mesh.FieldRZ(L.r0 + i * L.hr, L.z0 + j * L.hz, e[0], e[1]);
+                }
+        };
+        std::vector<std::thread> pool;
+        for (unsigned t = 1; t < nThreads; ++t) pool.emplace_back(rows, t);
+        rows(0);
+        for (auto& t : pool) t.join();
+    }
+
+    /*── 2.2  Error at the triangle centroids ────────────────────────────*/
+    double sum2[2] = {0.0, 0.0};
+    for (std::size_t k = 0; k < mesh.Triangles(); ++k) {
+        double r, z, Er, Ez, gr, gz;
+        mesh.Centroid(k, r, z);
+        mesh.FieldRZ(r, z, Er, Ez);
+        FieldRZ(r, z, gr, gz);
+
+        Error& e = error_[Pick(r, z)];
+        const double d2 = (gr - Er) * (gr - Er) + (gz - Ez) * (gz - Ez);
+        ++e.samples;
+        sum2[Pick(r, z)] += d2;
+        e.maxAbs = std::max(e.maxAbs, std::sqrt(d2));
+        e.peak   = std::max(e.peak, std::hypot(Er, Ez));
+    }
+    for (int l = 0; l < 2; ++l)
+        if (error_[l].samples) error_[l].rms = std::sqrt(sum2[l] / error_[l].samples);
+}
+
+ResampledField::ResampledField(const Level& L, std::vector<double> nodes, bool bicubic,
+                               std::uint64_t posHash, std::uint64_t specHash)
+: nLevels_{1}, bicubic_{bicubic}, posHash_{posHash}, specHash_{specHash},
+  owned_{std::move(nodes)}
+{
+    if (L.nr < 2 || L.nz < 2 || owned_.size() != 2ULL * L.nr * L.nz)
+        throw std::invalid_argument("ResampledField: node count does not match the grid");
+    level_[0]        = L;
+    level_[0].offset = 0;
+    data_[0]         = owned_.data();
+}
+
+/*══════════════════════════════════════════════════════════════════════════*/
+/* 3.  Cache file                                                           */
+/*══════════════════════════════════════════════════════════════════════════*/
+ResampledField::ResampledField(const std::string& path)
+{
+    try { map_ = util::MappedFile(path); }
+    catch (const std::runtime_error& e) { throw std::runtime_error(std::string("ResampledField: ") + e.what()); }
+    if (map_.Size() < sizeof(FileHeader))
+        throw std::runtime_error("ResampledField: truncated " + path);
+
+    FileHeader h;
+    std::memcpy(&h, map_.Data(), sizeof h);
+    const auto*  nodes = reinterpret_cast<const double*>(map_.Data() + sizeof h);
+    const std::size_t have = (map_.Size() - sizeof h) / sizeof(double);
+    bool ok = std::memcmp(h.magic, kMagic, sizeof kMagic) == 0 && h.levels >= 1 && h.levels <= 2;
+    for (std::uint32_t l = 0; ok && l < h.levels; ++l)
+        ok = h.level[l].nr >= 2 && h.level[l].nz >= 2 &&
+             h.level[l].offset + 2ULL * h.level[l].nr * h.level[l].nz <= have;
+    if (!ok)
+        throw std::runtime_error("ResampledField: not a field grid: " + path);
+
+    nLevels_  = h.levels;
+    bicubic_  = h.bicubic != 0;
+    posHash_  = h.posHash;
+    specHash_ = h.specHash;
+    for (std::uint32_t l = 0; l < nLevels_; ++l) {
+        level_[l] = h.level[l];
+        error_[l] = h.error[l];
+        data_[l]  = nodes + level_[l].offset;
+    }
+    if (nLevels_ > 1) {
+        tipRMax_ = level_[1].r0 + level_[1].hr * (level_[1].nr - 1);
+        tipZMin_ = level_[1].z0;
+        tipZMax_ = level_[1].z0 + level_[1].hz * (level_[1].nz - 1);
+    }
+}
+
+ResampledField::~ResampledField() = default;
+
+void ResampledField::Write(const std::string& path) const
+{
+    FileHeader h{};
+    std::memcpy(h.magic, kMagic, sizeof kMagic);
+    h.posHash  = posHash_;
+    h.specHash = specHash_;
+    h.levels   = nLevels_;
+    h.bicubic  = bicubic_;
+    for (std::uint32_t l = 0; l < nLevels_; ++l) {
+        h.level[l] = level_[l];
+        h.error[l] = error_[l];
+    }
+
+    const std::string tmp = path + ".tmp" + std::to_string(::getpid());
+    {
+        std::ofstream out(tmp, std::ios::binary);
+        out.write(reinterpret_cast<const char*>(&h), sizeof h);
+        for (std::uint32_t l = 0; l < nLevels_; ++l)
+            out.write(reinterpret_cast<const char*>(data_[l]),
+                      static_cast<std::streamsize>(2 * sizeof(double) * level_[l].nr * level_[l].nz));
+        if (!out) {
+            std::error_code ec;
+            fs::remove(tmp, ec);
+            throw std::runtime_error("ResampledField: cannot write " + tmp);
+        }
+    }
+    fs::rename(tmp, path);
+}
+
+std::string ResampledField::CachePath(const geom::FieldSpec& f)
+{
+    return (fs::path(f.resample.cache_dir) /
+            (util::HashHex(util::Fnv1aFile(f.pos_file)) + "_" +
+             util::HashHex(Spec::FromConfig(f).Hash()) + ".fgrid")).string();
+}
+
+std::shared_ptr<const ResampledField>
+ResampledField::LoadOrBuild(const geom::FieldSpec& f, std::ostream& log, bool rebuild)
+{
+    const Spec          spec    = Spec::FromConfig(f);
+    const std::uint64_t posHash = util::Fnv1aFile(f.pos_file);
+    const std::string   path    = CachePath(f);
+
+    if (!rebuild && fs::exists(path)) {
+        try {
+            auto cached = std::make_shared<const ResampledField>(path);
+            if (cached->posHash_ == posHash && cached->specHash_ == spec.Hash()) {
+                log << "Field grid: " << path << " (cached)\n";
+                cached->Report(log);
+                return cached;
+            }
+        } catch (const std::runtime_error& e) {
+            log << e.what() << " – rebuilding\n";
+        }
+    }
+
+    const RevolvedFieldFromPOS mesh(f.pos_file);
+    if (mesh.Size() == 0)
+        throw std::runtime_error("ResampledField: no VT field points in " + f.pos_file);
+
+    auto built = std::make_shared<ResampledField>(mesh, spec);
+    built->posHash_ = posHash;
+    log << "Field grid: resampled " << f.pos_file << '\n';
+    built->Report(log);
+
+    try {
+        fs::create_directories(f.resample.cache_dir);
+        built->Write(path);
+        log << "Field grid: wrote " << path << '\n';
+        return std::make_shared<const ResampledField>(path);
+    } catch (const std::exception& e) {
+        log << e.what() << " – keeping the grid in memory\n";
+        return built;
+    }
+}
+
+void ResampledField::Report(std::ostream& os) const
+{
+    static const char* names[2] = {"coarse", "tip   "};
+    for (std::uint32_t l = 0; l < nLevels_; ++l) {
+        const Level& L = level_[l];
+        const Error& e = error_[l];
+        os << "  " << names[l] << ' ' << L.nr << " x " << L.nz << " nodes, h = ("
+           << L.hr << ", " << L.hz << "), " << (bicubic_ ? "bicubic" : "bilinear");
+        if (e.samples == 0) { os << '\n';  continue; }        // not from a mesh
+        os << "; vs mesh at " << e.samples << " centroids: max |dE| " << e.maxAbs
+           << ", rms " << e.rms;
+        if (e.peak > 0.0) os << " (" << e.maxAbs / e.peak << " / " << e.rms / e.peak
+                             << " of peak |E| " << e.peak << ')';
+        os << '\n';
+    }
+}
+
+/*══════════════════════════════════════════════════════════════════════════*/
+/* 4.  Lookup                                                               */
+/*══════════════════════════════════════════════════════════════════════════*/
+void ResampledField::FieldRZ(double r, double z, double& Er, double& Ez) const
+{
+    const int l = Pick(r, z);
+    if (bicubic_) Bicubic (level_[l], data_[l], r, z, Er, Ez);
+    else          Bilinear(level_[l], data_[l], r, z, Er, Ez);
+}
+
+void ResampledField::Bounds(double& r0, double& r1, double& z0, double& z1) const
+{
+    const Level& L = level_[0];
+    r0 = L.r0;  r1 = L.r0 + L.hr * (L.nr - 1);
+    z0 = L.z0;  z1 = L.z0 + L.hz * (L.nz - 1);
+}
+
+void ResampledField::Bilinear(const Level& L, const double* d, double r, double z,
+                              double& Er, double& Ez) const
+{
+    double tr, tz;
+    const int i = Cell(r, L.r0, 1.0 / L.hr, L.nr, tr);
+    const int j = Cell(z, L.z0, 1.0 / L.hz, L.nz, tz);
+    const double* a = d + 2 * (static_cast<std::size_t>(j) * L.nr + i);
+    const double* b = a + 2 * static_cast<std::size_t>(L.nr);
+    const double w00 = (1 - tr) * (1 - tz), w10 = tr * (1 - tz);
+    const double w01 = (1 - tr) * tz,       w11 = tr * tz;
+    Er = w00 * a[0] + w10 * a[2] + w01 * b[0] + w11 * b[2];
+    Ez = w00 * a[1] + w10 * a[3] + w01 * b[1] + w11 * b[3];
+}
+
+void ResampledField::Bicubic(const Level& L, const double* d, double r, double z,
+                             double& Er, double& Ez) const
+{
+    double tr, tz, wr[4], wz[4];
+    const int i = Cell(r, L.r0, 1.0 / L.hr, L.nr, tr);
+    const int j = Cell(z, L.z0, 1.0 / L.hz, L.nz, tz);
+    CubicWeights(tr, wr);
+    CubicWeights(tz, wz);
+    Er = Ez = 0.0;
+
+    // Interior: the 4 × 4 stencil lies on the grid
+    const int  nr = static_cast<int>(L.nr), nz = static_cast<int>(L.nz);
+    if (i >= 1 && i + 2 < nr && j >= 1 && j + 2 < nz) {
+        const double* row = d + 2 * (static_cast<std::size_t>(j - 1) * L.nr + (i - 1));
+        for (int b = 0; b < 4; ++b, row += 2 * static_cast<std::size_t>(L.nr)) {
+            const double sr = wr[0] * row[0] + wr[1] * row[2] + wr[2] * row[4] + wr[3] * row[6];
+            const double sz = wr[0] * row[1] + wr[1] * row[3] + wr[2] * row[5] + wr[3] * row[7];
+            Er += wz[b] * sr;
+            Ez += wz[b] * sz;
+        }
+        return;
+    }
+
+    // Node (ii, jj) with one ghost layer: mirrored across the axis when the
+    // grid starts at r = 0, linearly extrapolated at the other edges.
+    const bool axis = L.r0 == 0.0;
+    auto at = [&](int ii, int jj, int c) {
+        return d[2 * (static_cast<std::size_t>(jj) * L.nr + ii) + c];
+    };
+    auto column = [&](int ii, int jj, int c) {
+        if (jj < 0)   return 2 * at(ii, 0, c)      - at(ii, 1, c);
+        if (jj >= nz) return 2 * at(ii, nz - 1, c) - at(ii, nz - 2, c);
+        return at(ii, jj, c);
+    };
+    auto node = [&](int ii, int jj, int c) {
+        if (ii < 0)   return axis ? (c == 0 ? -column(1, jj, c) : column(1, jj, c))
+                                  : 2 * column(0, jj, c) - column(1, jj, c);
+        if (ii >= nr) return 2 * column(nr - 1, jj, c) - column(nr - 2, jj, c);
+        return column(ii, jj, c);
+    };
+
+    for (int b = 0; b < 4; ++b)
+        for (int a = 0; a < 4; ++a) {
+            const double w = wr[a] * wz[b];
+            Er += w * node(i - 1 + a, j - 1 + b, 0);
+            Ez += w * node(i - 1 + a, j - 1 + b, 1);
+        }
+}
@@ -1,106 +1,289 @@
 // RevolvedFieldFromPOS.cc
 // Parses axisymmetric .pos field and projects into Geant4 3D cartesian field
 
-#include <fstream>
-#include <sstream>
+#include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <cstring>
 #include <iostream>
+#include <limits>
+#include <unordered_map>
 
+#include "GmshReader.hh"
 #include "RevolvedFieldFromPOS.hh"
 
+namespace {
+constexpr double kBaryTol  = 1e-10;      ///< Slack of the point-in-triangle test
+constexpr long   kMaxCells = 1L << 22;   ///< Upper bound on grid cells
+
+std::atomic<std::uint64_t> gNextId {1};
+
+/// Hash of an exact (r, z) pair, for vertex deduplication
+struct PairHash {
+    std::size_t operator()(const std::pair<double, double>& p) const noexcept
+    {
+        std::uint64_t a, b;
+        std::memcpy(&a, &p.first, sizeof a);
+        std::memcpy(&b, &p.second, sizeof b);
+        return std::hash<std::uint64_t>{}(a ^ (b * 0x9E3779B97F4A7C15ULL));
+    }
+};
+}
+
 // -----------------------------------------------------------------------------
 /**
  * @brief Constructor that loads the .pos file containing VT entries.
  * @param filename Path to the Gmsh .pos file
  */
 // -----------------------------------------------------------------------------
-RevolvedFieldFromPOS::RevolvedFieldFromPOS(const std::string& filename) 
+RevolvedFieldFromPOS::RevolvedFieldFromPOS(const std::string& filename)
+: id{gNextId.fetch_add(1)}
 {
     LoadPOS(filename);
+    BuildIndex();
 }
 
 // -----------------------------------------------------------------------------
 /**
- * @brief Load and parse the .pos file containing Gmsh VT (vector triangle) entries.
+ * @brief Load the VT triangles of a .pos file (or the view of a .msh file).
  *
- * Each line of the .pos file contains a triangle in the form:
- * VT(x1,y1,z1, x2,y2,z2, x3,y3,z3){Ex1,Ey1,Ez1, Ex2,Ey2,Ez2, Ex3,Ey3,Ez3};
- * We extract the 3 vertices and their electric field values, convert them to
- * cylindrical coordinates (r, z), and store them for nearest-neighbor lookup.
+ * The text is parsed in parallel by util::ReadPosTriangles (GmshReader.hh),
+ * which already converts the vertices to cylindrical (r, z).  Here each
+ * distinct vertex is stored once and every triangle keeps its own three
+ * field values.  An unreadable or malformed file leaves the map empty.
  *
- * @param filename Path to the .pos file
+ * @param filename Path to the .pos (or .msh) file
  */
 // -----------------------------------------------------------------------------
-void RevolvedFieldFromPOS::LoadPOS(const std::string& filename) 
+void RevolvedFieldFromPOS::LoadPOS(const std::string& filename)
 {
-    std::ifstream in(filename);
-    std::string line;
+    std::vector<util::GmshTriangle> raw;
+    try {
+        raw = util::IsMshFile(filename) ? util::ReadMshTriangles(filename)
+                                        : util::ReadPosTriangles(filename);
+    } catch (const std::exception& e) {
+        std::cerr << "RevolvedFieldFromPOS: " << filename << ": " << e.what() << std::endl;
+    }
 
-    while (std::getline(in, line)) {
-        if (line.find("View") != std::string::npos) continue;
-        if (line.find("VT(") == std::string::npos) continue;
+    std::unordered_map<std::pair<double, double>, std::uint32_t, PairHash> index;
+    index.reserve(raw.size());
+    triangles.reserve(raw.size());
+    std::size_t degenerate = 0;
 
-        // Extract coordinate and field substrings
-        size_t p1 = line.find("(");
-        size_t p2 = line.find(")", p1);
-        std::string coordsStr = line.substr(p1 + 1, p2 - p1 - 1);
+    for (const auto& g : raw) {
+        Triangle t{};
+        for (int i = 0; i < 3; ++i) {
+            auto [it, added] = index.try_emplace({g.r[i], g.z[i]}, static_cast<std::uint32_t>(nodes.size()));
+            if (added) nodes.push_back({g.r[i], g.z[i], g.Er[i], g.Ez[i]});
+            t.v[i]  = it->second;
+            t.Er[i] = g.Er[i];
+            t.Ez[i] = g.Ez[i];
+        }
 
-        size_t b1 = line.find("{");
-        size_t b2 = line.find("}", b1);
-        std::string fieldStr = line.substr(b1 + 1, b2 - b1 - 1);
+        // [l1, l2] = inverse([v1 − v0, v2 − v0]) · (p − v0)
+        const Node &a = nodes[t.v[0]], &b = nodes[t.v[1]], &c = nodes[t.v[2]];
+        const double m00 = b.r - a.r, m01 = c.r - a.r;
+        const double m10 = b.z - a.z, m11 = c.z - a.z;
+        const double det = m00 * m11 - m01 * m10;
+        if (det == 0.0) { ++degenerate; continue; }
+        t.r0 = a.r;  t.z0 = a.z;
+        t.inv[0] =  m11 / det;  t.inv[1] = -m01 / det;
+        t.inv[2] = -m10 / det;  t.inv[3] =  m00 / det;
+        triangles.push_back(t);
+    }
 
-        std::istringstream coords(coordsStr);
-        std::istringstream fields(fieldStr);
+    std::cout << "Loaded " << triangles.size() << " triangles, " << nodes.size()
+              << " distinct vertices from " << (util::IsMshFile(filename) ? "MSH" : "POS");
+    if (degenerate) std::cout << " (" << degenerate << " degenerate skipped)";
+    std::cout << "." << std::endl;
+}
 
-        double x[3], y[3], z[3], Ex[3], Ey[3], Ez[3];
-        for (int i = 0; i < 3; ++i)
-            coords >> x[i] >> y[i] >> z[i];
-        for (int i = 0; i < 3; ++i)
-            fields >> Ex[i] >> Ey[i] >> Ez[i];
+// -----------------------------------------------------------------------------
+/**
+ * @brief Bin triangles (by bounding box) and vertices into a uniform grid.
+ *
+ * The cell side is chosen so that there is about one triangle per cell on
+ * average; meshes refined near the tip simply put more triangles into the
+ * cells there.
+ */
+// -----------------------------------------------------------------------------
+void RevolvedFieldFromPOS::BuildIndex()
+{
+    if (nodes.empty()) return;
 
-        for (int i = 0; i < 3; ++i) {
-            double r = std::sqrt(x[i] * x[i] + y[i] * y[i]);
-            fieldPoints.push_back({r, z[i], G4ThreeVector(Ex[i], 0.0, Ez[i])});
-        }
+    double rMax = -std::numeric_limits<double>::infinity(), zMax = rMax;
+    rMin = zMin = std::numeric_limits<double>::infinity();
+    for (const auto& n : nodes) {
+        rMin = std::min(rMin, n.r);  rMax = std::max(rMax, n.r);
+        zMin = std::min(zMin, n.z);  zMax = std::max(zMax, n.z);
     }
+    const double w = std::max(rMax - rMin, 1e-300), h = std::max(zMax - zMin, 1e-300);
+    const double nCells = std::clamp<double>(static_cast<double>(triangles.size()), 1.0,
+                                             static_cast<double>(kMaxCells));
+    cell = std::sqrt(w * h / nCells);
+    cell = std::max({cell, w / kMaxCells, h / kMaxCells});
+    nr = std::max(1, static_cast<int>(std::ceil(w / cell)));
+    nz = std::max(1, static_cast<int>(std::ceil(h / cell)));
+
+    auto ir = [&](double r) { return std::clamp(static_cast<int>((r - rMin) / cell), 0, nr - 1); };
+    auto iz = [&](double z) { return std::clamp(static_cast<int>((z - zMin) / cell), 0, nz - 1); };
+
+    // Two passes per list: count, then fill (compressed rows)
+    auto build = [&](std::vector<std::uint32_t>& start, std::vector<std::uint32_t>& list,
+                     std::size_t n, auto&& cells) {
+        start.assign(static_cast<std::size_t>(nr) * nz + 1, 0);
+        for (std::size_t k = 0; k < n; ++k)
+            cells(k, [&](std::size_t c) { ++start[c + 1]; });
+        for (std::size_t c = 1; c < start.size(); ++c) start[c] += start[c - 1];
+        list.resize(start.back());
+        std::vector<std::uint32_t> fill(start.begin(), start.end() - 1);
+        for (std::size_t k = 0; k < n; ++k)
+            cells(k, [&](std::size_t c) { list[fill[c]++] = static_cast<std::uint32_t>(k); });
+    };
+
+    build(triStart, triList, triangles.size(), [&](std::size_t k, auto&& emit) {
+        const auto& t = triangles[k];
+        double r0 = nodes[t.v[0]].r, r1 = r0, z0 = nodes[t.v[0]].z, z1 = z0;
+        for (int i = 1; i < 3; ++i) {
+            r0 = std::min(r0, nodes[t.v[i]].r);  r1 = std::max(r1, nodes[t.v[i]].r);
+            z0 = std::min(z0, nodes[t.v[i]].z);  z1 = std::max(z1, nodes[t.v[i]].z);
+        }
+        for (int j = iz(z0); j <= iz(z1); ++j)
+            for (int i = ir(r0); i <= ir(r1); ++i)
+                emit(static_cast<std::size_t>(j) * nr + i);
+    });
+    build(nodeStart, nodeList, nodes.size(), [&](std::size_t k, auto&& emit) {
+        emit(static_cast<std::size_t>(iz(nodes[k].z)) * nr + ir(nodes[k].r));
+    });
+}
 
-    std::cout << "Loaded " << fieldPoints.size() << " field points from POS." << std::endl;
+// -----------------------------------------------------------------------------
+bool RevolvedFieldFromPOS::Inside(const Triangle& t, double r, double z, double lambda[3])
+{
+    const double dr = r - t.r0, dz = z - t.z0;
+    const double l1 = t.inv[0] * dr + t.inv[1] * dz;
+    const double l2 = t.inv[2] * dr + t.inv[3] * dz;
+    if (l1 < -kBaryTol || l2 < -kBaryTol || l1 + l2 > 1.0 + kBaryTol) return false;
+    lambda[0] = 1.0 - l1 - l2;
+    lambda[1] = l1;
+    lambda[2] = l2;
+    return true;
 }
 
 // -----------------------------------------------------------------------------
 /**
- * @brief Get the interpolated electric field at a 3D position using nearest neighbor.
+ * @brief Point location: last triangle of this thread first, then the cell.
  *
- * Converts (x, y, z) to cylindrical (r, z), finds the closest field point in the
- * preloaded axisymmetric dataset, and rotates the (Er, Ez) into Cartesian coordinates.
+ * The hint is keyed on `id`, not the address: a map built where a freed one
+ * lived (e.g. the temporary of ResampledField::LoadOrBuild) must not reuse
+ * the old mesh's triangle index.
+ */
+// -----------------------------------------------------------------------------
+long RevolvedFieldFromPOS::Locate(double r, double z, double lambda[3]) const
+{
+    thread_local struct { std::uint64_t id; long tri; } last {0, -1};
+
+    if (last.id == id && last.tri >= 0 && static_cast<std::size_t>(last.tri) < triangles.size()
+        && Inside(triangles[last.tri], r, z, lambda))
+        return last.tri;
+    if (triStart.empty()) return -1;
+
+    const double fr = (r - rMin) / cell, fz = (z - zMin) / cell;
+    if (fr < 0.0 || fz < 0.0 || fr > nr || fz > nz) return -1;
+    const std::size_t c = static_cast<std::size_t>(std::min(static_cast<int>(fz), nz - 1)) * nr
+                        + std::min(static_cast<int>(fr), nr - 1);
+
+    for (std::uint32_t k = triStart[c]; k < triStart[c + 1]; ++k)
+        if (Inside(triangles[triList[k]], r, z, lambda)) {
+            last = {id, static_cast<long>(triList[k])};
+            return last.tri;
+        }
+    return -1;
+}
+
+// -----------------------------------------------------------------------------
+/**
+ * @brief Nearest vertex by ring search around the (clamped) cell.
  *
- * @param pos The 3D position in Cartesian coordinates (x, y, z)
- * @return Electric field vector (Ex, Ey, Ez) at the requested point
+ * Every vertex in ring k (Chebyshev distance k from the start cell) lies at
+ * least (k − 1)·cell away, even for points outside the grid, so the search
+ * stops once the best distance is ≤ k·cell.  Ties keep the earlier vertex.
  */
 // -----------------------------------------------------------------------------
-G4ThreeVector RevolvedFieldFromPOS::GetField(const G4ThreeVector& pos) const 
+std::size_t RevolvedFieldFromPOS::Nearest(double r, double z) const
 {
-    double x = pos.x(), y = pos.y(), z = pos.z();
-    double r = std::sqrt(x * x + y * y);
-
-    double minDist2 = 1e9;
-    G4ThreeVector E_nearest(0, 0, 0);
-
-    for (const auto& pt : fieldPoints) {
-        double dr = pt.r - r;
-        double dz = pt.z - z;
-        double dist2 = dr * dr + dz * dz;
-        if (dist2 < minDist2) {
-            minDist2 = dist2;
-            E_nearest = pt.E;
+    const int i0 = std::clamp(static_cast<int>(std::floor((r - rMin) / cell)), 0, nr - 1);
+    const int j0 = std::clamp(static_cast<int>(std::floor((z - zMin) / cell)), 0, nz - 1);
+
+    std::size_t best = 0;
+    double      bestD2 = std::numeric_limits<double>::infinity();
+    auto scan = [&](int i, int j) {
+        if (i < 0 || i >= nr || j < 0 || j >= nz) return;
+        const std::size_t c = static_cast<std::size_t>(j) * nr + i;
+        for (std::uint32_t k = nodeStart[c]; k < nodeStart[c + 1]; ++k) {
+            const Node& n = nodes[nodeList[k]];
+            const double d2 = (n.r - r) * (n.r - r) + (n.z - z) * (n.z - z);
+            if (d2 < bestD2 || (d2 == bestD2 && nodeList[k] < best)) {
+                bestD2 = d2;
+                best   = nodeList[k];
+            }
         }
+    };
+
+    const int kMax = std::max(nr, nz);
+    for (int k = 0; k <= kMax; ++k) {
+        if (k == 0) scan(i0, j0);
+        for (int d = -k; d <= k && k > 0; ++d) {
+            scan(i0 + d, j0 - k);  scan(i0 + d, j0 + k);
+            if (d != -k && d != k) { scan(i0 - k, j0 + d);  scan(i0 + k, j0 + d); }
+        }
+        if (bestD2 <= (k * cell) * (k * cell)) break;
     }
+    return best;
+}
 
-    // Project radial field into x-y plane
-    if (r < 1e-9) return G4ThreeVector(0, 0, E_nearest.z());
-    double Ex = E_nearest.x() * x / r;
-    double Ey = E_nearest.x() * y / r;
-    double Ez = E_nearest.z();
-    return G4ThreeVector(Ex, Ey, Ez);
+// -----------------------------------------------------------------------------
+void RevolvedFieldFromPOS::Bounds(double& r0, double& r1, double& z0, double& z1) const
+{
+    r0 = z0 =  std::numeric_limits<double>::infinity();
+    r1 = z1 = -std::numeric_limits<double>::infinity();
+    for (const auto& n : nodes) {
+        r0 = std::min(r0, n.r);  r1 = std::max(r1, n.r);
+        z0 = std::min(z0, n.z);  z1 = std::max(z1, n.z);
+    }
 }
-// -----------------------------------------------------------------------------
\ No newline at end of file
+
+// -----------------------------------------------------------------------------
+void RevolvedFieldFromPOS::Centroid(std::size_t i, double& r, double& z) const
+{
+    const Triangle& t = triangles[i];
+    r = (nodes[t.v[0]].r + nodes[t.v[1]].r + nodes[t.v[2]].r) / 3.0;
+    z = (nodes[t.v[0]].z + nodes[t.v[1]].z + nodes[t.v[2]].z) / 3.0;
+}
+
+// -----------------------------------------------------------------------------
+/**
+ * @brief Interpolated (Er, Ez) at cylindrical (r, z).
+ *
+ * Interpolates in the containing triangle (nearest vertex outside the
+ * mesh).  AxisymmetricField::Field() rotates the result into Cartesian
+ * coordinates.
+ */
+// -----------------------------------------------------------------------------
+void RevolvedFieldFromPOS::FieldRZ(double r, double z, double& Er, double& Ez) const
+{
+    if (nodes.empty()) { Er = Ez = 0.0; return; }
+
+    double lambda[3];
+    const long t = Locate(r, z, lambda);
+    if (t >= 0) {
+        const Triangle& T = triangles[t];
+        Er = lambda[0] * T.Er[0] + lambda[1] * T.Er[1] + lambda[2] * T.Er[2];
+        Ez = lambda[0] * T.Ez[0] + lambda[1] * T.Ez[1] + lambda[2] * T.Ez[2];
+    } else {
+        const Node& n = nodes[Nearest(r, z)];
+        Er = n.Er;
+        Ez = n.Ez;
+    }
+}
+// -----------------------------------------------------------------------------
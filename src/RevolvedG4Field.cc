@@ -1,4 +1,5 @@
 #include "RevolvedG4Field.hh"
+#include "G4SystemOfUnits.hh"
 
 // -----------------------------------------------------------------------------
 /**
@@ -7,7 +8,23 @@
  * @param filename Path to the Gmsh .pos file
  */
 RevolvedG4Field::RevolvedG4Field(const std::string& filename)
-    : fieldMap(filename) {}
+    : fieldMap(std::make_shared<RevolvedFieldFromPOS>(filename)) {}
+// -----------------------------------------------------------------------------
+/**
+ * @brief Constructor that places a shared, already loaded map in the world.
+ */
+RevolvedG4Field::RevolvedG4Field(std::shared_ptr<const AxisymmetricField> map,
+                                 const G4ThreeVector& origin,
+                                 G4double lengthUnit, G4double fieldUnit)
+    : fieldMap(std::move(map)), origin(origin),
+      lengthUnit(lengthUnit), fieldUnit(fieldUnit) {}
+// -----------------------------------------------------------------------------
+/**
+ * @brief Constructor that superposes the map over every cone of the lattice.
+ */
+RevolvedG4Field::RevolvedG4Field(std::shared_ptr<const ConeLatticeField> lattice,
+                                 G4double fieldUnit)
+    : lattice(std::move(lattice)), fieldUnit(fieldUnit) {}
 // -----------------------------------------------------------------------------
 /**
  * @brief Implements the Geant4 field interface using the wrapped field map.
@@ -16,8 +33,14 @@ RevolvedG4Field::RevolvedG4Field(const std::string& filename)
  */
 void RevolvedG4Field::GetFieldValue(const double point[4],
                                     double* field) const {
-  G4ThreeVector pos(point[0], point[1], point[2]);
-  G4ThreeVector E = fieldMap.GetField(pos);
+  double e[3];
+  if (lattice) {
+    lattice->Field(point[0] / CLHEP::nm, point[1] / CLHEP::nm, point[2] / CLHEP::nm, e);
+  } else {
+    const G4ThreeVector pos = (G4ThreeVector(point[0], point[1], point[2]) - origin) / lengthUnit;
+    fieldMap->Field(pos.x(), pos.y(), pos.z(), e);
+  }
+  const G4ThreeVector E = fieldUnit * G4ThreeVector(e[0], e[1], e[2]);
 
   field[0] = E.x();  // Ex
   field[1] = E.y();  // Ey
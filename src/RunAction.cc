@@ -15,13 +15,24 @@
 /*──────────────────────────── project ────────────────────────────────*/
 // #include "HistogramManager.hh"
 #include "DataLogger.hh"
+#include "RunStats.hh"
+
+/*──────────────────────────── stdlib ─────────────────────────────────*/
+#include <cmath>
 
 /*═════════════════════════════════════════════════════════════════════*/
 /*  ctor – register accumulables                                       */
 /*═════════════════════════════════════════════════════════════════════*/
 RunAction::RunAction(const geom::GeometryConfig &cfg,
-					 util::DataLogger *logger)
-	: cfg_{cfg}, logger_{logger}, nCones_{cfg.nCones()}, nPanels_{cfg.nPanels()}, coneIon_(nCones_), coneCap_(nCones_), panelIon_(nPanels_), panelCap_(nPanels_)
+					 util::DataLogger *logger,
+					 const sim::RunConfig &runCfg)
+	: cfg_{cfg}, logger_{logger}, nCones_{cfg.nCones()}, nPanels_{cfg.nPanels()}, runCfg_{runCfg},
+	  cumConeIon_(nCones_), cumConeCap_(nCones_), cumPanelIon_(nPanels_), cumPanelCap_(nPanels_),
+	  stratEst_(runCfg.NStrata()),
+	  coneIon_(nCones_), coneCap_(nCones_), panelIon_(nPanels_), panelCap_(nPanels_),
+	  outcomes_(runCfg.crn ? static_cast<std::size_t>(runCfg.nEvents) : 0),
+	  replicas_(runCfg.Qmc() ? static_cast<std::size_t>(runCfg.qmcReplicas) : 0),
+	  strata_(static_cast<std::size_t>(runCfg.NStrata()), "StratumTally")
 {
 	auto *accMan = G4AccumulableManager::Instance();
 	for (auto &a : coneIon_)
@@ -32,6 +43,16 @@ RunAction::RunAction(const geom::GeometryConfig &cfg,
 		accMan->RegisterAccumulable(a);
 	for (auto &a : panelCap_)
 		accMan->RegisterAccumulable(a);
+	if (runCfg_.crn)
+		accMan->RegisterAccumulable(&outcomes_);
+	if (runCfg_.Qmc())
+		accMan->RegisterAccumulable(&replicas_);
+	if (Weighted())
+		accMan->RegisterAccumulable(&weights_);
+	if (runCfg_.Stratified())
+		accMan->RegisterAccumulable(&strata_);
+	accMan->RegisterAccumulable(transmitted_);
+	accMan->RegisterAccumulable(steps_);
 }
 
 /*═════════════════════════════════════════════════════════════════════*/
@@ -43,8 +64,10 @@ void RunAction::BeginOfRunAction(const G4Run *)
 	G4cout << "[RunAction] BeginOfRunAction on thread "
 		   << G4Threading::G4GetThreadId() << G4endl;
 
-	/* 2)  Master thread: create results/<timestamp>/ + TSV header */
-	if (G4Threading::IsMasterThread())
+	/* 2)  Master thread: create results/<timestamp>/ + TSV header
+	       (sequential batches all share the first batch's directory) */
+	if (G4Threading::IsMasterThread() &&
+		!(runCfg_.Batched() && logger_->IsInitialized()))
 		logger_->InitOutputFiles(cfg_);
 
 	/* 3)  ROOT file & histograms */
@@ -94,16 +117,133 @@ void RunAction::EndOfRunAction(const G4Run *run)
 			panelCap[i] = panelCap_[i].GetValue();
 		}
 
-		/*── 2c  One-shot JSON + TSV footer via DataLogger ─────────*/
-		logger_->DumpRunSummary(cfg_,
-								run->GetNumberOfEvent(),
-								totalIon,
-								totalCap,
-								coneIon, coneCap,
-								panelIon, panelCap);
+		unsigned long nEvents     = run->GetNumberOfEvent();
+		unsigned long transmitted = transmitted_.GetValue();
+
+		/*── 2b.1 CRN: per-event outcomes (OR across sequential batches) ─*/
+		if (runCfg_.crn)
+		{
+			const auto &flags = outcomes_.Flags();
+			cumOutcomes_.resize(flags.size(), 0);
+			for (std::size_t i = 0; i < flags.size(); ++i)
+				cumOutcomes_[i] |= flags[i];
+			logger_->DumpEventOutcomes(cumOutcomes_);
+		}
+
+		/*── 2b.2 Sobol sampler: per-replica counts (summed across batches) ─*/
+		const util::ReplicaCounts *qmc = nullptr;
+		if (runCfg_.Qmc())
+		{
+			if (cumReplicas_.Size() == 0)
+				cumReplicas_ = util::ReplicaCounts(replicas_.Counts().Size());
+			cumReplicas_.Add(replicas_.Counts());
+			qmc = &cumReplicas_;
+		}
+
+		/*── 2b.3 Bias / forcing / splitting: weighted scores ─────────*/
+		const util::WeightedSums *weighted = nullptr;
+		if (Weighted())
+		{
+			cumWeights_.Add(weights_.Sums());
+			weighted = &cumWeights_;
+		}
+
+		/*── 2b.4 Stratified beam: fold batch, Neyman shares for the next ─*/
+		const sim::StratifiedEstimator *strata = nullptr;
+		if (runCfg_.Stratified())
+		{
+			const auto est = runCfg_.stop.estimator;
+			stratEst_.AddBatch(strata_.Counts());
+			sim::Strata().SetShares(stratEst_.NeymanShares(est != sim::Estimator::Cap,
+														   est != sim::Estimator::Ion));
+			strata = &stratEst_;
+		}
+
+		/* run.json input, read once the totals below are final */
+		auto summarise = [&]
+		{
+			util::RunSummary s;
+			s.nEvents      = nEvents;
+			s.nIon         = totalIon;
+			s.nCap         = totalCap;
+			s.nTransmitted = transmitted;
+			s.coneIon      = coneIon;
+			s.coneCap      = coneCap;
+			s.panelIon     = panelIon;
+			s.panelCap     = panelCap;
+			s.qmc          = qmc;
+			s.weighted     = weighted;
+			s.strata       = strata;
+			return s;
+		};
+
+		/*── 2c  Batched mode: fold batch into running totals ────────*/
+		if (runCfg_.Batched())
+		{
+			auto add = [](std::vector<unsigned> &cum, const std::vector<unsigned> &v)
+			{
+				for (std::size_t i = 0; i < v.size(); ++i) cum[i] += v[i];
+				return cum;
+			};
+			coneIon  = add(cumConeIon_,  coneIon);
+			coneCap  = add(cumConeCap_,  coneCap);
+			panelIon = add(cumPanelIon_, panelIon);
+			panelCap = add(cumPanelCap_, panelCap);
+
+			totalIon = totalCap = 0;
+			for (std::size_t i = 0; i < nCones_; ++i)
+			{
+				totalIon += coneIon[i];
+				totalCap += coneCap[i];
+			}
+			cumEvents_ += nEvents;
+			nEvents     = cumEvents_;
+			cumTransmitted_ += transmitted;
+			transmitted      = cumTransmitted_;
+			++cumBatches_;
+
+			/* stopping decision */
+			const auto   est = runCfg_.stop.estimator;
+			const double z   = util::NormalQuantile(runCfg_.stop.confidence);
+			const bool   ion = est != sim::Estimator::Cap, cap = est != sim::Estimator::Ion;
+			double rel = weighted
+				? weighted->RelHalfWidth(nEvents, z, ion, cap)
+				: util::RelHalfWidth(totalIon, totalCap, nEvents, z, ion, cap);
+			if (strata)
+			{
+				const auto ri = strata->Ion(), rc = strata->Cap();
+				double var = 0.0;
+				if (ion) var += ri.mean > 0.0 ? std::pow(ri.stdErr / ri.mean, 2) : HUGE_VAL;
+				if (cap) var += rc.mean > 0.0 ? std::pow(rc.stdErr / rc.mean, 2) : HUGE_VAL;
+				rel = z * std::sqrt(var);
+			}
+
+			const bool reached = runCfg_.stop.Sequential() &&
+								 rel <= runCfg_.stop.targetRelError;
+			seqDone_ = reached || static_cast<long>(nEvents) >= runCfg_.nEvents;
+
+			const util::StopStatus status{rel, cumBatches_,
+										  reached ? "target" : (seqDone_ ? "budget" : "running")};
+
+			util::RunSummary summary = summarise();
+			summary.stop  = &status;
+			summary.final = seqDone_;
+			logger_->DumpRunSummary(cfg_, summary);
+
+			G4cout << "[RunAction] Batch " << cumBatches_ << ": " << nEvents
+				   << " events, " << sim::EstimatorName(est)
+				   << " relative half-width " << rel << " (target "
+				   << runCfg_.stop.targetRelError << ") -> " << status.reason << G4endl;
+		}
+		else
+		{
+			/*── 2d  One-shot JSON + TSV footer via DataLogger ─────────*/
+			logger_->DumpRunSummary(cfg_, summarise());
+		}
 
-		/*── 2d  Print nice summary to terminal ────────────────────────────*/
-		PrintRunSummary(run->GetNumberOfEvent(), totalCap, totalIon);
+		/*── 2e  Print nice summary to terminal ────────────────────────────*/
+		PrintRunSummary(nEvents, totalCap, totalIon, weighted);
+		G4cout << "[RunAction] mu-alpha steps: " << steps_.GetValue() << G4endl;
 
 		G4cout << "[RunAction] EndOfRunAction completed on master.\n";
 	}
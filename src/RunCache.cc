@@ -0,0 +1,142 @@
+/**
+ * @file    RunCache.cc
+ * @author  Mohammadreza Zakeri
+ * @date    2026-10-18
+ *
+ * @brief   Cache keys and the prefix-tiling lookup of RunCache.hh.
+ *
+ *  No Geant4 or CLHEP includes appear below.
+ */
+
+#include "RunCache.hh"
+#include "SolveHash.hh"
+#include "TiledFieldMap.hh"
+
+/*────────────────────────────── stdlib ───────────────────────────────────*/
+#include <algorithm>
+#include <chrono>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+
+namespace fs = std::filesystem;
+
+namespace util {
+
+/*══════════════════════════════════════════════════════════════════════════*/
+/* 1.  Keys                                                                 */
+/*══════════════════════════════════════════════════════════════════════════*/
+std::string ConfigHash(const geom::GeometryConfig& cfg,
+                       const sim::RunConfig&       runCfg,
+                       std::uint64_t               rateChecksum)
+{
+    /* nlohmann::json keeps object keys sorted → canonical text. */
+    nlohmann::json key = {
+        {"geometry",   cfg},
+        {"beam", {
+            {"x0_nm",         runCfg.beam.x0_nm},
+            {"z0_nm",         runCfg.beam.z0_nm},
+            {"sigma_nm",      runCfg.beam.sigma_nm},
+            {"max_theta_deg", runCfg.beam.max_theta_deg},
+            {"energy_MeV",    runCfg.beam.energy_MeV}
+        }},
+        {"rate_table", HashHex(rateChecksum)},
+        {"seed",       runCfg.seed},
+        {"crn",        runCfg.crn},
+        {"rng",        sim::RngName(runCfg.rng)},
+        {"sampler",    sim::SamplerName(runCfg.sampler)},
+        {"qmc_replicas", runCfg.Qmc() ? runCfg.qmcReplicas : 0},
+        {"bias",       runCfg.biasFraction},
+        {"strata",     sim::StrataName(runCfg.strata)},
+        {"force_ion",  runCfg.forceIon}
+    };
+    /* added only when set, so Geant4 runs keep their earlier hashes */
+    if (runCfg.engine == sim::Engine::Ballistic) key["engine"] = "ballistic";
+    if (cfg.field.grid3d.Active())             // header hash: the grid may exceed RAM
+        key["field_map"] = HashHex(TiledFieldMap::FileHash(cfg.field.grid3d.file));
+    else if (cfg.field.Solved())               // the solve's inputs, no file
+        key["field_map"] = HashHex(SolveHash(cfg));
+    else if (cfg.field.Active())
+        key["field_map"] = HashHex(Fnv1aFile(cfg.field.pos_file));
+    return HashHex(Fnv1a(key.dump()));
+}
+
+/*══════════════════════════════════════════════════════════════════════════*/
+/* 2.  Lookup                                                               */
+/*══════════════════════════════════════════════════════════════════════════*/
+CachePlan PlanFromCache(const std::string& resultsDir,
+                        const std::string& configHash,
+                        long first, long n)
+{
+    struct Entry { long lo, hi; std::string path; };
+    std::vector<Entry> entries;
+
+    /*── 2.1  Every run.json of this configuration inside [first, first+n) ─*/
+    std::error_code ec;
+    for (const auto& d : fs::directory_iterator(resultsDir, ec))
+    {
+        const fs::path p = d.path() / "run.json";
+        if (!fs::is_regular_file(p)) continue;
+
+        RunJson run;
+        try { run = LoadRunSummary(p.string()); }
+        catch (const std::exception&) { continue; }   // half-written run
+
+        if (run.value("config_hash", std::string()) != configHash) continue;
+
+        const long lo = run.value("first_event", 0L);
+        const long hi = lo + run.value("n_events", 0L);
+        if (hi > lo && lo >= first && hi <= first + n)
+            entries.push_back({lo, hi, p.string()});
+    }
+    std::sort(entries.begin(), entries.end(),
+              [](const Entry& a, const Entry& b)
+              { return a.lo != b.lo ? a.lo < b.lo : a.path < b.path; });
+
+    /*── 2.2  Greedy tiling: longest run starting where the last one ended ─*/
+    CachePlan plan{{}, first};
+    for (;;)
+    {
+        const Entry* best = nullptr;
+        for (const auto& e : entries)
+            if (e.lo == plan.cachedEnd && (!best || e.hi > best->hi)) best = &e;
+        if (!best) break;
+        plan.runs.push_back(best->path);
+        plan.cachedEnd = best->hi;
+    }
+    return plan;
+}
+
+/*══════════════════════════════════════════════════════════════════════════*/
+/* 3.  Merge + write                                                        */
+/*══════════════════════════════════════════════════════════════════════════*/
+RunJson MergePlan(const CachePlan& plan, const std::vector<RunJson>& extra)
+{
+    std::vector<RunJson> runs;
+    for (const auto& p : plan.runs) runs.push_back(LoadRunSummary(p));
+    runs.insert(runs.end(), extra.begin(), extra.end());
+
+    RunJson out = MergeRunSummaries(runs);
+    out["cached_from"] = plan.runs;
+    return out;
+}
+
+std::string WriteCachedRun(const std::string& resultsDir, const RunJson& run)
+{
+    const auto t_c = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+    char stamp[32];
+    std::strftime(stamp, sizeof(stamp), "%Y%m%dT%H%M%S", std::localtime(&t_c));
+
+    const fs::path dir = fs::path(resultsDir) / (std::string(stamp) + "_cache");
+    fs::create_directories(dir);
+
+    const fs::path p = dir / "run.json";
+    std::ofstream out(p);
+    if (!out)
+        throw std::runtime_error("RunCache: cannot write " + p.string());
+    out << run.dump(2) << '\n';
+    return p.string();
+}
+
+} // namespace util
@@ -0,0 +1,262 @@
+/**
+ * @file    RunMerge.cc
+ * @author  Mohammadreza Zakeri
+ * @date    2026-10-18
+ *
+ * @brief   Implementation of the exact shard merge for `run.json` files.
+ *
+ *  No Geant4 or CLHEP includes appear below – the `mergeRuns` tool links
+ *  this file without the toolkit.
+ */
+
+#include "RunMerge.hh"
+
+/*────────────────────────────── stdlib ───────────────────────────────────*/
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <stdexcept>
+
+/*──────────────────────────── project ────────────────────────────────────*/
+#include "RunCache.hh"   // InputHash()
+#include "RunStats.hh"
+
+namespace util {
+
+/*══════════════════════════════════════════════════════════════════════════*/
+/* 1.  I/O                                                                  */
+/*══════════════════════════════════════════════════════════════════════════*/
+RunJson LoadRunSummary(const std::string& path)
+{
+    std::ifstream in(path);
+    if (!in)
+        throw std::runtime_error("RunMerge: cannot open " + path);
+
+    try {
+        return RunJson::parse(in);
+    }
+    catch (const nlohmann::json::exception& e) {
+        throw std::runtime_error("RunMerge: cannot parse " + path + ": " + e.what());
+    }
+}
+
+/*══════════════════════════════════════════════════════════════════════════*/
+/* 2.  Derived statistics                                                   */
+/*══════════════════════════════════════════════════════════════════════════*/
+void UpdateDerivedStats(RunJson& run)
+{
+    const unsigned long n   = run.at("n_events").get<unsigned long>();
+    const unsigned long ion = run.at("n_ion").get<unsigned long>();
+    const unsigned long cap = run.at("n_capture").get<unsigned long>();
+
+    if (run.value("raw_valid", true))
+    {
+        run["ion_frac"]      = Fraction(ion, n);
+        run["ion_err"]       = BinomialError(ion, n);
+        run["cap_frac"]      = Fraction(cap, n);
+        run["cap_err"]       = BinomialError(cap, n);
+        run["ion_cap_ratio"] = cap ? double(ion) / cap : 0.0;
+    }
+    else                        // split copies counted as hits (DataLogger)
+        for (const char* key : {"ion_frac", "ion_err", "cap_frac", "cap_err", "ion_cap_ratio"})
+            run[key] = nullptr;
+
+    /* Randomised-QMC block: replica means from the replica counts */
+    if (run.contains("qmc"))
+    {
+        auto&      q  = run["qmc"];
+        const auto rn = q.at("replica_n").get<std::vector<unsigned long>>();
+        const auto ri = q.at("replica_ion").get<std::vector<unsigned long>>();
+        const auto rc = q.at("replica_cap").get<std::vector<unsigned long>>();
+        const ReplicaEstimate ie = ReplicaFraction(ri, rn);
+        const ReplicaEstimate ce = ReplicaFraction(rc, rn);
+        q["ion_frac"] = ie.mean;  q["ion_err"] = ie.stdErr;
+        q["cap_frac"] = ce.mean;  q["cap_err"] = ce.stdErr;
+    }
+
+    /* Importance-weighted block: estimates from the raw weight sums */
+    if (run.contains("weighted"))
+    {
+        auto&              b = run["weighted"];
+        const WeightedSums s{b.at("sum_w").get<double>(),     b.at("sum_w2").get<double>(),
+                             b.at("sum_w_ion").get<double>(), b.at("sum_w2_ion").get<double>(),
+                             b.at("sum_w_cap").get<double>(), b.at("sum_w2_cap").get<double>(),
+                             b.value("sum_w2_ion_cap", 0.0)};
+        const ReplicaEstimate ie = s.Ion(n), ce = s.Cap(n);
+        b["ion_frac"]       = ie.mean;  b["ion_err"] = ie.stdErr;
+        b["cap_frac"]       = ce.mean;  b["cap_err"] = ce.stdErr;
+        b["ion_cap_ratio"]  = ce.mean > 0.0 ? ie.mean / ce.mean : 0.0;
+        b["mean_weight"]    = n ? s.w / n : 0.0;
+        b["effective_size"] = s.EffectiveSize();
+    }
+
+    /* Stratified block: plain-MC reference error and variance reduction */
+    if (run.contains("stratified"))
+    {
+        auto& b = run["stratified"];
+        for (const char* t : {"ion", "cap"})
+        {
+            const std::string k(t);
+            const double mu = b.at(k + "_frac").get<double>();
+            const double st = b.at(k + "_err").get<double>();
+            const double mc = n ? std::sqrt(mu * (1.0 - mu) / n) : 0.0;
+            b[k + "_err_mc"] = mc;
+            b[k + "_vrf"]    = st > 0.0 ? (mc * mc) / (st * st) : 0.0;
+        }
+    }
+}
+
+/*══════════════════════════════════════════════════════════════════════════*/
+/* 3.  Merge                                                                */
+/*══════════════════════════════════════════════════════════════════════════*/
+namespace {
+
+/** Add the "ion"/"cap" columns of a *_stats array element-wise. */
+void addStats(RunJson& dst, const RunJson& src, const char* key)
+{
+    auto&       d = dst.at(key);
+    const auto& s = src.at(key);
+    if (d.size() != s.size())
+        throw std::runtime_error(std::string("RunMerge: '") + key + "' size mismatch");
+
+    for (std::size_t i = 0; i < d.size(); ++i)
+    {
+        d[i]["ion"] = d[i].at("ion").get<unsigned long>() + s[i].at("ion").get<unsigned long>();
+        d[i]["cap"] = d[i].at("cap").get<unsigned long>() + s[i].at("cap").get<unsigned long>();
+    }
+}
+
+/** Add the per-replica counts of two `qmc` blocks element-wise. */
+void addReplicas(RunJson& dst, const RunJson& src)
+{
+    if (dst.contains("qmc") != src.contains("qmc"))
+        throw std::runtime_error("RunMerge: mixing Sobol and plain MC runs");
+    if (!dst.contains("qmc")) return;
+
+    for (const char* key : {"replica_n", "replica_ion", "replica_cap"})
+    {
+        auto&       d = dst["qmc"].at(key);
+        const auto& s = src.at("qmc").at(key);
+        if (d.size() != s.size())
+            throw std::runtime_error("RunMerge: QMC replica count mismatch");
+        for (std::size_t r = 0; r < d.size(); ++r)
+            d[r] = d[r].get<unsigned long>() + s[r].get<unsigned long>();
+    }
+}
+
+/** Add the raw weight sums of two `weighted` blocks. */
+void addWeights(RunJson& dst, const RunJson& src)
+{
+    if (dst.contains("weighted") != src.contains("weighted"))
+        throw std::runtime_error("RunMerge: mixing biased and unbiased runs");
+    if (!dst.contains("weighted")) return;
+
+    for (const char* key : {"sum_w", "sum_w2", "sum_w_ion", "sum_w2_ion", "sum_w_cap", "sum_w2_cap"})
+        dst["weighted"][key] = dst["weighted"].at(key).get<double>()
+                             + src.at("weighted").at(key).get<double>();
+
+    // Cross sum of the ratio's covariance; runs written before it count as 0
+    dst["weighted"]["sum_w2_ion_cap"] = dst["weighted"].value("sum_w2_ion_cap", 0.0)
+                                      + src.at("weighted").value("sum_w2_ion_cap", 0.0);
+}
+
+/** Combine two `stratified` blocks as independent estimates of sizes nd, ns. */
+void addStrata(RunJson& dst, const RunJson& src, double nd, double ns)
+{
+    if (dst.contains("stratified") != src.contains("stratified"))
+        throw std::runtime_error("RunMerge: mixing stratified and unstratified runs");
+    if (!dst.contains("stratified")) return;
+
+    auto&       d = dst["stratified"];
+    const auto& s = src.at("stratified");
+    const double wd = nd / (nd + ns), ws = ns / (nd + ns);
+    for (const char* t : {"ion", "cap"})
+    {
+        const std::string f = std::string(t) + "_frac", e = std::string(t) + "_err";
+        const double ed = d.at(e).get<double>(), es = s.at(e).get<double>();
+        d[f] = wd * d.at(f).get<double>() + ws * s.at(f).get<double>();
+        d[e] = std::sqrt(wd * wd * ed * ed + ws * ws * es * es);
+    }
+    d["batches"] = d.at("batches").get<int>() + s.at("batches").get<int>();
+    d.erase("last_alloc");   // per-shard detail
+
+    for (const char* key : {"stratum_n", "stratum_ion", "stratum_cap"})
+    {
+        auto&       dv = d.at(key);
+        const auto& sv = s.at(key);
+        if (dv.size() != sv.size())
+            throw std::runtime_error("RunMerge: stratum count mismatch");
+        for (std::size_t h = 0; h < dv.size(); ++h)
+            dv[h] = dv[h].get<unsigned long>() + sv[h].get<unsigned long>();
+    }
+}
+
+} // namespace
+
+RunJson MergeRunSummaries(const std::vector<RunJson>& runs)
+{
+    if (runs.empty())
+        throw std::runtime_error("RunMerge: nothing to merge");
+
+    /*── 3.1  Compatibility checks ─────────────────────────────────────*/
+    const RunJson& ref = runs.front();
+    for (const auto& r : runs)
+    {
+        if (r.at("geometry") != ref.at("geometry"))
+            throw std::runtime_error("RunMerge: shards use different geometries");
+        if (r.value("seed", RunJson()) != ref.value("seed", RunJson()))
+            throw std::runtime_error("RunMerge: shards use different seeds");
+        if (r.value("config_hash", RunJson()) != ref.value("config_hash", RunJson()))
+            throw std::runtime_error("RunMerge: shards use different configurations (config_hash)");
+    }
+
+    /*── 3.2  Event ranges must be disjoint ────────────────────────────*/
+    std::vector<std::pair<long, long>> ranges;   // [first, first + n)
+    for (const auto& r : runs)
+    {
+        const long first = r.value("first_event", 0L);
+        ranges.emplace_back(first, first + r.at("n_events").get<long>());
+    }
+    std::sort(ranges.begin(), ranges.end());
+    bool contiguous = true;
+    for (std::size_t i = 1; i < ranges.size(); ++i)
+    {
+        if (ranges[i].first < ranges[i - 1].second)
+            throw std::runtime_error("RunMerge: shards have overlapping event ranges");
+        contiguous = contiguous && ranges[i].first == ranges[i - 1].second;
+    }
+
+    /*── 3.3  Sum raw counts ───────────────────────────────────────────*/
+    RunJson out = ref;
+    for (std::size_t k = 1; k < runs.size(); ++k)
+    {
+        const auto& r = runs[k];
+        addStrata(out, r, out.at("n_events").get<double>(), r.at("n_events").get<double>());
+        out["n_events"]  = out.at("n_events").get<unsigned long>()  + r.at("n_events").get<unsigned long>();
+        out["n_ion"]     = out.at("n_ion").get<unsigned long>()     + r.at("n_ion").get<unsigned long>();
+        out["n_capture"] = out.at("n_capture").get<unsigned long>() + r.at("n_capture").get<unsigned long>();
+        if (out.contains("n_transmitted") || r.contains("n_transmitted"))
+            out["n_transmitted"] = out.value("n_transmitted", 0UL) + r.value("n_transmitted", 0UL);
+        addStats(out, r, "panel_stats");
+        addStats(out, r, "cone_stats");
+        addReplicas(out, r);
+        addWeights(out, r);
+    }
+
+    /*── 3.4  Range bookkeeping + derived numbers ──────────────────────*/
+    out["first_event"] = ranges.front().first;
+    if (out.contains("shard_index")) out["shard_index"] = 0;
+    if (out.contains("shard_count")) out["shard_count"] = 1;
+    out.erase("stopping");   // a merge is not one sequential decision
+    out["merged_shards"]    = runs.size();
+    out["contiguous_range"] = contiguous;
+    if (out.contains("input_hash"))
+        out["input_hash"] = InputHash(out.at("config_hash").get<std::string>(),
+                                      ranges.front().first,
+                                      out.at("n_events").get<long>());
+
+    UpdateDerivedStats(out);
+    return out;
+}
+
+} // namespace util
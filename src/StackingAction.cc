@@ -0,0 +1,67 @@
+/**
+ * @file    StackingAction.cc
+ * @brief   Ray / shell-column test for new primaries (see StackingAction.hh).
+ */
+
+#include "StackingAction.hh"
+
+/*────────────────────────────── Geant4 ───────────────────────────────*/
+#include "G4FieldManager.hh"
+#include "G4LogicalVolumeStore.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4Threading.hh"
+#include "G4Track.hh"
+#include "G4TransportationManager.hh"
+
+/*──────────────────────────── project ────────────────────────────────*/
+#include "MuAlpha5p.hh"
+#include "RunAction.hh"
+
+/*====================================================================*/
+/*  ctor                                                              */
+/*====================================================================*/
+StackingAction::StackingAction(const geom::GeometryConfig& cfg, RunAction* run)
+: grid_(cfg), runAction_(run)
+{}
+
+/*====================================================================*/
+/*  field check (global + per-volume field managers)                  */
+/*====================================================================*/
+bool StackingAction::FieldActive()
+{
+    auto* global = G4TransportationManager::GetTransportationManager()->GetFieldManager();
+    if (global && global->GetDetectorField()) return true;
+
+    for (const auto* lv : *G4LogicalVolumeStore::GetInstance())
+        if (lv->GetFieldManager() && lv->GetFieldManager()->GetDetectorField())
+            return true;
+    return false;
+}
+
+/*====================================================================*/
+/*  ClassifyNewTrack                                                  */
+/*====================================================================*/
+G4ClassificationOfNewTrack StackingAction::ClassifyNewTrack(const G4Track* track)
+{
+    /* Geometry and fields exist by the first track of the first event */
+    if (enabled_ < 0)
+    {
+        enabled_ = FieldActive() ? 0 : 1;
+        if (!enabled_)
+            G4cout << "[StackingAction] electric field present – ray test off on thread "
+                   << G4Threading::G4GetThreadId() << G4endl;
+    }
+
+    if (!enabled_ || track->GetParentID() != 0 ||
+        track->GetDefinition() != MuAlpha5p::Definition())
+        return fUrgent;
+
+    const G4ThreeVector& p = track->GetPosition();
+    const G4ThreeVector& u = track->GetMomentumDirection();
+    const double o[3] = {p.x() / nm, p.y() / nm, p.z() / nm};
+    const double d[3] = {u.x(), u.y(), u.z()};
+    if (grid_.Hits(o, d)) return fUrgent;
+
+    runAction_->Transmitted() += 1;
+    return fKill;
+}
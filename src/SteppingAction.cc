@@ -3,8 +3,15 @@
  * @brief   Capture / Ionization logic for each simulation step.
  *
  *  A. If pre-step point is inside the cone logical volume  → “captured”.
- *  B. Else, if (rho,z) lies inside the tabulated domain      → sample ADK.
+ *  B. Else, if (rho,z) lies inside the tabulated domain      → sample ADK
+ *     (`--force-ion`: score w·Pint and continue with w·(1 − Pint)).
+ *     The rates come from tunnelling_rate.tsv, or with `--rates` from the
+ *     field map's |E| (RateProvider.hh).
  *  C. Otherwise                                             do nothing.
+ *  D. Importance (GeometryConfig::importance): when the pre-step volume's
+ *     importance changed since the last step, split the track into weighted
+ *     copies or play Russian roulette – after B, so a segment that just
+ *     ended has had its ionisation trial.
  */
 
 // #include <cmath>    /* std::hypot */
@@ -29,17 +36,20 @@
 
 /*────────────────────────────── Geant4 ───────────────────────────────*/
 #include "G4AutoLock.hh"
+#include "G4DynamicParticle.hh"
 #include "G4RunManager.hh"
 #include "G4Step.hh"
+#include "G4SteppingManager.hh"
 #include "G4ThreeVector.hh"
 // #include "G4UniformRand.hh"
 
 /*──────────────────────────── project ────────────────────────────────*/
 #include "DetectorConstruction.hh"
+#include "EventRandom.hh"
 // #include "HistogramManager.hh"
 #include "MuAlpha5p.hh"
-#include "RateTableSingleton.hh"
 #include "RunAction.hh"
+#include "RunStats.hh"
 
 
 /*====================================================================*/
@@ -47,6 +57,8 @@
 /*====================================================================*/
 G4ThreadLocal bool SteppingAction::gEventCaptureOccurred    = false;
 G4ThreadLocal bool SteppingAction::gEventIonizationOccurred = false;
+G4ThreadLocal double SteppingAction::gEventIonScore         = 0.0;
+G4ThreadLocal double SteppingAction::gEventCapScore         = 0.0;
 
 /* mutex to protect ROOT histogram fills (simple, coarse lock) */
 // namespace { G4Mutex gHistMutex = G4MUTEX_INITIALIZER; }
@@ -65,7 +77,28 @@ SteppingAction::SteppingAction(const DetectorConstruction* det,
                                RunAction*                  run)
 : fDet(det)
 , runAction_(run)
-{}
+, fImp(det->GetGeometryConfig().importance)
+, fKill(fImp.Active() ? fStopAndKill : fKillTrackAndSecondaries)
+{
+    try {
+        fRates = MakeRateProvider(run->Config().rateSpec, det->GetFieldMap(),
+                                  det->GetGeometryConfig().field);
+    } catch (const std::exception& e) {
+        G4Exception("SteppingAction", "BadRates", FatalException, e.what());
+    }
+}
+
+/*====================================================================*/
+/*  importance of a logical volume (GeometryConfig::importance)       */
+/*====================================================================*/
+double SteppingAction::Importance(const G4LogicalVolume* lv) const
+{
+    if (lv == fDet->GetInShellLogical() || lv == fDet->GetConeLogical())
+        return fImp.inner;
+    if (lv == fDet->GetMidShellLogical()) return fImp.middle;
+    if (lv == fDet->GetOutShellLogical()) return fImp.outer;
+    return fImp.world;
+}
 /*====================================================================*/
 /*  static helpers                                                    */
 /*====================================================================*/
@@ -73,42 +106,45 @@ void SteppingAction::ResetEventFlags()
 {
     gEventCaptureOccurred    = false;
     gEventIonizationOccurred = false;
+    gEventIonScore           = 0.0;
+    gEventCapScore           = 0.0;
 }
 bool SteppingAction::EventHadCapture()    { return gEventCaptureOccurred; }
 bool SteppingAction::EventHadIonization() { return gEventIonizationOccurred; }
+double SteppingAction::EventIonScore()    { return gEventIonScore; }
+double SteppingAction::EventCapScore()    { return gEventCapScore; }
 
 // -----------------------------------------------------------------------------
 /// Print current counts (for summary at end of run)
 /* static */
 void RunAction::PrintRunSummary(unsigned long nEvents,
                                 unsigned long nCap,
-                                unsigned long nIon)
+                                unsigned long nIon,
+                                const util::WeightedSums* weighted)
 {
     auto fmt_pct = [](double x) { return 100.0 * x; };
 
-    const double fIon = nEvents ? double(nIon) / nEvents : 0.0;
-    const double fCap = nEvents ? double(nCap) / nEvents : 0.0;
-
-    auto err95 = [nEvents](unsigned long k, double p)
-    {
-        if (k == 0 || k == nEvents) return 3.0 / nEvents;
-        return std::sqrt(p * (1.0 - p) / nEvents);
-    };
-
-    const double dIon = err95(nIon, fIon);
-    const double dCap = err95(nCap, fCap);
+    /* Weighted runs: the raw counts are not an estimate (DataLogger raw_valid) */
+    util::ReplicaEstimate ion{util::Fraction(nIon, nEvents), util::BinomialError(nIon, nEvents)};
+    util::ReplicaEstimate cap{util::Fraction(nCap, nEvents), util::BinomialError(nCap, nEvents)};
+    if (weighted) {
+        ion = weighted->Ion(nEvents);
+        cap = weighted->Cap(nEvents);
+    }
 
     G4cout << "\n"
            << "        ============ Global Event Summary ============\n"
            << "         Number of events in this run : " << nEvents << "\n"
            << "         Total Captures               : " << nCap << "\n"
-           << "         Total Ionizations            : " << nIon << "\n"
-           << "         Ionization Fraction (%)      : "
-           << fmt_pct(fIon) << "  ± " << fmt_pct(dIon) << "\n"
+           << "         Total Ionizations            : " << nIon << "\n";
+    if (weighted)
+        G4cout << "         (raw counts, biased – weighted estimates below)\n";
+    G4cout << "         Ionization Fraction (%)      : "
+           << fmt_pct(ion.mean) << "  ± " << fmt_pct(ion.stdErr) << "\n"
            << "         Capture    Fraction (%)      : "
-           << fmt_pct(fCap) << "  ± " << fmt_pct(dCap) << "\n"
+           << fmt_pct(cap.mean) << "  ± " << fmt_pct(cap.stdErr) << "\n"
            << "         Ionization / Capture Ratio   : "
-           << (nCap ? double(nIon) / nCap : 0.0) << "\n"
+           << (cap.mean > 0.0 ? ion.mean / cap.mean : 0.0) << "\n"
            << "        ==============================================\n" << G4endl;
 }
 
@@ -143,6 +179,7 @@ void SteppingAction::UserSteppingAction(const G4Step* step)
     /* ignore everything except mu-α */
     auto track = step->GetTrack();
     if (track->GetDefinition() != MuAlpha5p::Definition()) return;
+    runAction_->Steps() += 1;
 
     /* cone id + logical volume lookup */
     auto touch  = step->GetPreStepPoint()->GetTouchableHandle();
@@ -154,6 +191,7 @@ void SteppingAction::UserSteppingAction(const G4Step* step)
     {
         /* bookkeeping */
         gEventCaptureOccurred = true;
+        gEventCapScore       += track->GetWeight();       // survival weight
         runAction_->ConeCap(copyNo) += 1;                 // per-cone
         runAction_->PanelCap(fDet->GetConesInfo()[copyNo]
                              .panelIdx) += 1;             // per-panel
@@ -245,6 +283,7 @@ void SteppingAction::UserSteppingAction(const G4Step* step)
         bool          inside{false};
         G4ThreeVector lastInsidePos;
         int           coneIdx{-1};  ///< copyNo at entry (for ConeInfo)
+        double        importance{1.0}; ///< importance of the previous step
     };
 
     /* Retrieve / create segment record ------------------------------------ */
@@ -252,9 +291,17 @@ void SteppingAction::UserSteppingAction(const G4Step* step)
     if (!info) 
     {
         info = new ShellSegment;
+        info->importance = Importance(lv);
         track->SetUserInformation(info);
     }
 
+    /* Ionisation trials, splitting and roulette share one stream (CRN/Philox) */
+    auto uniform = [this] {
+        return runAction_->Config().CounterStreams()
+             ? sim::EventStreams::Ionization().Uniform()
+             : G4UniformRand();
+    };
+
     /* Quick flags --------------------------------------------------------- */
     // auto* preLV   = touch->GetVolume()->GetLogicalVolume();
     bool  inShell = (lv == fDet->GetInShellLogical())  ||
@@ -269,18 +316,16 @@ void SteppingAction::UserSteppingAction(const G4Step* step)
         info->entryTime   = track->GetGlobalTime();     // [s]
         info->coneIdx     = copyNo;                     // remember which cone
         info->lastInsidePos = info->entryPos;
-        return;
     }
  
     /* -------- case 2 : still inside ------------------------------------- */
-    if (inShell && info->inside)
+    else if (inShell && info->inside)
     {
         info->lastInsidePos = track->GetPosition();
-        return;
     }
 
     /* -------- case 3 : leaving shell ------------------------------------ */
-    if (!inShell && info->inside)
+    else if (!inShell && info->inside)
     {
         /* geometry constants for *this* cone ------------------------------- */
         const geom::ConeInfo& ci = fDet->GetConesInfo()[ info->coneIdx ];
@@ -293,34 +338,30 @@ void SteppingAction::UserSteppingAction(const G4Step* step)
         const double T0 = info->entryTime;
         const double T1 = track->GetGlobalTime();
 
-        /* fixed mid-point resolution --------------------------------------- */
-        constexpr int N = 20;
-        double        sumλ = 0.0;
+        /* fixed mid-point resolution (shared with the ballistic engine) ---- */
+        const G4ThreeVector L0 = P0 - C, L1 = P1 - C;    // cone-local [m]
+        const double p0[3] = {L0.x(), L0.y(), L0.z()};
+        const double p1[3] = {L1.x(), L1.y(), L1.z()};
+        const double Pint  = CrossingProbability(*fRates, p0, p1, T1 - T0);
 
-        for (int i = 0; i < N; ++i)
-        {
-            const double s  = (i + 0.5) / N;
-            const auto   P  = P0 + s * (P1 - P0);        // global [m]
-
-            const double ρ  = std::hypot(P.x() - C.x(),  // cone-local ρ
-                                        P.y() - C.y());
-            const double z  = P.z() - C.z();             // cone-local z
+        info->inside = false;                          // reset for reuse
 
-            if (RateTable().Inside(ρ, z))
-                sumλ += RateTable().Interp(ρ, z);        // λ [s⁻¹]
+        /* Forced interaction: score the expected ionisation, carry on with
+           the survival weight (no draw, so the RNG streams are untouched) */
+        if (runAction_->Config().forceIon)
+        {
+            const double w = track->GetWeight();
+            gEventIonScore += w * Pint;
+            track->SetWeight(w * (1.0 - Pint));
+            if (Pint >= 1.0) track->SetTrackStatus(fKill);
         }
 
-        const double dt   = (T1 - T0) / N;
-        const double Pint = 1.0 - std::exp(-sumλ * dt);
-
-        info->inside = false;                          // reset for reuse
-
-        /* Bernoulli trial --------------------------------------------------- */
-        if (G4UniformRand() < Pint)
+        /* Bernoulli trial (CRN/Philox: k-th trial of the event ↔ k-th draw) - */
+        else if (uniform() < Pint)
         {
             /* stop track exactly here ----------------------------------------- */
             track->SetStepLength(0.0);
-            track->SetTrackStatus(fKillTrackAndSecondaries);
+            track->SetTrackStatus(fKill);
 
             /* entry / exit in cone frame (metres) ----------------------------- */
             const double ρ_entry = std::hypot(P0.x() - C.x(),
@@ -332,6 +373,7 @@ void SteppingAction::UserSteppingAction(const G4Step* step)
 
             /* book-keeping + histogram --------------------------------------- */
             gEventIonizationOccurred = true;
+            gEventIonScore          += track->GetWeight();
             
             // G4cout << "[SteppingAction] mu-α ionized in cone " 
             //        << (info->coneIdx + 1) << ", copyNo +1= " << copyNo +1
@@ -364,11 +406,43 @@ void SteppingAction::UserSteppingAction(const G4Step* step)
             // }
         }
 
-        return;
     }
 
-    /* -------- case 4 : never entered shell ------------------------------ */
-    return;
+    /* -------- case 4 : never entered shell – nothing to score ----------- */
 
+    /*────────────────────────────────────────────── IMPORTANCE ──────*/
+    if (!fImp.Active() || track->GetTrackStatus() != fAlive) return;
+
+    const double I = Importance(lv);
+    const double r = I / info->importance;          // I'/I of this crossing
+    info->importance = I;
+    if (r == 1.0) return;
+
+    const double w = track->GetWeight();
+    if (r < 1.0)
+    {
+        /* Russian roulette: survive with probability r at weight w/r */
+        if (uniform() < r) track->SetWeight(w / r);
+        else               track->SetTrackStatus(fStopAndKill);
+        return;
+    }
+
+    /* Splitting: ⌊r⌋ or ⌈r⌉ tracks (mean r) of weight w/r; the copies
+       inherit the open shell segment so their ionisation trial is complete */
+    int n = static_cast<int>(r);
+    if (uniform() < r - n) ++n;
+    track->SetWeight(w / r);
+    for (int k = 1; k < n; ++k)
+    {
+        auto* copy = new G4Track(new G4DynamicParticle(*track->GetDynamicParticle()),
+                                 track->GetGlobalTime(), track->GetPosition());
+        copy->SetTouchableHandle(track->GetTouchableHandle());
+        copy->SetParentID(track->GetTrackID());
+        copy->SetLocalTime(track->GetLocalTime());
+        copy->SetProperTime(track->GetProperTime());
+        copy->SetWeight(w / r);
+        copy->SetUserInformation(new ShellSegment(*info));
+        fpSteppingManager->GetfSecondary()->push_back(copy);
+    }
 }
 // -----------------------------------------------------------------------------
\ No newline at end of file
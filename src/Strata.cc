@@ -0,0 +1,171 @@
+/**
+ * @file    Strata.cc
+ * @author  Mohammadreza Zakeri
+ * @date    2026-10-18
+ *
+ * @brief   Allocation plan and batch-combined estimator of Strata.hh.
+ *
+ *  No Geant4 or CLHEP includes appear below.
+ */
+
+#include "Strata.hh"
+
+/*────────────────────────────── stdlib ───────────────────────────────────*/
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+
+namespace sim {
+
+/*══════════════════════════════════════════════════════════════════════════*/
+/* 1.  StrataPlan                                                           */
+/*══════════════════════════════════════════════════════════════════════════*/
+void StrataPlan::Configure(const std::array<int, 4>& cuts)
+{
+    int H = 1;
+    for (int c : cuts)
+    {
+        if (c < 1) throw std::invalid_argument("Strata: every cut must be >= 1");
+        H *= c;
+    }
+    cuts_   = cuts;
+    shares_.assign(static_cast<std::size_t>(H), 1.0);
+    alloc_.clear();
+    ends_.clear();
+}
+
+void StrataPlan::SetShares(const std::vector<double>& shares)
+{
+    if (shares.size() != shares_.size())
+        throw std::invalid_argument("Strata: share vector has the wrong size");
+    shares_ = shares;
+}
+
+void StrataPlan::Allocate(long n)
+{
+    const std::size_t H = shares_.size();
+    if (n < 2 * static_cast<long>(H))
+        throw std::invalid_argument("Strata: a batch needs at least two events per stratum");
+
+    /* two per stratum, the rest by largest remainder of the shares */
+    const double total = std::accumulate(shares_.begin(), shares_.end(), 0.0);
+    const long   spare = n - 2 * static_cast<long>(H);
+
+    alloc_.assign(H, 2);
+    std::vector<std::pair<double, std::size_t>> rem(H);
+    long given = 0;
+    for (std::size_t h = 0; h < H; ++h)
+    {
+        const double exact = total > 0.0 ? spare * shares_[h] / total
+                                         : static_cast<double>(spare) / H;
+        const long   whole = static_cast<long>(std::floor(exact));
+        alloc_[h] += whole;
+        given     += whole;
+        rem[h]     = {exact - whole, h};
+    }
+    std::sort(rem.begin(), rem.end(),
+              [](const auto& a, const auto& b)
+              { return a.first != b.first ? a.first > b.first : a.second < b.second; });
+    for (long i = 0; i < spare - given; ++i) ++alloc_[rem[static_cast<std::size_t>(i) % H].second];
+
+    ends_.resize(H);
+    std::partial_sum(alloc_.begin(), alloc_.end(), ends_.begin());
+}
+
+int StrataPlan::StratumOf(long j) const noexcept
+{
+    if (ends_.empty()) return 0;
+    const auto it = std::upper_bound(ends_.begin(), ends_.end(), j);
+    return static_cast<int>(std::min<std::ptrdiff_t>(it - ends_.begin(),
+                                                     static_cast<std::ptrdiff_t>(ends_.size()) - 1));
+}
+
+void StrataPlan::Point(int h, const double v[4], double u[4]) const noexcept
+{
+    for (int d = 0; d < 4; ++d)
+    {
+        const int c = h % cuts_[d];
+        h /= cuts_[d];
+        u[d] = (c + v[d]) / cuts_[d];
+    }
+}
+
+/*══════════════════════════════════════════════════════════════════════════*/
+/* 2.  StratifiedEstimator                                                  */
+/*══════════════════════════════════════════════════════════════════════════*/
+void StratifiedEstimator::AddBatch(const util::ReplicaCounts& batch)
+{
+    const std::size_t H = batch.Size();
+    const double      p = 1.0 / static_cast<double>(H);
+
+    auto fold = [&](const std::vector<unsigned long>& k)
+    {
+        double mu = 0.0, var = 0.0;
+        for (std::size_t h = 0; h < H; ++h)
+        {
+            const double n = static_cast<double>(batch.n[h]);
+            if (n < 1.0) continue;                   // Allocate() prevents this
+            const double q = k[h] / n;
+            mu += p * q;
+            if (n > 1.0) var += p * p * q * (1.0 - q) / (n - 1.0);  // s²/n, s² unbiased
+        }
+        return std::pair{mu, var};
+    };
+
+    const long Nb = static_cast<long>(std::accumulate(batch.n.begin(), batch.n.end(), 0UL));
+    const auto [mi, vi] = fold(batch.ion);
+    const auto [mc, vc] = fold(batch.cap);
+    const double N = static_cast<double>(Nb);
+    ion_.mean += N * mi;  ion_.var += N * N * vi;
+    cap_.mean += N * mc;  cap_.var += N * N * vc;
+
+    if (pooled_.Size() == 0) pooled_ = util::ReplicaCounts(H);
+    pooled_.Add(batch);
+    events_ += Nb;
+    ++batches_;
+}
+
+util::ReplicaEstimate StratifiedEstimator::Combined(const Sums& s) const noexcept
+{
+    if (events_ == 0) return {};
+    const double N = static_cast<double>(events_);
+    return {s.mean / N, std::sqrt(s.var) / N};
+}
+
+double StratifiedEstimator::PlainError(const Sums& s) const noexcept
+{
+    /* A Bernoulli score has variance μ(1 − μ) whatever the strata. */
+    if (events_ == 0) return 0.0;
+    const double mu = Combined(s).mean;
+    return std::sqrt(mu * (1.0 - mu) / static_cast<double>(events_));
+}
+
+std::vector<double> StratifiedEstimator::NeymanShares(bool useIon, bool useCap) const
+{
+    const std::size_t H = pooled_.Size();
+    std::vector<double> shares(H, 1.0);
+    if (H == 0) return shares;
+
+    auto smoothed = [&](const std::vector<unsigned long>& k, std::size_t h)
+    { return (k[h] + 0.5) / (pooled_.n[h] + 1.0); };
+
+    auto overall = [&](const std::vector<unsigned long>& k)
+    {
+        double mu = 0.0;
+        for (std::size_t h = 0; h < H; ++h) mu += smoothed(k, h) / H;
+        return mu;
+    };
+    const double muI = overall(pooled_.ion), muC = overall(pooled_.cap);
+
+    for (std::size_t h = 0; h < H; ++h)
+    {
+        double rel = 0.0;
+        if (useIon) { const double q = smoothed(pooled_.ion, h); rel += q * (1.0 - q) / (muI * muI); }
+        if (useCap) { const double q = smoothed(pooled_.cap, h); rel += q * (1.0 - q) / (muC * muC); }
+        shares[h] = std::sqrt(rel) / H;           // p_h · σ̂_h
+    }
+    return shares;
+}
+
+} // namespace sim
@@ -0,0 +1,377 @@
+/**
+ * @file    TiledFieldMap.cc
+ * @author  Mohammadreza Zakeri
+ * @date    2026-10-18
+ *
+ * @brief   Tiled .f3d reader, LRU residency and table converter of
+ *          TiledFieldMap.hh.
+ *
+ *  No Geant4 or CLHEP includes appear below.
+ */
+
+#include "TiledFieldMap.hh"
+
+/*────────────────────────────── stdlib ───────────────────────────────────*/
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <set>
+#include <stdexcept>
+
+/*────────────────────────────── POSIX ────────────────────────────────────*/
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>     // ftruncate, getpid
+
+/*──────────────────────────── project ────────────────────────────────────*/
+#include "Hashing.hh"
+
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr char          kMagic[8]    = {'M', 'A', 'F', '3', 'D', 'G', 'R', '1'};
+constexpr std::size_t   kBlock        = 1u << 16;      ///< Header size, tile alignment
+constexpr std::uint32_t kNil         = 0xFFFFFFFFu;   ///< End of the LRU list
+constexpr std::size_t   kMaxDistinct = 1u << 20;      ///< Per axis, while converting
+
+/// On-disk header; the tiles start at kBlock.
+struct FileHeader {
+    char                magic[8];
+    TiledFieldMap::Grid grid;
+};
+static_assert(sizeof(FileHeader) <= kBlock, "header must fit in its block");
+
+std::atomic<std::uint64_t> gNextId {1};
+
+std::uint64_t TileCount(const TiledFieldMap::Grid& g)
+{
+    return static_cast<std::uint64_t>(g.tiles[0]) * g.tiles[1] * g.tiles[2];
+}
+
+/// Nodes per tile (T+1)³, three floats each.
+std::uint64_t TileFloats(std::uint32_t T)
+{
+    const std::uint64_t m = T + 1ULL;
+    return 3 * m * m * m;
+}
+
+}  // namespace
+
+/*══════════════════════════════════════════════════════════════════════════*/
+/* 1.  Open                                                                 */
+/*══════════════════════════════════════════════════════════════════════════*/
+TiledFieldMap::TiledFieldMap(const std::string& path, std::size_t residentBytes)
+: map_(path), id_{gNextId.fetch_add(1)}
+{
+    if (map_.Size() < kBlock)
+        throw std::runtime_error("TiledFieldMap: " + path + " is too short");
+    FileHeader h;
+    std::memcpy(&h, map_.Data(), sizeof h);
+    if (std::memcmp(h.magic, kMagic, sizeof kMagic) != 0)
+        throw std::runtime_error("TiledFieldMap: " + path + " is not a .f3d grid");
+
+    grid_ = h.grid;
+    const std::uint32_t T = grid_.tile;
+    bool ok = T > 0 && grid_.tileBytes % kBlock == 0 &&
+              grid_.tileBytes >= TileFloats(T) * sizeof(float);
+    for (int a = 0; a < 3; ++a)
+        ok = ok && grid_.n[a] >= 2 && grid_.h[a] > 0.0 &&
+             grid_.tiles[a] == (grid_.n[a] - 2) / T + 1;
+    ok = ok && TileCount(grid_) < kNil &&
+         map_.Size() == kBlock + TileCount(grid_) * grid_.tileBytes;
+    if (!ok)
+        throw std::runtime_error("TiledFieldMap: " + path + " has an inconsistent header or size");
+
+    base_ = map_.Data() + kBlock;
+
+    const std::uint64_t tiles = TileCount(grid_);
+    budget_ = residentBytes ? std::max<std::size_t>(1, residentBytes / grid_.tileBytes) : 0;
+    if (budget_ >= tiles) budget_ = 0;        // everything fits: nothing to bound
+    if (budget_) {
+        map_.Advise(0, map_.Size(), MADV_RANDOM);
+        map_.Advise(0, map_.Size(), MADV_NOHUGEPAGE);   // huge pages outlive tile drops
+        prev_.assign(tiles, kNil);
+        next_.assign(tiles, kNil);
+        resident_.assign(tiles, 0);
+        head_ = tail_ = kNil;
+    }
+}
+
+/*══════════════════════════════════════════════════════════════════════════*/
+/* 2.  Residency                                                            */
+/*══════════════════════════════════════════════════════════════════════════*/
+void TiledFieldMap::Touch(std::uint64_t t64) const
+{
+    const auto t = static_cast<std::uint32_t>(t64);
+    std::lock_guard<std::mutex> lock(lruMutex_);
+
+    auto unlink = [&](std::uint32_t u) {
+        (prev_[u] == kNil ? head_ : next_[prev_[u]]) = next_[u];
+        (next_[u] == kNil ? tail_ : prev_[next_[u]]) = prev_[u];
+    };
+
+    if (resident_[t]) {
+        if (head_ == t) return;
+        unlink(t);
+    } else {
+        map_.Advise(kBlock + t64 * grid_.tileBytes, grid_.tileBytes, MADV_WILLNEED);
+        resident_[t] = 1;
+        ++count_;
+        pageIns_.fetch_add(1, std::memory_order_relaxed);
+    }
+    prev_[t] = kNil;                          // push front
+    next_[t] = head_;
+    (head_ == kNil ? tail_ : prev_[head_]) = t;
+    head_ = t;
+
+    while (count_ > budget_) {                // drop the least recently used
+        const std::uint32_t u = tail_;
+        unlink(u);
+        resident_[u] = 0;
+        --count_;
+        map_.Advise(kBlock + static_cast<std::uint64_t>(u) * grid_.tileBytes,
+                    grid_.tileBytes, MADV_DONTNEED);
+        evictions_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+/*══════════════════════════════════════════════════════════════════════════*/
+/* 3.  Lookup                                                               */
+/*══════════════════════════════════════════════════════════════════════════*/
+void TiledFieldMap::Field(double x, double y, double z, double E[3]) const
+{
+    const double   p[3] = {x, y, z};
+    const std::uint32_t T = grid_.tile;
+    std::uint32_t  ti[3], li[3];
+    double         f[3];
+    for (int a = 0; a < 3; ++a) {
+        const double s = std::clamp((p[a] - grid_.origin[a]) / grid_.h[a],
+                                    0.0, static_cast<double>(grid_.n[a] - 1));
+        const auto   c = std::min(static_cast<std::uint32_t>(s), grid_.n[a] - 2);
+        f[a]  = s - c;
+        ti[a] = c / T;
+        li[a] = c - ti[a] * T;
+    }
+    const std::uint64_t t =
+        (static_cast<std::uint64_t>(ti[2]) * grid_.tiles[1] + ti[1]) * grid_.tiles[0] + ti[0];
+
+    if (budget_) {
+        thread_local struct { std::uint64_t id, tile; } last {0, 0};
+        if (last.id != id_ || last.tile != t) {
+            Touch(t);
+            last = {id_, t};
+        }
+    }
+
+    const std::size_t sy = 3 * (T + 1), sz = sy * (T + 1);
+    const float* c = Tile(t) + 3 * li[0] + sy * li[1] + sz * li[2];
+    const double gx = 1.0 - f[0], gy = 1.0 - f[1], gz = 1.0 - f[2];
+    const double w[8] = {gx * gy * gz, f[0] * gy * gz, gx * f[1] * gz, f[0] * f[1] * gz,
+                         gx * gy * f[2], f[0] * gy * f[2], gx * f[1] * f[2], f[0] * f[1] * f[2]};
+    const std::size_t o[8] = {0, 3, sy, sy + 3, sz, sz + 3, sz + sy, sz + sy + 3};
+    for (int k = 0; k < 3; ++k) {
+        double v = 0.0;
+        for (int n = 0; n < 8; ++n) v += w[n] * c[o[n] + k];
+        E[k] = v;
+    }
+}
+
+void TiledFieldMap::Report(std::ostream& os) const
+{
+    const Grid& g = grid_;
+    os << "  grid " << g.n[0] << " x " << g.n[1] << " x " << g.n[2] << " nodes, h = ("
+       << g.h[0] << ", " << g.h[1] << ", " << g.h[2] << "), " << TileCount(g) << " tiles of "
+       << g.tile << "^3 cells (" << g.tileBytes / 1024 << " KiB); ";
+    if (budget_)
+        os << "resident budget " << budget_ << " tiles ("
+           << (budget_ * g.tileBytes >> 20) << " MiB), page-ins " << PageIns()
+           << ", evictions " << Evictions() << '\n';
+    else
+        os << "fully mapped\n";
+}
+
+std::uint64_t TiledFieldMap::FileHash(const std::string& path)
+{
+    std::ifstream in(path, std::ios::binary);
+    FileHeader h;
+    if (!in.read(reinterpret_cast<char*>(&h), sizeof h) ||
+        std::memcmp(h.magic, kMagic, sizeof kMagic) != 0)
+        throw std::runtime_error("TiledFieldMap: " + path + " is not a .f3d grid");
+    return h.grid.hash;
+}
+
+/*══════════════════════════════════════════════════════════════════════════*/
+/* 4.  Conversion from a text table                                         */
+/*══════════════════════════════════════════════════════════════════════════*/
+namespace {
+
+bool IsSep(char c) { return c == ' ' || c == '\t' || c == ',' || c == '\r'; }
+
+/**
+ * @brief Visit every data row `v[6]` of the table; `line` is 1-based.
+ * @throw std::runtime_error on a malformed row.
+ */
+template <class Visit>
+void ForEachRow(const util::MappedFile& in, Visit&& visit)
+{
+    const char* p   = in.Data();
+    const char* end = p + in.Size();
+    for (std::uint64_t line = 1; p < end; ++line) {
+        const char* nl = static_cast<const char*>(std::memchr(p, '\n', static_cast<std::size_t>(end - p)));
+        const char* e  = nl ? nl : end;
+        while (p < e && IsSep(*p)) ++p;
+        if (p < e && *p != '%' && *p != '#') {
+            double v[6];
+            for (double& x : v) {
+                while (p < e && IsSep(*p)) ++p;
+                const auto [q, ec] = std::from_chars(p, e, x);
+                if (ec != std::errc())
+                    throw std::runtime_error("TiledFieldMap: malformed row at line " + std::to_string(line));
+                p = q;
+            }
+            visit(v);
+        }
+        p = nl ? nl + 1 : end;
+    }
+}
+
+/// Regular axis from its distinct coordinates; throws if not uniform.
+void FitAxis(const std::set<double>& values, int a, TiledFieldMap::Grid& g)
+{
+    static const char* names = "xyz";
+    if (values.size() < 2)
+        throw std::runtime_error(std::string("TiledFieldMap: the ") + names[a] +
+                                 " axis needs at least two distinct coordinates");
+    const double lo = *values.begin(), hi = *values.rbegin();
+    const double eps = 1e-9 * (hi - lo);
+
+    std::vector<double> nodes;                // merge round-off duplicates
+    for (double v : values)
+        if (nodes.empty() || v - nodes.back() > eps) nodes.push_back(v);
+
+    const auto n = static_cast<std::uint32_t>(nodes.size());
+    const double h = (hi - lo) / (n - 1);
+    for (std::uint32_t k = 0; k < n; ++k)
+        if (std::abs(nodes[k] - (lo + k * h)) > 1e-3 * h)
+            throw std::runtime_error(std::string("TiledFieldMap: the ") + names[a] +
+                                     " coordinates are not equally spaced");
+    g.n[a] = n;  g.origin[a] = lo;  g.h[a] = h;
+}
+
+}  // namespace
+
+TiledFieldMap::Grid TiledFieldMap::Convert(const std::string& table, const std::string& out,
+                                           std::uint32_t tile, std::ostream& log)
+{
+    if (tile == 0) throw std::runtime_error("TiledFieldMap: tile size must be positive");
+    const util::MappedFile in(table, true);
+
+    /*── 4.1  Pass 1: the grid ─────────────────────────────────────────────*/
+    std::set<double> axis[3];
+    std::uint64_t rows = 0;
+    ForEachRow(in, [&](const double* v) {
+        for (int a = 0; a < 3; ++a) {
+            axis[a].insert(v[a]);
+            if (axis[a].size() > kMaxDistinct)
+                throw std::runtime_error("TiledFieldMap: too many distinct coordinates "
+                                         "(not a regular grid?)");
+        }
+        ++rows;
+    });
+
+    Grid g;
+    g.tile = tile;
+    for (int a = 0; a < 3; ++a) {
+        FitAxis(axis[a], a, g);
+        g.tiles[a] = (g.n[a] - 2) / tile + 1;
+    }
+    const std::uint64_t nodes = static_cast<std::uint64_t>(g.n[0]) * g.n[1] * g.n[2];
+    if (rows != nodes)
+        throw std::runtime_error("TiledFieldMap: " + std::to_string(rows) + " rows for a grid of " +
+                                 std::to_string(nodes) + " nodes");
+    if (TileCount(g) >= kNil)
+        throw std::runtime_error("TiledFieldMap: too many tiles; use a larger tile size");
+    g.tileBytes = (TileFloats(tile) * sizeof(float) + kBlock - 1) / kBlock * kBlock;
+
+    /*── 4.2  Output mapping ───────────────────────────────────────────────*/
+    const std::uint64_t size = kBlock + TileCount(g) * g.tileBytes;
+    const std::string   tmp  = out + ".tmp" + std::to_string(::getpid());
+    const int fd = ::open(tmp.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) throw std::runtime_error("TiledFieldMap: cannot create " + tmp);
+    void* m = ::ftruncate(fd, static_cast<off_t>(size)) == 0
+            ? ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0) : MAP_FAILED;
+    if (m == MAP_FAILED) {
+        ::close(fd);
+        fs::remove(tmp);
+        throw std::runtime_error("TiledFieldMap: cannot size or map " + tmp);
+    }
+    char* dst = static_cast<char*>(m);
+
+    /*── 4.3  Pass 2: every node into each tile that shares it ─────────────*/
+    std::vector<bool> seen(nodes, false);
+    const std::size_t sy = 3 * (tile + 1), sz = sy * (tile + 1);
+    try {
+        ForEachRow(in, [&](const double* v) {
+            std::uint32_t k[3];
+            for (int a = 0; a < 3; ++a)
+                k[a] = static_cast<std::uint32_t>(std::lround((v[a] - g.origin[a]) / g.h[a]));
+            const std::uint64_t node = (static_cast<std::uint64_t>(k[2]) * g.n[1] + k[1]) * g.n[0] + k[0];
+            if (seen[node])
+                throw std::runtime_error("TiledFieldMap: node (" + std::to_string(k[0]) + ", " +
+                                         std::to_string(k[1]) + ", " + std::to_string(k[2]) +
+                                         ") appears twice");
+            seen[node] = true;
+
+            // Tiles holding index k on one axis: k / T, and k / T − 1 on a shared face.
+            std::uint32_t tt[3][2], ll[3][2];
+            int           nt[3];
+            for (int a = 0; a < 3; ++a) {
+                nt[a] = 0;
+                const std::uint32_t t = k[a] / tile;
+                if (t < g.tiles[a])              { tt[a][nt[a]] = t;     ll[a][nt[a]++] = k[a] - t * tile; }
+                if (k[a] % tile == 0 && t > 0)   { tt[a][nt[a]] = t - 1; ll[a][nt[a]++] = tile; }
+            }
+            const float e[3] = {static_cast<float>(v[3]), static_cast<float>(v[4]),
+                                static_cast<float>(v[5])};
+            for (int iz = 0; iz < nt[2]; ++iz)
+                for (int iy = 0; iy < nt[1]; ++iy)
+                    for (int ix = 0; ix < nt[0]; ++ix) {
+                        const std::uint64_t t =
+                            (static_cast<std::uint64_t>(tt[2][iz]) * g.tiles[1] + tt[1][iy]) *
+                            g.tiles[0] + tt[0][ix];
+                        float* c = reinterpret_cast<float*>(dst + kBlock + t * g.tileBytes) +
+                                   3 * ll[0][ix] + sy * ll[1][iy] + sz * ll[2][iz];
+                        std::memcpy(c, e, sizeof e);
+                    }
+        });
+
+        /*── 4.4  Header, hash, publish ────────────────────────────────────*/
+        g.hash = util::Fnv1a(dst + kBlock, size - kBlock);
+        FileHeader h {};
+        std::memcpy(h.magic, kMagic, sizeof kMagic);
+        h.grid = g;
+        std::memcpy(dst, &h, sizeof h);
+        if (::msync(m, size, MS_SYNC) != 0)
+            throw std::runtime_error("TiledFieldMap: cannot write " + tmp);
+    } catch (...) {
+        ::munmap(m, size);
+        ::close(fd);
+        fs::remove(tmp);
+        throw;
+    }
+    ::munmap(m, size);
+    // Drop the written pages: the page cache would keep them as large
+    // folios, which a later budgeted reader cannot release tile by tile.
+    ::posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+    ::close(fd);
+    fs::rename(tmp, out);
+
+    log << "Field grid 3-D: " << table << " -> " << out << ", " << g.n[0] << " x " << g.n[1]
+        << " x " << g.n[2] << " nodes in " << TileCount(g) << " tiles ("
+        << (size >> 20) << " MiB)\n";
+    return g;
+}
@@ -0,0 +1,32 @@
+#include "TiledG4Field.hh"
+
+// -----------------------------------------------------------------------------
+/**
+ * @brief Constructor that places a shared, already mapped grid in the world.
+ */
+TiledG4Field::TiledG4Field(std::shared_ptr<const TiledFieldMap> map,
+                           const G4ThreeVector& origin,
+                           G4double lengthUnit, G4double fieldUnit)
+    : fieldMap(std::move(map)), origin(origin),
+      lengthUnit(lengthUnit), fieldUnit(fieldUnit) {}
+// -----------------------------------------------------------------------------
+/**
+ * @brief Implements the Geant4 field interface using the wrapped grid.
+ * @param point The 4D position [x, y, z, t] where the field is evaluated
+ * @param field Output array of 6 values: [Ex, Ey, Ez, Bx, By, Bz]
+ */
+void TiledG4Field::GetFieldValue(const double point[4],
+                                 double* field) const {
+  const G4ThreeVector local =
+      (G4ThreeVector(point[0], point[1], point[2]) - origin) / lengthUnit;
+  double E[3];
+  fieldMap->Field(local.x(), local.y(), local.z(), E);
+
+  field[0] = fieldUnit * E[0];  // Ex
+  field[1] = fieldUnit * E[1];  // Ey
+  field[2] = fieldUnit * E[2];  // Ez
+  field[3] = 0.0;               // Bx
+  field[4] = 0.0;               // By
+  field[5] = 0.0;               // Bz
+}
+// -----------------------------------------------------------------------------
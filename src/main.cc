@@ -8,12 +8,47 @@
 //  Build-time deps  : nlohmann/json (header-only, bundled with Geant4 examples)
 //  Run-time  flags  : --cfg=<geometry.json>   (optional)
 //                     --nevents=<N>           (default 100)
+//                     --seed=<S>              (base seed, default 20250604)
+//                     --shard=<i>/<N>         (simulate shard i of N)
+//                     --first-event=<K>       (global ID of the first event)
+//                     --reuse-cache           (reuse / top up matching results/)
+//                     --target-rel-error=<e>  (run batches until the estimator's
+//                                              relative CI half-width < e;
+//                                              --nevents is then the budget)
+//                     --estimator=ion|cap|ratio   --confidence=<c>   --batch=<B>
+//                     --crn                   (common random numbers: per-event
+//                                              streams + outcomes.u8 for pairing)
+//                     --rng=engine|philox     (philox: counter-based per-event
+//                                              streams, thread-count independent)
+//                     --sampler=mc|sobol      (sobol: randomised-QMC beam points)
+//                     --qmc-replicas=<R>      (independent scrambles, default 16)
+//                     --bias=<f>              (share f of primaries aimed at the
+//                                              shell columns, weighted tallies)
+//                     --strata=<a>x<b>x<c>x<d> (stratify beam r, φ, θ, ψ; Neyman
+//                                              reallocation between --batch runs)
+//                     --force-ion             (score Pint·w per shell crossing,
+//                                              continue with w·(1 − Pint))
+//                     --no-ray-cull           (transport primaries that cannot
+//                                              reach any shell column)
+//                     --no-free-flight        (step through the vacuum between
+//                                              shells instead of jumping it)
+//                     --engine=geant4|ballistic|check
+//                                             (ballistic: straight-line transport
+//                                              without Geant4; check: both, paired
+//                                              event by event, needs --crn)
+//                     --rates=<adk.json>      (tunnelling rates from the field
+//                                              map's |E| by ADK instead of
+//                                              tunnelling_rate.tsv)
 //
 //  Author  : Mohammadreza Zakeri (Zaki) — m.zakeri@eku.edu
 //  Updated : 2025-06-01
 // ============================================================================
 
+#include <chrono>
+#include <cmath>
+#include <filesystem>
 #include <fstream>
+#include <sstream>
 #include <string>
 #include <thread>
 
@@ -26,7 +61,15 @@
 #include "QGSP_BERT.hh"
 // #include "GeometryConfigJSON.hh"        // <- JSON  struct helpers
 #include "ActionInitialization.hh"
+#include "BallisticEngine.hh"
+#include "BeamBias.hh"
+#include "DataLogger.hh"
 #include "PhysicsList.hh"
+#include "RateProvider.hh"
+#include "RunAction.hh"
+#include "RunCache.hh"
+#include "RunConfig.hh"
+#include "Strata.hh"
 
 // ────────────────────────────────────────────────────────────────
 //  Default (hard-wired) geometry – handy for “no-JSON” mode.
@@ -95,11 +138,14 @@ static geom::GeometryConfig makeDefaultConfig() {
 }
 
 // ────────────────────────────────────────────────────────────────
-//  Ultra-light CLI parser for --cfg and --nevents
+//  Ultra-light CLI parser for --cfg, --nevents and the event range
 // ────────────────────────────────────────────────────────────────
 struct Cli {
   std::string cfgPath;
   int nEvents = 100;
+  long firstEvent = 0;
+  bool reuseCache = false;
+  sim::RunConfig run;   // filled from the flags above (see finalize)
 };
 
 static Cli parse_cli(int argc, char** argv) {
@@ -110,10 +156,214 @@ static Cli parse_cli(int argc, char** argv) {
       out.cfgPath = a.substr(6);
     else if (a.rfind("--nevents=", 0) == 0)
       out.nEvents = std::stoi(a.substr(10));
+    else if (a.rfind("--seed=", 0) == 0)
+      out.run.seed = std::stoull(a.substr(7));
+    else if (a.rfind("--first-event=", 0) == 0)
+      out.firstEvent = std::stol(a.substr(14));
+    else if (a == "--reuse-cache")
+      out.reuseCache = true;
+    else if (a == "--crn")
+      out.run.crn = true;
+    else if (a == "--force-ion")
+      out.run.forceIon = true;
+    else if (a == "--no-ray-cull")
+      out.run.rayCull = false;
+    else if (a == "--no-free-flight")
+      out.run.freeFlight = false;
+    else if (a.rfind("--rates=", 0) == 0)
+      out.run.rateSpec = a.substr(8);
+    else if (a.rfind("--engine=", 0) == 0) {
+      const std::string v = a.substr(9);
+      if      (v == "geant4")    out.run.engine = sim::Engine::Geant4;
+      else if (v == "ballistic") out.run.engine = sim::Engine::Ballistic;
+      else if (v == "check")     out.run.engine = sim::Engine::Check;
+      else
+        G4Exception("main", "BadEngine", FatalException,
+                    ("--engine expects geant4|ballistic|check, got " + v).c_str());
+    }
+    else if (a.rfind("--rng=", 0) == 0) {
+      const std::string v = a.substr(6);
+      if      (v == "engine") out.run.rng = sim::RngKind::Engine;
+      else if (v == "philox") out.run.rng = sim::RngKind::Philox;
+      else
+        G4Exception("main", "BadRng", FatalException,
+                    ("--rng expects engine|philox, got " + v).c_str());
+    }
+    else if (a.rfind("--sampler=", 0) == 0) {
+      const std::string v = a.substr(10);
+      if      (v == "mc")    out.run.sampler = sim::Sampler::MC;
+      else if (v == "sobol") out.run.sampler = sim::Sampler::Sobol;
+      else
+        G4Exception("main", "BadSampler", FatalException,
+                    ("--sampler expects mc|sobol, got " + v).c_str());
+    }
+    else if (a.rfind("--bias=", 0) == 0) {
+      out.run.biasFraction = std::stod(a.substr(7));
+      if (out.run.biasFraction < 0.0 || out.run.biasFraction >= 1.0)
+        G4Exception("main", "BadBias", FatalException,
+                    "--bias must lie in [0, 1)");
+    }
+    else if (a.rfind("--strata=", 0) == 0) {
+      // a[xb[xc[xd]]] – missing trailing cuts are 1
+      std::istringstream in(a.substr(9));
+      std::string part;
+      std::size_t d = 0;
+      while (std::getline(in, part, 'x')) {
+        if (d == out.run.strata.size() || part.empty() ||
+            part.find_first_not_of("0123456789") != std::string::npos ||
+            std::stoi(part) < 1)
+          G4Exception("main", "BadStrata", FatalException,
+                      ("--strata expects a[xb[xc[xd]]] with cuts >= 1, got " +
+                       a.substr(9)).c_str());
+        out.run.strata[d++] = std::stoi(part);
+      }
+    }
+    else if (a.rfind("--qmc-replicas=", 0) == 0) {
+      out.run.qmcReplicas = std::stoi(a.substr(15));
+      if (out.run.qmcReplicas < 1)
+        G4Exception("main", "BadSampler", FatalException,
+                    "--qmc-replicas must be >= 1");
+    }
+    else if (a.rfind("--target-rel-error=", 0) == 0)
+      out.run.stop.targetRelError = std::stod(a.substr(19));
+    else if (a.rfind("--confidence=", 0) == 0)
+      out.run.stop.confidence = std::stod(a.substr(13));
+    else if (a.rfind("--batch=", 0) == 0)
+      out.run.stop.batchEvents = std::stol(a.substr(8));
+    else if (a.rfind("--estimator=", 0) == 0) {
+      const std::string v = a.substr(12);
+      if      (v == "ion")   out.run.stop.estimator = sim::Estimator::Ion;
+      else if (v == "cap")   out.run.stop.estimator = sim::Estimator::Cap;
+      else if (v == "ratio") out.run.stop.estimator = sim::Estimator::Ratio;
+      else
+        G4Exception("main", "BadEstimator", FatalException,
+                    ("--estimator expects ion|cap|ratio, got " + v).c_str());
+    }
+    else if (a.rfind("--shard=", 0) == 0) {
+      const std::string v = a.substr(8);
+      const auto slash = v.find('/');
+      if (slash == std::string::npos)
+        G4Exception("main", "BadShard", FatalException,
+                    ("--shard expects i/N, got " + v).c_str());
+      out.run.shardIndex = std::stoi(v.substr(0, slash));
+      out.run.shardCount = std::stoi(v.substr(slash + 1));
+      if (out.run.shardCount < 1 || out.run.shardIndex < 0 ||
+          out.run.shardIndex >= out.run.shardCount)
+        G4Exception("main", "BadShard", FatalException,
+                    ("--shard index out of range: " + v).c_str());
+    }
   }
+
+  if (out.run.Biased() && out.run.Qmc())
+    G4Exception("main", "BadBias", FatalException,
+                "--bias cannot be combined with --sampler=sobol (replica "
+                "tallies are unweighted)");
+
+  if (out.run.forceIon && (out.run.crn || out.run.Qmc() || out.run.Stratified()))
+    G4Exception("main", "BadForceIon", FatalException,
+                "--force-ion cannot be combined with --crn, --sampler=sobol or "
+                "--strata (their tallies are unweighted outcome counts)");
+
+  if (out.run.engine == sim::Engine::Check && !out.run.crn)
+    G4Exception("main", "BadEngine", FatalException,
+                "--engine=check needs --crn (both paths must record per-event "
+                "outcomes from the same random numbers)");
+
+  if (out.run.Stratified() && (out.run.Qmc() || out.run.Biased()))
+    G4Exception("main", "BadStrata", FatalException,
+                "--strata cannot be combined with --sampler=sobol or --bias");
+
+  if (out.run.stop.Sequential() &&
+      (out.run.stop.batchEvents < 1 || out.run.stop.confidence <= 0.0 ||
+       out.run.stop.confidence >= 1.0))
+    G4Exception("main", "BadStopRule", FatalException,
+                "--batch must be >= 1 and --confidence in (0, 1)");
+
+  // --nevents is the size of the whole job; a shard takes its slice of it.
+  out.run.totalEvents = out.nEvents;
+  out.run.ApplyShard();
+  out.run.firstEvent += out.firstEvent;
+
+  // Every stratified batch needs two events per stratum for its variance.
+  const long minBatch = 2L * out.run.NStrata();
+  if (out.run.Stratified() &&
+      (out.run.stop.batchEvents < minBatch || out.run.nEvents < minBatch))
+    G4Exception("main", "BadStrata", FatalException,
+                ("--strata=" + sim::StrataName(out.run.strata) + " needs --batch and "
+                 "--nevents (per shard) >= " + std::to_string(minBatch)).c_str());
   return out;
 }
 
+// ────────────────────────────────────────────────────────────────
+//  Top-up: fold the cached prefix into this run's run.json; the
+//  freshly simulated part is kept next to it as run_topup.json.
+// ────────────────────────────────────────────────────────────────
+static void foldCachedPrefix(const util::CachePlan& cache,
+                             const std::string& runJsonPath) {
+  if (cache.runs.empty()) return;
+  namespace fs = std::filesystem;
+  const fs::path runJson = runJsonPath;
+  try {
+    const util::RunJson merged =
+        util::MergePlan(cache, {util::LoadRunSummary(runJson.string())});
+    fs::rename(runJson, runJson.parent_path() / "run_topup.json");
+    std::ofstream(runJson) << merged.dump(2) << '\n';
+    G4cout << "Merged " << cache.runs.size() << " cached run(s) into "
+           << runJson.string() << G4endl;
+  } catch (const std::exception& e) {
+    G4Exception("main", "CacheMerge", JustWarning, e.what());
+  }
+}
+
+// ────────────────────────────────────────────────────────────────
+//  --engine=check: pair the Geant4 outcomes.u8 with the engine's
+//  flags and write crosscheck.json next to run.json
+// ────────────────────────────────────────────────────────────────
+static void writeCrossCheck(const sim::BallisticTally& ballistic,
+                            const std::string& runJsonPath,
+                            double geant4Seconds) {
+  namespace fs = std::filesystem;
+  const fs::path dir = fs::path(runJsonPath).parent_path();
+
+  std::ifstream in(dir / "outcomes.u8", std::ios::binary);
+  const std::vector<std::uint8_t> geant4((std::istreambuf_iterator<char>(in)),
+                                         std::istreambuf_iterator<char>());
+  sim::OutcomeComparison c;
+  try {
+    c = sim::CompareOutcomes(geant4, ballistic.outcomes);
+  } catch (const std::exception& e) {
+    G4Exception("main", "CrossCheck", JustWarning, e.what());
+    return;
+  }
+
+  util::RunJson j;
+  j["n_events"]   = c.n;
+  j["agree_frac"] = util::Fraction(c.agree, c.n);
+  j["geant4"]     = {{"n_ion", c.ionG4}, {"n_capture", c.capG4},
+                     {"seconds", geant4Seconds}};
+  j["ballistic"]  = {{"n_ion", c.ionBal}, {"n_capture", c.capBal},
+                     {"n_transmitted", ballistic.nTransmitted},
+                     {"seconds", ballistic.seconds}};
+  j["ion_only_geant4"]    = c.ionOnlyG4;
+  j["ion_only_ballistic"] = c.ionOnlyBal;
+  j["z_ion"]              = c.ZIon();
+  j["cap_only_geant4"]    = c.capOnlyG4;
+  j["cap_only_ballistic"] = c.capOnlyBal;
+  j["z_cap"]              = c.ZCap();
+  j["speedup"] = ballistic.seconds > 0.0 ? geant4Seconds / ballistic.seconds : 0.0;
+  std::ofstream(dir / "crosscheck.json") << j.dump(2) << '\n';
+
+  G4cout << "Cross-check: " << c.agree << " / " << c.n
+         << " events agree; ion " << c.ionG4 << " (Geant4) vs " << c.ionBal
+         << " (ballistic), z = " << c.ZIon() << "; capture " << c.capG4
+         << " vs " << c.capBal << ", z = " << c.ZCap() << "; speed-up "
+         << j["speedup"].get<double>() << "x -> "
+         << (dir / "crosscheck.json").string() << G4endl;
+  if (std::abs(c.ZIon()) > 3.0 || std::abs(c.ZCap()) > 3.0)
+    G4Exception("main", "CrossCheck", JustWarning,
+                "Geant4 and ballistic outcomes differ by more than 3 sigma");
+}
+
 // ────────────────────────────────────────────────────────────────
 //  main()
 // ────────────────────────────────────────────────────────────────
@@ -141,20 +391,167 @@ int main(int argc, char** argv) {
     G4cout << "Using built-in default geometry\n";
   }
 
-  // ------------ Run manager & threading ------------------------------------
-  auto* runManager = new G4MTRunManager;
+  // ------------ Importance splitting (geometry `importance` block) --------
+  if (cfg.importance.Active()) {
+    const auto& I = cfg.importance;
+    if (!(I.world > 0.0 && I.outer > 0.0 && I.middle > 0.0 && I.inner > 0.0))
+      G4Exception("main", "BadImportance", FatalException,
+                  "geometry importances must all be > 0");
+    if (cli.run.crn || cli.run.Qmc() || cli.run.Stratified())
+      G4Exception("main", "BadImportance", FatalException,
+                  "importance splitting cannot be combined with --crn, "
+                  "--sampler=sobol or --strata (their tallies are unweighted)");
+    G4cout << "Importance splitting: world " << I.world << ", outer " << I.outer
+           << ", middle " << I.middle << ", inner " << I.inner << G4endl;
+  }
+
+  // ------------ Electric field (geometry `field` block) -------------------
+  if (cfg.field.Active()) {
+    if (!cfg.field.Solved() && !std::ifstream(cfg.field.MapFile()))
+      G4Exception("main", "NoFieldMap", FatalException,
+                  ("Cannot open field map " + cfg.field.MapFile()).c_str());
+    if (cli.run.engine != sim::Engine::Geant4)
+      G4Exception("main", "BadEngine", FatalException,
+                  "--engine=ballistic|check assume straight lines; remove the "
+                  "geometry's field block");
+    G4cout << "Electric field: ";
+    if (cfg.field.Solved())
+      G4cout << "solved on a " << cfg.field.solve.cell_nm << " nm grid ("
+             << cfg.field.solve.cache_dir << ")";
+    else
+      G4cout << cfg.field.MapFile();
+    G4cout << ", stepper "
+           << cfg.field.stepper << (cfg.field.open_space ? "" : ", shells only")
+           << (cfg.field.grid3d.Active() ? ", 3-D tiled grid" : "")
+           << (cfg.field.resample.Active() && !cfg.field.grid3d.Active() && !cfg.field.Solved()
+                 ? ", " + cfg.field.resample.interpolation + " grid (" +
+                   cfg.field.resample.cache_dir + ")"
+                 : std::string())
+           << (cfg.field.lattice.Active() && !cfg.field.grid3d.Active()
+                 ? ", superposed over the " +
+                   std::to_string(cfg.field.lattice.k_nearest) + " nearest cones"
+                 : std::string())
+           << G4endl;
+  }
+
+  // ------------ Tunnelling rates (`--rates`, RateProvider.hh) -------------
+  if (!cli.run.rateSpec.empty()) {
+    if (!cfg.field.Active() || cfg.field.grid3d.Active())
+      G4Exception("main", "BadRates", FatalException,
+                  "--rates needs the geometry's revolved or solved field map "
+                  "(a field block without grid3d)");
+    try {
+      const AdkRate::Spec spec = AdkRate::Spec::Load(cli.run.rateSpec);
+      const AdkRate rate(spec);
+      G4cout << "Tunnelling rates: ADK from |E| (" << cli.run.rateSpec << ", "
+             << spec.states.size() << " state(s), |E| quantum " << spec.memo_rel
+             << "), barrier suppression above " << rate.BsiField() << " V/m" << G4endl;
+    } catch (const std::exception& e) {
+      G4Exception("main", "BadRates", FatalException, e.what());
+    }
+  }
+
+  // ------------ Biased beam (validated once, rebuilt per worker) ----------
+  if (cli.run.Biased()) {
+    try {
+      const sim::FocusedBeam focus(cfg, cli.run.beam, cli.run.biasFraction);
+      const double f = cli.run.biasFraction, pU = focus.PFocus();
+      G4cout << "Beam bias " << f << ": P(shell columns) = " << pU
+             << ", weight " << 1.0 / (1.0 - f + f / pU) << " inside / "
+             << 1.0 / (1.0 - f) << " outside" << G4endl;
+    } catch (const std::exception& e) {
+      G4Exception("main", "BadBias", FatalException, e.what());
+    }
+  }
+
+  // ------------ Result cache ----------------------------------------------
+  //  Cached runs of the same config_hash that tile a prefix of our event
+  //  range are reused; only the rest is simulated (see RunCache.hh).
+  util::CachePlan cache{{}, cli.run.firstEvent};
+  if (cli.reuseCache &&
+      (cli.run.Batched() || cli.run.engine == sim::Engine::Check)) {
+    G4Exception("main", "CacheSequential", JustWarning,
+                "--reuse-cache is ignored with --target-rel-error / --strata / "
+                "--engine=check");
+  } else if (cli.reuseCache) {
+    const std::string hash =
+        util::ConfigHash(cfg, cli.run, RateChecksum(cli.run.rateSpec));
+    cache = util::PlanFromCache("results", hash, cli.run.firstEvent,
+                                cli.run.nEvents);
+
+    if (cache.Complete(cli.run.firstEvent, cli.run.nEvents)) {
+      const std::string path =
+          util::WriteCachedRun("results", util::MergePlan(cache));
+      G4cout << "Cache hit " << hash << ": " << cache.runs.size()
+             << " earlier run(s) cover all " << cli.run.nEvents
+             << " events -> " << path << G4endl;
+      return 0;
+    }
+    if (!cache.runs.empty()) {
+      const long end = cli.run.firstEvent + cli.run.nEvents;
+      G4cout << "Cache " << hash << ": reusing events [" << cli.run.firstEvent
+             << ", " << cache.cachedEnd << "), simulating [" << cache.cachedEnd
+             << ", " << end << ")" << G4endl;
+      cli.run.firstEvent = cache.cachedEnd;
+      cli.run.nEvents    = end - cache.cachedEnd;
+    } else {
+      G4cout << "Cache " << hash << ": no reusable runs" << G4endl;
+    }
+  }
 
   const unsigned hw = std::thread::hardware_concurrency();
   const unsigned nThreads = std::min<unsigned>(8, hw ? hw : 1);
+
+  // ------------ Ballistic engine (straight lines, no Geant4) --------------
+  //  ballistic: replaces the Geant4 run and writes the same run.json;
+  //  check:     runs first, compared with Geant4 event by event below.
+  sim::BallisticTally ballistic;
+  if (cli.run.engine != sim::Engine::Geant4) {
+    try {
+      const auto rates = MakeRateProvider(cli.run.rateSpec, nullptr, cfg.field);
+      const sim::BallisticEngine engine(cfg, cli.run, *rates);
+      ballistic = engine.Run(nThreads);
+    } catch (const std::exception& e) {
+      G4Exception("main", "BadEngine", FatalException, e.what());
+    }
+    G4cout << "Ballistic engine: " << ballistic.nEvents << " events on "
+           << nThreads << " threads in " << ballistic.seconds << " s ("
+           << (ballistic.seconds > 0.0 ? ballistic.nEvents / ballistic.seconds : 0.0)
+           << " events/s)" << G4endl;
+  }
+  if (cli.run.engine == sim::Engine::Ballistic) {
+    util::DataLogger logger("results", cli.run);
+    logger.InitOutputFiles(cfg);
+    util::RunSummary summary;
+    summary.nEvents      = ballistic.nEvents;
+    summary.nIon         = ballistic.nIon;
+    summary.nCap         = ballistic.nCap;
+    summary.nTransmitted = ballistic.nTransmitted;
+    summary.coneIon      = ballistic.coneIon;
+    summary.coneCap      = ballistic.coneCap;
+    summary.panelIon     = ballistic.panelIon;
+    summary.panelCap     = ballistic.panelCap;
+    summary.weighted     = cli.run.forceIon ? &ballistic.weights : nullptr;
+    logger.DumpRunSummary(cfg, summary);
+    if (cli.run.crn) logger.DumpEventOutcomes(ballistic.outcomes);
+    RunAction::PrintRunSummary(ballistic.nEvents, ballistic.nCap, ballistic.nIon,
+                               cli.run.forceIon ? &ballistic.weights : nullptr);
+    foldCachedPrefix(cache, logger.JsonPath());
+    return 0;
+  }
+
+  // ------------ Run manager & threading ------------------------------------
+  auto* runManager = new G4MTRunManager;
   runManager->SetNumberOfThreads(nThreads);
   G4cout << "Running on " << nThreads << " threads (" << hw
          << " hardware threads available)\n";
 
   // ------------ Detector, physics, user actions ---------------------------
-  auto* det = new DetectorConstruction(cfg);
+  auto* det = new DetectorConstruction(cfg, cli.run.freeFlight);
   runManager->SetUserInitialization(det);
   runManager->SetUserInitialization(new PhysicsList);
-  runManager->SetUserInitialization(new ActionInitialization(det, cfg));
+  auto* actions = new ActionInitialization(det, cfg, cli.run);
+  runManager->SetUserInitialization(actions);
 
   runManager->Initialize();
 
@@ -170,9 +567,42 @@ int main(int argc, char** argv) {
     ui->SessionStart();
     delete ui;
   } else {
-    std::ostringstream cmd;
-    cmd << "/run/beamOn " << cli.nEvents;
-    UImanager->ApplyCommand(cmd.str());
+    if (cli.run.IsSharded())
+      G4cout << "Shard " << cli.run.shardIndex << "/" << cli.run.shardCount
+             << ": global events [" << cli.run.firstEvent << ", "
+             << cli.run.firstEvent + cli.run.nEvents << ") of "
+             << cli.run.totalEvents << ", seed " << cli.run.seed << G4endl;
+
+    const auto start = std::chrono::steady_clock::now();
+    if (cli.run.Batched()) {
+      // One beamOn per batch; the master RunAction decides when to stop
+      // and, with --strata, re-plans the allocation of the next batch.
+      const auto* master =
+          static_cast<const RunAction*>(runManager->GetUserRunAction());
+      const long minBatch = 2L * cli.run.NStrata();
+      if (cli.run.Stratified()) sim::Strata().Configure(cli.run.strata);
+      long done = 0;
+      while (done < cli.run.nEvents && !master->SequentialDone()) {
+        long n = std::min(cli.run.stop.batchEvents, cli.run.nEvents - done);
+        if (cli.run.Stratified()) {
+          if (cli.run.nEvents - done - n < minBatch) n = cli.run.nEvents - done;
+          sim::Strata().Allocate(n);
+        }
+        UImanager->ApplyCommand("/run/beamOn " + std::to_string(n));
+        done += n;
+      }
+    } else {
+      std::ostringstream cmd;
+      cmd << "/run/beamOn " << cli.run.nEvents;
+      UImanager->ApplyCommand(cmd.str());
+    }
+    const double geant4Seconds = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start).count();
+
+    if (cli.run.engine == sim::Engine::Check)
+      writeCrossCheck(ballistic, actions->Logger()->JsonPath(), geant4Seconds);
+
+    foldCachedPrefix(cache, actions->Logger()->JsonPath());
   }
 
   // ------------ Cleanup ----------------------------------------------------
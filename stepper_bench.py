@@ -0,0 +1,153 @@
+#!/usr/bin/env python3
+"""
+stepper_bench.py  –  step count and CPU time of each field stepper
+
+  • takes a geometry JSON with a `field` block (or adds one with --pos)
+  • runs the executable once per (stepper, repeat) with the same seed and
+    events, changing only field.stepper
+  • reports the mu-α step count (printed by the master RunAction), the CPU
+    time of the child process (user + sys, all threads), the wall time,
+    and the ionisation / capture fractions so accuracy can be weighed
+    against cost
+  • writes stepper_bench.csv (one row per run) and stepper_summary.csv
+
+Every run uses the same --crn seed.  Differences in the fractions are
+therefore the stepper's integration error plus the noise of trajectories
+that diverge, not independent sampling noise.
+
+USAGE
+-----
+  ./stepper_bench.py --exe build/main --cfg geometry_field.json -n 2000
+  ./stepper_bench.py --exe build/main --cfg geometry.json --pos E.pos \\
+        --steppers DormandPrince745 CachedDormandPrince745 ClassicalRK4
+
+Dependencies: Python 3.8+, pandas
+"""
+
+import argparse
+import json
+import os
+import re
+import resource
+import shutil
+import subprocess
+import time
+from pathlib import Path
+
+import pandas as pd
+
+STEPPERS = ["ClassicalRK4", "CashKarpRKF45", "BogackiShampine23",
+            "BogackiShampine45", "DormandPrince745", "DormandPrinceRK56",
+            "TsitourasRK45", "CachedDormandPrince745"]
+
+STEPS_RE = re.compile(r"\[RunAction\] mu-alpha steps: (\d+)")
+
+
+# ────────────────────────────────────────────────────────────────────────────
+#  Helpers
+# ────────────────────────────────────────────────────────────────────────────
+def child_cpu() -> float:
+    """User + system CPU seconds of all waited-for children so far."""
+    ru = resource.getrusage(resource.RUSAGE_CHILDREN)
+    return ru.ru_utime + ru.ru_stime
+
+
+def run_one(exe: Path, workdir: Path, geom: dict, stepper: str,
+            n_events: int, seed: int, repeat: int) -> dict:
+    """Run one job with `field.stepper = stepper` and return its costs."""
+    workdir.mkdir(parents=True, exist_ok=True)
+    g = json.loads(json.dumps(geom))
+    g["field"]["stepper"] = stepper
+    cfg = workdir / "geometry.json"
+    cfg.write_text(json.dumps(g, indent=2))
+
+    cmd = [str(exe), f"--cfg={cfg}", f"--nevents={n_events}",
+           f"--seed={seed}", "--crn"]
+    print(" ".join(cmd))
+    cpu0, wall0 = child_cpu(), time.perf_counter()
+    out = subprocess.run(cmd, cwd=workdir, check=True, text=True,
+                         stdout=subprocess.PIPE).stdout
+    wall, cpu = time.perf_counter() - wall0, child_cpu() - cpu0
+
+    m = STEPS_RE.findall(out)
+    steps = int(m[-1]) if m else float("nan")
+
+    latest = max((workdir / "results").glob("*/run.json"), key=os.path.getmtime)
+    rec = json.loads(latest.read_text())
+    return {"stepper": stepper, "repeat": repeat, "n_events": n_events,
+            "steps": steps, "steps_per_event": steps / n_events,
+            "cpu_s": cpu, "wall_s": wall,
+            "cpu_us_per_step": 1e6 * cpu / steps if steps else float("nan"),
+            "ion_frac": rec["ion_frac"], "cap_frac": rec["cap_frac"]}
+
+
+def summarise(df: pd.DataFrame) -> pd.DataFrame:
+    """Mean cost per stepper, relative to the fastest one."""
+    s = df.groupby("stepper").agg(
+        runs=("repeat", "size"),
+        steps_per_event=("steps_per_event", "mean"),
+        cpu_s=("cpu_s", "mean"),
+        cpu_s_sd=("cpu_s", "std"),
+        cpu_us_per_step=("cpu_us_per_step", "mean"),
+        ion_frac=("ion_frac", "mean"),
+        cap_frac=("cap_frac", "mean"),
+    ).reset_index()
+    s["cpu_rel"] = s["cpu_s"] / s["cpu_s"].min()
+    return s.sort_values("cpu_s")
+
+
+# ────────────────────────────────────────────────────────────────────────────
+#  CLI & main loop
+# ────────────────────────────────────────────────────────────────────────────
+def parse_cli():
+    ap = argparse.ArgumentParser()
+    ap.add_argument("--cfg", required=True,
+                    help="geometry JSON (with a `field` block unless --pos)")
+    ap.add_argument("--pos", default=None,
+                    help="Gmsh .pos field map to add as field.pos_file")
+    ap.add_argument("--steppers", nargs="+", default=STEPPERS,
+                    help="steppers to compare (see FieldSetup.hh)")
+    ap.add_argument("-n", "--nevents", type=int, default=1000)
+    ap.add_argument("--seed", type=int, default=1)
+    ap.add_argument("--repeats", type=int, default=3,
+                    help="identical runs per stepper (CPU-time spread)")
+    ap.add_argument("--exe", default="./build/main",
+                    help="path to muAlphaSim executable")
+    ap.add_argument("--out", default="stepper_results",
+                    help="root directory for results")
+    return ap.parse_args()
+
+
+def main():
+    args = parse_cli()
+    exe = Path(args.exe).resolve()
+    root = Path(args.out).resolve()
+    shutil.rmtree(root, ignore_errors=True)
+    root.mkdir()
+
+    geom = json.loads(Path(args.cfg).read_text())
+    if args.pos:
+        geom.setdefault("field", {})["pos_file"] = str(Path(args.pos).resolve())
+    if not geom.get("field", {}).get("pos_file"):
+        raise SystemExit("geometry has no field.pos_file; pass --pos")
+    geom["field"]["pos_file"] = str(
+        (Path(args.cfg).resolve().parent / geom["field"]["pos_file"]).resolve())
+
+    rows = []
+    for rep in range(args.repeats):
+        for stepper in args.steppers:
+            wd = root / f"{stepper}_r{rep}"
+            rows.append(run_one(exe, wd, geom, stepper,
+                                args.nevents, args.seed, rep))
+
+    df = pd.DataFrame(rows)
+    df.to_csv(root / "stepper_bench.csv", index=False)
+
+    summary = summarise(df)
+    summary.to_csv(root / "stepper_summary.csv", index=False)
+    print(summary.to_string(index=False))
+    print("Wrote", root / "stepper_bench.csv", "and", root / "stepper_summary.csv")
+
+
+if __name__ == "__main__":
+    main()
@@ -4,17 +4,26 @@ sweep_offset.py  –  batch-driver for muAlphaSim
 
   • generates geometry.json with a variable X-offset for *panel 0*
   • runs the executable, passing the json path via --cfg argument
-  • collects every result_*/run_*.json into one CSV for quick plotting
+  • collects every results/<stamp>/run.json into one CSV for quick plotting
+
+  --crn   runs main in common-random-number mode: event i sees the same
+          primary and the same ionisation uniforms at every offset, and
+          main writes per-event outcomes (outcomes.u8).  Differences to the
+          first offset are then estimated *paired*, event by event, and
+          written to paired.csv together with the unpaired error for
+          comparison.
 
 USAGE
 -----
   ./sweep_offset.py -n 1e5  --offsets -300 -150 0 150 300
+  ./sweep_offset.py -n 1e5  --offsets 0 100 --crn
 
-Dependencies: Python 3.8+, pandas
+Dependencies: Python 3.8+, pandas, numpy (--crn)
 """
 
 import argparse
 import json
+import math
 import os
 import shutil
 import subprocess
@@ -53,7 +62,8 @@ def make_geometry(offset_nm: float) -> dict:
     }
 
 
-def run_one(offset: float, n_events: int, exe: Path, out_root: Path) -> Path:
+def run_one(offset: float, n_events: int, exe: Path, out_root: Path,
+            extra_args=()) -> Path:
     """Write geometry, run simulation, return path to run summary json."""
     workdir = out_root / f"offset_{offset:+.0f}nm"
     workdir.mkdir(parents=True, exist_ok=True)
@@ -66,16 +76,55 @@ def run_one(offset: float, n_events: int, exe: Path, out_root: Path) -> Path:
         str(exe),
         f"--cfg={geom_path}",      # option you add in main() to load JSON
         f"--nevents={n_events}",   # likewise parsed in main()
+        *extra_args,
     ]
     print(" ".join(cmd))
     subprocess.run(cmd, cwd=workdir, check=True)
 
-    # DataLogger writes results/run_*.json inside workdir
+    # DataLogger writes results/<stamp>/run.json inside workdir
     res_dir = workdir / "results"
-    latest = max(res_dir.glob("run_*.json"), key=os.path.getmtime)
+    latest = max(res_dir.glob("*/run.json"), key=os.path.getmtime)
     return latest
 
 
+def paired_differences(offsets, json_paths) -> pd.DataFrame:
+    """Per-event paired estimators of (offset − first offset), CRN runs.
+
+    For each tally X ∈ {ion, cap}:  D_i = X_i(offset) − X_i(ref) over the
+    common global events;  Δ = mean(D),  SE = sd(D)/√n.  The unpaired SE
+    (as for two independent runs) and the variance-reduction factor
+    VRF = SE_unpaired² / SE_paired² are reported alongside.
+    """
+    import numpy as np
+
+    def load(p):
+        rec = json.loads(Path(p).read_text())
+        flags = np.fromfile(Path(p).parent / "outcomes.u8", dtype=np.uint8)
+        return rec.get("first_event", 0), flags
+
+    ref_first, ref = load(json_paths[0])
+    rows = []
+    for off, p in zip(offsets[1:], json_paths[1:]):
+        first, cur = load(p)
+        lo = max(first, ref_first)
+        hi = min(first + len(cur), ref_first + len(ref))
+        a = cur[lo - first:hi - first]
+        b = ref[lo - ref_first:hi - ref_first]
+        n = hi - lo
+        for name, bit in (("ion", 1), ("cap", 2)):
+            xa = (a & bit).astype(bool).astype(float)
+            xb = (b & bit).astype(bool).astype(float)
+            d = xa - xb
+            se_p = d.std(ddof=1) / math.sqrt(n) if n > 1 else math.nan
+            se_u = math.sqrt((xa.var(ddof=1) + xb.var(ddof=1)) / n) if n > 1 else math.nan
+            rows.append({"offset_nm": off, "ref_offset_nm": offsets[0],
+                         "tally": name, "n_pairs": n,
+                         "delta": d.mean(), "se_paired": se_p,
+                         "se_unpaired": se_u,
+                         "vrf": (se_u / se_p) ** 2 if se_p > 0 else math.inf})
+    return pd.DataFrame(rows)
+
+
 # ────────────────────────────────────────────────────────────────────────────
 #  CLI & main loop
 # ────────────────────────────────────────────────────────────────────────────
@@ -89,6 +138,8 @@ def parse_cli():
                     help="list of x-offsets (nm) to sweep")
     ap.add_argument("--out", default="sweep_results",
                     help="root directory for results")
+    ap.add_argument("--crn", action="store_true",
+                    help="common random numbers + paired differences")
     return ap.parse_args()
 
 
@@ -101,7 +152,8 @@ def main():
 
 	json_paths = []
 	for off in args.offsets:
-		json_path = run_one(off, args.nevents, exe, root)
+		json_path = run_one(off, args.nevents, exe, root,
+		                    ["--crn"] if args.crn else [])
 		json_paths.append(json_path)
 
     # aggregate CSV
@@ -122,6 +174,12 @@ def main():
 
 	print("Wrote", root / "summary.csv")
 
+	if args.crn and len(json_paths) > 1:
+		pdf = paired_differences(args.offsets, json_paths)
+		pdf.to_csv(root / "paired.csv", index=False)
+		print(pdf.to_string(index=False))
+		print("Wrote", root / "paired.csv")
+
 
 if __name__ == "__main__":
     main()
\ No newline at end of file
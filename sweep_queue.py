@@ -0,0 +1,457 @@
+#!/usr/bin/env python3
+"""
+sweep_queue.py – coordinator-free work queue for muAlphaSim sweeps.
+
+The queue is nothing but a directory on a shared filesystem (NFS, Lustre, …).
+Any number of workers on any number of nodes pull sweep points from it; no
+server, database or scheduler is involved.
+
+  # once: enqueue the 25 grid points (nx, ny = 1..5)
+  python sweep_queue.py enqueue-grid --queue grid_sweep/.queue --out grid_sweep \
+         -n 25000 --exe ./build/main
+
+  # on every node, as many times as you like (one simulation per worker)
+  python sweep_queue.py worker --queue grid_sweep/.queue
+
+  python sweep_queue.py status  --queue grid_sweep/.queue
+  python sweep_queue.py collect --queue grid_sweep/.queue   # → summary.csv
+
+  # smoke test: one queued point through a worker and main's geometry loader
+  python sweep_queue.py selftest --queue /tmp/sq_selftest --exe ./build/main
+
+Queue layout
+------------
+  tasks/<id>.json      immutable task description (cmd, workdir, geometry)
+  pending/<id>         claimable marker; holds {"attempt": k, "errors": [...]}
+  leases/<id>          claimed marker; mtime is the owner's heartbeat
+  leases/<id>@<hex>    a lease being given back by one reaper / failing owner
+  done/<id>.json       result record (path of the produced run.json)
+  failed/<id>.json     gave up after --max-attempts
+
+Protocol
+--------
+* claim   : touch pending/<id>, then os.rename(pending/<id> → leases/<id>)
+            – atomic, exactly one worker wins.  The touch makes the lease
+            fresh from the moment it exists (a rename keeps the enqueue-time
+            mtime, which a concurrent reap would take for a dead owner).
+* renew   : the owner touches its lease every ttl/4 seconds.
+* reap    : any worker renames a lease whose mtime is older than the ttl
+            to leases/<id>@<hex>, a name only it uses (again a rename, so
+            two reapers cannot both succeed), writes attempt + 1 into it and
+            publishes it with one more rename to pending/<id> – or to
+            failed/<id>.json after --max-attempts.  No claim can see the
+            point before its new state is in place.  Lease ages are
+            measured against the *filesystem* clock, so node clock skew does
+            not matter; a reaper that dies mid-way leaves a <id>@<hex> lease
+            that the next reap hands back.
+* finish  : write done/<id>.json, then drop the lease.  An owner that finds
+            its lease gone (it was reaped while the node stalled) kills its
+            simulation and walks away without recording anything.
+
+Results land in the usual layout:  <out>/nx<nx>_ny<ny>/results/<stamp>/run.json
+
+Dependencies: Python 3.8+, pandas (collect only)
+"""
+
+import argparse
+import json
+import os
+import shutil
+import socket
+import subprocess
+import sys
+import threading
+import time
+import uuid
+from pathlib import Path
+
+
+SUBDIRS = ("tasks", "pending", "leases", "done", "failed")
+
+
+# ────────────────────────────────────────────────────────────────────────────
+#  Small filesystem helpers
+# ────────────────────────────────────────────────────────────────────────────
+def _write_atomic(path: Path, payload: dict) -> None:
+    """Write JSON via a temp file + rename so readers never see half a file."""
+    tmp = path.with_name(f".{path.name}.{uuid.uuid4().hex}")
+    tmp.write_text(json.dumps(payload, indent=2))
+    os.replace(tmp, path)
+
+
+def _read_json(path: Path, default=None):
+    try:
+        return json.loads(path.read_text() or "{}")
+    except (FileNotFoundError, json.JSONDecodeError):
+        return default
+
+
+def fs_now(queue: Path) -> float:
+    """Current time as seen by the shared filesystem (immune to clock skew)."""
+    stamp = queue / f".clock.{socket.gethostname()}.{os.getpid()}"
+    stamp.touch()
+    now = stamp.stat().st_mtime
+    stamp.unlink(missing_ok=True)
+    return now
+
+
+def latest_run_json(workdir: Path):
+    """Newest results/<stamp>/run.json below workdir (DataLogger layout)."""
+    runs = list((workdir / "results").glob("*/run.json"))
+    return max(runs, key=os.path.getmtime) if runs else None
+
+
+def load_run(path) -> dict:
+    """run.json as a dict, with estimates the sweeps can rank on.
+
+    --bias, --force-ion and importance splitting write raw_valid = false:
+    the raw tallies are biased and only the `weighted` block is an
+    estimate.  For such runs the fractions, their errors and the ratio are
+    taken from that block, and n_ion / n_capture become the matching
+    expected counts (fraction × n_events, not integers); the raw counts
+    are kept as raw_n_ion / raw_n_capture.  Binomial intervals built on
+    these counts ignore the weights' variance reduction and are wider
+    than the block's own errors.
+    """
+    rec = json.loads(Path(path).read_text())
+    if rec.get("raw_valid", True):
+        return rec
+    w = rec.get("weighted")
+    if w is None:
+        raise ValueError(f"{path}: raw_valid = false but no 'weighted' block")
+    n = rec["n_events"]
+    rec["raw_n_ion"], rec["raw_n_capture"] = rec["n_ion"], rec["n_capture"]
+    rec["n_ion"], rec["n_capture"] = w["ion_frac"] * n, w["cap_frac"] * n
+    for k in ("ion_frac", "ion_err", "cap_frac", "cap_err", "ion_cap_ratio"):
+        rec[k] = w[k]
+    return rec
+
+
+# ────────────────────────────────────────────────────────────────────────────
+#  Queue
+# ────────────────────────────────────────────────────────────────────────────
+class SweepQueue:
+    def __init__(self, root, ttl: float = 300.0, max_attempts: int = 3):
+        self.root = Path(root).resolve()
+        self.ttl = ttl
+        self.max_attempts = max_attempts
+        for sub in SUBDIRS:
+            (self.root / sub).mkdir(parents=True, exist_ok=True)
+
+    def _p(self, sub: str, name: str) -> Path:
+        return self.root / sub / name
+
+    # ── producer side ─────────────────────────────────────────────────────
+    def enqueue(self, task_id: str, cmd: list, workdir, geometry=None,
+                meta=None) -> bool:
+        """Add one point; returns False if it is already known to the queue."""
+        if any(self._p(s, n).exists() for s, n in
+               (("pending", task_id), ("leases", task_id),
+                ("done", task_id + ".json"), ("failed", task_id + ".json"))):
+            return False
+
+        _write_atomic(self._p("tasks", task_id + ".json"), {
+            "id": task_id,
+            "cmd": [str(c) for c in cmd],
+            "workdir": str(Path(workdir).resolve()),
+            "geometry": geometry,
+            "meta": meta or {},
+        })
+        _write_atomic(self._p("pending", task_id), {"attempt": 0, "errors": []})
+        return True
+
+    # ── consumer side ─────────────────────────────────────────────────────
+    def claim(self):
+        """Atomically take one pending point; returns (task, state) or None."""
+        for marker in sorted((self.root / "pending").iterdir()):
+            if marker.name.startswith("."):
+                continue
+            lease = self._p("leases", marker.name)
+            try:
+                os.utime(marker)                    # lease starts fresh
+                os.rename(marker, lease)            # the atomic step
+            except FileNotFoundError:
+                continue                           # somebody else was faster
+            state = _read_json(lease, {"attempt": 0, "errors": []})
+            state.update(owner=f"{socket.gethostname()}:{os.getpid()}",
+                         claimed=time.time())
+            lease.write_text(json.dumps(state))    # also refreshes mtime
+            task = _read_json(self._p("tasks", marker.name + ".json"))
+            return task, state
+        return None
+
+    def renew(self, task_id: str) -> bool:
+        """Heartbeat; False means the lease was reaped behind our back."""
+        try:
+            os.utime(self._p("leases", task_id))
+            return True
+        except FileNotFoundError:
+            return False
+
+    def complete(self, task_id: str, record: dict) -> bool:
+        lease = self._p("leases", task_id)
+        if not lease.exists():
+            return False
+        _write_atomic(self._p("done", task_id + ".json"), record)
+        lease.unlink(missing_ok=True)
+        return True
+
+    def fail(self, task_id: str, state: dict, error: str) -> None:
+        """Give the point back (attempt + 1) or park it in failed/."""
+        staged = self._take(self._p("leases", task_id))
+        if staged is not None:
+            self._requeue(staged, state, error)
+
+    def reap(self) -> int:
+        """Re-queue points whose owner stopped heart-beating."""
+        now, n = fs_now(self.root), 0
+        for lease in (self.root / "leases").iterdir():
+            try:
+                age = now - lease.stat().st_mtime
+            except FileNotFoundError:
+                continue
+            if age <= self.ttl:
+                continue
+            staged = self._take(lease)             # only one reaper wins
+            if staged is None:
+                continue
+            state = _read_json(staged, {"attempt": 0, "errors": []})
+            n += self._requeue(staged, state,
+                               f"lease of {state.get('owner', '?')} expired")
+        return n
+
+    # ── giving a lease back (fail / reap) ─────────────────────────────────
+    def _take(self, lease: Path):
+        """Rename a lease to a name only this process uses; None if it is gone."""
+        staged = self._p("leases", f"{lease.name.split('@')[0]}@{uuid.uuid4().hex}")
+        try:
+            os.rename(lease, staged)
+            os.utime(staged)                       # not expired while we work
+        except FileNotFoundError:
+            return None
+        return staged
+
+    def _requeue(self, staged: Path, state: dict, error: str) -> bool:
+        """Write attempt + 1 into `staged`, then publish it in one rename."""
+        task_id = staged.name.split("@")[0]
+        state = dict(state, attempt=state.get("attempt", 0) + 1,
+                     errors=state.get("errors", []) + [error])
+        target = (self._p("failed", task_id + ".json")
+                  if state["attempt"] >= self.max_attempts
+                  else self._p("pending", task_id))
+        try:
+            with open(staged, "r+") as fp:         # never re-creates a taken file
+                fp.write(json.dumps(state, indent=2))
+                fp.truncate()
+            os.rename(staged, target)
+        except FileNotFoundError:
+            return False                           # another reaper took it over
+        return True
+
+    def counts(self) -> dict:
+        return {s: sum(1 for p in (self.root / s).iterdir()
+                       if not p.name.startswith("."))
+                for s in SUBDIRS}
+
+    def finished(self) -> bool:
+        c = self.counts()
+        return c["pending"] == 0 and c["leases"] == 0
+
+
+# ────────────────────────────────────────────────────────────────────────────
+#  Worker loop
+# ────────────────────────────────────────────────────────────────────────────
+def run_task(q: SweepQueue, task: dict, state: dict) -> None:
+    task_id = task["id"]
+    workdir = Path(task["workdir"])
+    workdir.mkdir(parents=True, exist_ok=True)
+    if task.get("geometry") is not None:
+        (workdir / "geometry.json").write_text(
+            json.dumps(task["geometry"], indent=2))
+
+    print(f"[{socket.gethostname()}:{os.getpid()}] {task_id}: "
+          + " ".join(task["cmd"]), flush=True)
+    log = open(workdir / f"worker_{task_id}.log", "ab")
+    proc = subprocess.Popen(task["cmd"], cwd=workdir, stdout=log,
+                            stderr=subprocess.STDOUT)
+
+    lost, exited = threading.Event(), threading.Event()
+
+    def heartbeat():
+        while not exited.wait(q.ttl / 4):
+            if not q.renew(task_id):
+                lost.set()
+                proc.kill()
+                return
+
+    hb = threading.Thread(target=heartbeat, daemon=True)
+    hb.start()
+    rc = proc.wait()
+    exited.set()
+    hb.join()
+    log.close()
+
+    if lost.is_set():
+        print(f"  {task_id}: lease lost – abandoning", flush=True)
+        return
+
+    run_json = latest_run_json(workdir)
+    if rc == 0 and run_json is not None:
+        q.complete(task_id, {"id": task_id, "run_json": str(run_json),
+                             "meta": task.get("meta", {}),
+                             "host": socket.gethostname(),
+                             "attempt": state.get("attempt", 0)})
+        print(f"  {task_id}: done → {run_json}", flush=True)
+    else:
+        q.fail(task_id, state, f"exit code {rc}" if rc else "no run.json")
+        print(f"  {task_id}: failed (exit code {rc})", flush=True)
+
+
+def worker(q: SweepQueue, poll: float = 10.0, exit_when_idle: bool = True):
+    while True:
+        q.reap()
+        claimed = q.claim()
+        if claimed is not None:
+            run_task(q, *claimed)
+            continue
+        if exit_when_idle and q.finished():
+            return
+        time.sleep(poll)   # others still running: wait for reapable leases
+
+
+# ────────────────────────────────────────────────────────────────────────────
+#  Grid helpers + result collection
+# ────────────────────────────────────────────────────────────────────────────
+def enqueue_grid(q: SweepQueue, out_root, nevents: int, exe, pitch: float,
+                 extra_args=()) -> int:
+    from grid_sweep import geom_cfg   # single source of the grid geometry
+
+    out_root = Path(out_root).resolve()
+    n = 0
+    for nx in range(1, 6):
+        for ny in range(1, 6):
+            wdir = out_root / f"nx{nx}_ny{ny}"
+            cmd = [Path(exe).resolve(), f"--cfg={wdir / 'geometry.json'}",
+                   f"--nevents={nevents}", *extra_args]
+            n += q.enqueue(f"nx{nx}_ny{ny}", cmd, wdir,
+                           geometry=geom_cfg(nx, ny, pitch),
+                           meta={"nx": nx, "ny": ny})
+    return n
+
+
+def selftest(root, exe, pitch: float) -> int:
+    """Queue protocol and one queued grid geometry through main's loader.
+
+    First a claim is run inside a reap's window (see _race_selftest).  Then
+    the grid is enqueued into a scratch queue under `root`, a worker runs
+    the first point for a single event and the point must reach done/.
+    A geometry main cannot parse fails the run and lands in failed/ with
+    the error instead.  Returns the process exit code.
+    """
+    root = Path(root).resolve()
+    shutil.rmtree(root, ignore_errors=True)
+    root.mkdir(parents=True)
+    if not _race_selftest(root):
+        return 1
+    q = SweepQueue(root / ".queue", max_attempts=1)
+    enqueue_grid(q, root, 1, exe, pitch)
+    task, state = q.claim()
+    run_task(q, task, state)
+
+    ok = q._p("done", task["id"] + ".json").exists()
+    print(f"selftest: {task['id']} {'passed' if ok else 'FAILED'}"
+          f" (log: {Path(task['workdir']) / ('worker_' + task['id'] + '.log')})")
+    if ok:
+        shutil.rmtree(root, ignore_errors=True)
+    return 0 if ok else 1
+
+
+def _race_selftest(root: Path) -> bool:
+    """A claim between a reap's take and publish must find nothing to claim,
+    and the point must come back exactly once, with its attempt counted."""
+    q = SweepQueue(root / ".race", ttl=60.0)
+    q.enqueue("race", ["true"], root)
+    q.claim()
+    stale = time.time() - 3600.0
+    os.utime(q._p("leases", "race"), (stale, stale))
+
+    requeue, inside = q._requeue, []
+    def racing(staged, state, error):
+        inside.append(q.claim())                   # a worker claims mid-reap
+        return requeue(staged, state, error)
+    q._requeue = racing
+    reaped = q.reap()
+    q._requeue = requeue
+
+    claimed = q.claim()
+    counts = q.counts()
+    ok = (reaped == 1 and inside == [None] and claimed is not None
+          and claimed[1]["attempt"] == 1 and counts["pending"] == 0
+          and counts["leases"] == 1)
+    print(f"selftest: claim racing a reap {'passed' if ok else 'FAILED'}"
+          f" (claim inside the reap: {inside}, counts after: {counts})")
+    return ok
+
+
+def collect(q: SweepQueue):
+    import pandas as pd
+
+    rows = []
+    for rec in sorted((q.root / "done").glob("*.json")):
+        r = _read_json(rec)
+        row = load_run(r["run_json"])
+        row.update(r.get("meta", {}))
+        rows.append(row)
+    return pd.DataFrame(rows)
+
+
+# ────────────────────────────────────────────────────────────────────────────
+#  CLI
+# ────────────────────────────────────────────────────────────────────────────
+def parse_cli():
+    ap = argparse.ArgumentParser()
+    ap.add_argument("command",
+                    choices=["enqueue-grid", "worker", "status", "collect",
+                             "selftest"])
+    ap.add_argument("--queue", required=True, help="shared queue directory")
+    ap.add_argument("--ttl", type=float, default=300.0,
+                    help="lease lifetime without heartbeat [s]")
+    ap.add_argument("--max-attempts", type=int, default=3)
+    ap.add_argument("--poll", type=float, default=10.0,
+                    help="idle wait between claim attempts [s]")
+    ap.add_argument("--keep-alive", action="store_true",
+                    help="worker keeps polling after the queue drains")
+    # enqueue-grid
+    ap.add_argument("-n", "--nevents", type=int, default=25000)
+    ap.add_argument("--exe", default="./build/main")
+    ap.add_argument("--out", default="grid_sweep")
+    ap.add_argument("--pitch", type=float, default=150.0,
+                    help="lattice pitch [nm]")
+    return ap.parse_args()
+
+
+def main():
+    args = parse_cli()
+    if args.command == "selftest":
+        return selftest(args.queue, args.exe, args.pitch)
+    q = SweepQueue(args.queue, ttl=args.ttl, max_attempts=args.max_attempts)
+
+    if args.command == "enqueue-grid":
+        print(f"Enqueued {enqueue_grid(q, args.out, args.nevents, args.exe, args.pitch)}"
+              f" new point(s) in {q.root}")
+    elif args.command == "worker":
+        worker(q, poll=args.poll, exit_when_idle=not args.keep_alive)
+    elif args.command == "status":
+        q.reap()
+        print(json.dumps(q.counts(), indent=2))
+        for f in sorted((q.root / "failed").glob("*.json")):
+            print(f"failed: {f.stem}: {_read_json(f, {}).get('errors')}")
+    elif args.command == "collect":
+        df = collect(q)
+        out = q.root.parent / "summary.csv"
+        df.to_csv(out, index=False)
+        print("★ Wrote", out)
+
+
+if __name__ == "__main__":
+    sys.exit(main())
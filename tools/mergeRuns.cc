@@ -0,0 +1,64 @@
+// ============================================================================
+//  Project : muAlphaSim – Muon-Alpha State Propagation and Stripping
+//  File    : mergeRuns.cc
+//  Purpose : Combine the run.json files of several event shards
+//            (main --shard=i/N) into one exact summary.
+//
+//  Usage   : mergeRuns [-o merged.json] shard0/run.json shard1/run.json ...
+//            (writes to stdout when -o is omitted)
+//
+//  Author  : Mohammadreza Zakeri (Zaki) — m.zakeri@eku.edu
+//  Updated : 2026-10-18
+// ============================================================================
+
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "RunMerge.hh"
+
+int main(int argc, char** argv)
+{
+  std::string outPath;
+  std::vector<std::string> inputs;
+
+  for (int i = 1; i < argc; ++i) {
+    std::string a(argv[i]);
+    if (a == "-o" && i + 1 < argc)
+      outPath = argv[++i];
+    else if (a.rfind("--out=", 0) == 0)
+      outPath = a.substr(6);
+    else
+      inputs.push_back(a);
+  }
+
+  if (inputs.empty()) {
+    std::cerr << "usage: mergeRuns [-o merged.json] run.json [run.json ...]\n";
+    return 2;
+  }
+
+  try {
+    std::vector<util::RunJson> runs;
+    for (const auto& p : inputs) runs.push_back(util::LoadRunSummary(p));
+
+    const util::RunJson merged = util::MergeRunSummaries(runs);
+
+    if (outPath.empty()) {
+      std::cout << merged.dump(2) << '\n';
+    } else {
+      std::ofstream out(outPath);
+      if (!out) {
+        std::cerr << "mergeRuns: cannot write " << outPath << '\n';
+        return 1;
+      }
+      out << merged.dump(2) << '\n';
+      std::cerr << "mergeRuns: merged " << runs.size() << " shard(s), "
+                << merged.at("n_events") << " events -> " << outPath << '\n';
+    }
+  } catch (const std::exception& e) {
+    std::cerr << "mergeRuns: " << e.what() << '\n';
+    return 1;
+  }
+  return 0;
+}
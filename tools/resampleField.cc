@@ -0,0 +1,62 @@
+// ============================================================================
+//  Project : muAlphaSim – Muon-Alpha State Propagation and Stripping
+//  File    : resampleField.cc
+//  Purpose : Resample the geometry's Gmsh field map onto the regular
+//            (r, z) grids of its `field.resample` block, report the
+//            interpolation error against the mesh and write the .fgrid
+//            cache that main then maps instead of resampling on load.
+//
+//  Usage   : resampleField [--rebuild] geometry.json
+//            (paths in the JSON are relative to the working directory,
+//             as for main)
+//
+//  Author  : Mohammadreza Zakeri (Zaki) — m.zakeri@eku.edu
+//  Updated : 2026-10-18
+// ============================================================================
+
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "GeometryConfig.hh"
+#include "ResampledField.hh"
+
+int main(int argc, char** argv)
+{
+  std::string cfgPath;
+  bool rebuild = false;
+
+  for (int i = 1; i < argc; ++i) {
+    std::string a(argv[i]);
+    if (a == "--rebuild")
+      rebuild = true;
+    else
+      cfgPath = a;
+  }
+
+  if (cfgPath.empty()) {
+    std::cerr << "usage: resampleField [--rebuild] geometry.json\n";
+    return 2;
+  }
+
+  try {
+    std::ifstream in(cfgPath);
+    if (!in) {
+      std::cerr << "resampleField: cannot read " << cfgPath << '\n';
+      return 1;
+    }
+    geom::GeometryConfig cfg;
+    in >> cfg;
+
+    if (cfg.field.pos_file.empty() || !cfg.field.resample.Active()) {
+      std::cerr << "resampleField: " << cfgPath
+                << " has no field.pos_file or no field.resample.cell_nm\n";
+      return 1;
+    }
+    ResampledField::LoadOrBuild(cfg.field, std::cout, rebuild);
+  } catch (const std::exception& e) {
+    std::cerr << "resampleField: " << e.what() << '\n';
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,116 @@
+// ============================================================================
+//  Project : muAlphaSim – Muon-Alpha State Propagation and Stripping
+//  File    : solveField.cc
+//  Purpose : Solve the single-cone electrostatic field of the geometry's
+//            `field.solve` block and write the .fgrid cache that main then
+//            maps instead of solving on load.  With --sweep, solve once
+//            per value of one cone dimension in the same process and
+//            print the field just above the tip.
+//
+//  Usage   : solveField [--rebuild] [--threads N]
+//                       [--sweep r_tip_nm|r_base_nm|h_cone_nm|gap_nm v1,v2,…]
+//                       geometry.json
+//
+//  Author  : Mohammadreza Zakeri (Zaki) — m.zakeri@eku.edu
+//  Updated : 2026-10-18
+// ============================================================================
+
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "AxisymmetricSolver.hh"
+#include "GeometryConfig.hh"
+
+namespace {
+
+/** @return the cone dimension named `name`, or nullptr. */
+double* Dimension(geom::GeometryConfig& cfg, const std::string& name)
+{
+  if (name == "r_tip_nm")  return &cfg.cone.r_tip_nm;
+  if (name == "r_base_nm") return &cfg.cone.r_base_nm;
+  if (name == "h_cone_nm") return &cfg.cone.h_cone_nm;
+  if (name == "gap_nm")    return &cfg.gap_nm;
+  return nullptr;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+  std::string cfgPath, sweepName, sweepList;
+  bool rebuild = false;
+  unsigned threads = 0;
+
+  for (int i = 1; i < argc; ++i) {
+    std::string a(argv[i]);
+    if (a == "--rebuild")
+      rebuild = true;
+    else if (a == "--threads" && i + 1 < argc)
+      threads = static_cast<unsigned>(std::stoul(argv[++i]));
+    else if (a == "--sweep" && i + 2 < argc) {
+      sweepName = argv[++i];
+      sweepList = argv[++i];
+    }
+    else
+      cfgPath = a;
+  }
+
+  if (cfgPath.empty()) {
+    std::cerr << "usage: solveField [--rebuild] [--threads N] "
+                 "[--sweep r_tip_nm|r_base_nm|h_cone_nm|gap_nm v1,v2,...] geometry.json\n";
+    return 2;
+  }
+
+  try {
+    std::ifstream in(cfgPath);
+    if (!in) {
+      std::cerr << "solveField: cannot read " << cfgPath << '\n';
+      return 1;
+    }
+    geom::GeometryConfig cfg;
+    in >> cfg;
+
+    if (!cfg.field.solve.Active()) {
+      std::cerr << "solveField: " << cfgPath << " has no field.solve.cell_nm\n";
+      return 1;
+    }
+
+    if (sweepName.empty()) {
+      AxisymmetricSolver::LoadOrSolve(cfg, std::cout, rebuild, threads);
+      return 0;
+    }
+
+    double* dim = Dimension(cfg, sweepName);
+    if (!dim) {
+      std::cerr << "solveField: cannot sweep " << sweepName << '\n';
+      return 2;
+    }
+    std::vector<double> values;
+    std::stringstream list(sweepList);
+    for (std::string v; std::getline(list, v, ',');)
+      values.push_back(std::stod(v));
+
+    // |E| half a cell above the tip, in the map's field units
+    std::vector<double> tipField;
+    for (double v : values) {
+      *dim = v;
+      auto map = AxisymmetricSolver::LoadOrSolve(cfg, std::cout, rebuild, threads);
+      const double k = 1e-9 / cfg.field.pos_unit_m;
+      double Er, Ez;
+      map->FieldRZ(0.0, (cfg.cone.h_cone_nm + 0.5 * cfg.field.solve.cell_nm) * k, Er, Ez);
+      tipField.push_back(std::hypot(Er, Ez));
+    }
+
+    std::cout << "\n# " << sweepName << "  |E| above the tip\n";
+    for (std::size_t i = 0; i < values.size(); ++i)
+      std::cout << values[i] << '\t' << tipField[i] << '\n';
+  } catch (const std::exception& e) {
+    std::cerr << "solveField: " << e.what() << '\n';
+    return 1;
+  }
+  return 0;
+}